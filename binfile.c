@@ -0,0 +1,112 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: binfile.c
+    Description: Shared encoding, checksum and atomic save for binary files
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "binfile.h"
+#include <string.h>
+#include <unistd.h>
+
+unsigned char *PutU32(unsigned char *p, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) p[i] = (unsigned char)(v >> (8 * i));
+    return p + 4;
+}
+
+unsigned char *PutU64(unsigned char *p, uint64_t v)
+{
+    for (int i = 0; i < 8; ++i) p[i] = (unsigned char)(v >> (8 * i));
+    return p + 8;
+}
+
+unsigned char *PutF32(unsigned char *p, float v)
+{
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return PutU32(p, bits);
+}
+
+const unsigned char *GetU32(const unsigned char *p, uint32_t *v)
+{
+    *v = 0;
+    for (int i = 0; i < 4; ++i) *v |= (uint32_t)p[i] << (8 * i);
+    return p + 4;
+}
+
+const unsigned char *GetU64(const unsigned char *p, uint64_t *v)
+{
+    *v = 0;
+    for (int i = 0; i < 8; ++i) *v |= (uint64_t)p[i] << (8 * i);
+    return p + 8;
+}
+
+const unsigned char *GetF32(const unsigned char *p, float *v)
+{
+    uint32_t bits;
+    p = GetU32(p, &bits);
+    memcpy(v, &bits, sizeof(*v));
+    return p;
+}
+
+const unsigned char *GetI32(const unsigned char *p, int *v)
+{
+    uint32_t bits;
+    p = GetU32(p, &bits);
+    *v = (int)(int32_t)bits;
+    return p;
+}
+
+uint32_t Fnv1a(uint32_t hash, const unsigned char *data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool WriteFileAtomic(const char *path, FileWriter writer, void *context)
+{
+    if (path == NULL || writer == NULL) return false;
+    char tempPath[BINFILE_MAX_PATH + 8];
+    int length = snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+    if (length < 0 || (size_t)length >= sizeof(tempPath)) return false;
+
+    FILE *fp = fopen(tempPath, "wb");
+    if (fp == NULL) return false;
+    bool ok = writer(fp, context);
+    ok = (fflush(fp) == 0) && ok;
+    ok = (fsync(fileno(fp)) == 0) && ok;
+    ok = (fclose(fp) == 0) && ok;
+    if (ok) {
+        ok = rename(tempPath, path) == 0;
+    }
+    if (!ok) {
+        (void)remove(tempPath);
+    }
+    return ok;
+}
+
+typedef struct {
+    const void *data;
+    size_t size;
+} BufferContents;
+
+static bool WriteBuffer(FILE *fp, void *context)
+{
+    const BufferContents *contents = (const BufferContents *)context;
+    return contents->size == 0 || fwrite(contents->data, 1, contents->size, fp) == contents->size;
+}
+
+bool WriteBufferAtomic(const char *path, const void *data, size_t size)
+{
+    if (data == NULL && size > 0) return false;
+    BufferContents contents = { data, size };
+    return WriteFileAtomic(path, WriteBuffer, &contents);
+}
@@ -0,0 +1,46 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: binfile.h
+    Description: Shared encoding, checksum and atomic save for binary files
+========================================================================= */
+
+#ifndef BINFILE_H
+#define BINFILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define BINFILE_MAX_PATH 1024  // Longest path WriteFileAtomic saves to
+#define FNV1A_SEED 2166136261u
+
+// Fixed little-endian encoding keeps files free of struct padding and byte
+// order. Each returns the byte after the value it wrote or read.
+unsigned char *PutU32(unsigned char *p, uint32_t v);
+unsigned char *PutU64(unsigned char *p, uint64_t v);
+unsigned char *PutF32(unsigned char *p, float v);
+const unsigned char *GetU32(const unsigned char *p, uint32_t *v);
+const unsigned char *GetU64(const unsigned char *p, uint64_t *v);
+const unsigned char *GetF32(const unsigned char *p, float *v);
+const unsigned char *GetI32(const unsigned char *p, int *v);
+
+// 32-bit FNV-1a of data continuing from hash (FNV1A_SEED for a fresh one),
+// enough to catch truncation and bit rot
+uint32_t Fnv1a(uint32_t hash, const unsigned char *data, size_t size);
+
+// Fills fp with the file's contents; false if a write failed
+typedef bool (*FileWriter)(FILE *fp, void *context);
+
+// Write-then-rename: writer fills path.tmp, which is flushed, synced and
+// renamed over path, so a crash leaves either the old file or the new one.
+// On failure the temporary file is removed and path is untouched.
+bool WriteFileAtomic(const char *path, FileWriter writer, void *context);
+
+// WriteFileAtomic for contents already encoded in memory
+bool WriteBufferAtomic(const char *path, const void *data, size_t size);
+
+#endif // BINFILE_H
@@ -0,0 +1,304 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: boardwriter.c
+    Description: Background leaderboard persistence fed by a lock-free queue
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "boardwriter.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define QUEUE_MASK (BOARD_WRITER_QUEUE_SIZE - 1u)
+
+static double NowSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Sleep until an entry is queued, or until the sync deadline if one is due
+static void WaitForWork(BoardWriter *writer, double syncDue)
+{
+    if (syncDue > 0.0) {
+        double wait = syncDue - NowSeconds();
+        if (wait <= 0.0) return;
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        long long ns = (long long)deadline.tv_nsec + (long long)(wait * 1e9);
+        deadline.tv_sec += (time_t)(ns / 1000000000LL);
+        deadline.tv_nsec = (long)(ns % 1000000000LL);
+        while (sem_timedwait(&writer->wake, &deadline) != 0 && errno == EINTR) {
+        }
+    } else {
+        while (sem_wait(&writer->wake) != 0 && errno == EINTR) {
+        }
+    }
+    // Fold the posts of a burst into this wake-up; anything queued after the
+    // drain below posts again
+    while (sem_trywait(&writer->wake) == 0) {
+    }
+}
+
+static bool WritePending(BoardWriter *writer, const BoardResult *pending, size_t count)
+{
+    LeaderboardEntry entries[BOARD_WRITER_QUEUE_SIZE];
+    for (size_t i = 0; i < count; ++i) entries[i] = pending[i].entry;
+    if (writer->journal.fd >= 0) return AppendLeaderboardJournal(&writer->journal, entries, count);
+    // No journal (it could not be opened): rewrite the snapshot instead
+    return writer->path[0] != '\0' && AppendLeaderboardFile(writer->path, entries, count);
+}
+
+static void SyncJournal(BoardWriter *writer)
+{
+    if (SyncLeaderboardJournal(&writer->journal)) writer->syncs++;
+}
+
+// Append the match records of written results; on failure they stay
+// pending and retry with the next batch
+static bool AppendHistory(BoardWriter *writer, MatchRecord *matches, size_t *count)
+{
+    if (*count == 0) return false;
+    if (writer->history.blocksFd < 0) {
+        // Could not be opened before: try again
+        CloseMatchHistoryLog(&writer->history);
+        OpenMatchHistoryLog(&writer->history, writer->historyPath);
+    }
+    if (!AppendMatchHistoryLog(&writer->history, writer->historyPath, matches, *count)) {
+        writer->failures++;
+        return false;
+    }
+    writer->historySaved += *count;
+    *count = 0;
+    return true;
+}
+
+static void SyncHistory(BoardWriter *writer)
+{
+    if (SyncMatchHistoryLog(&writer->history)) writer->syncs++;
+}
+
+static bool SavePlayers(BoardWriter *writer)
+{
+    if (SavePlayerStats(&writer->players, writer->playersPath)) {
+        writer->playerSaves++;
+        return true;
+    }
+    writer->failures++;
+    return false;
+}
+
+static void *BoardWriterThread(void *arg)
+{
+    BoardWriter *writer = (BoardWriter *)arg;
+    const BoardWriterConfig *config = &writer->config;
+    if (writer->path[0] == '\0' &&
+        !GetLeaderboardSavePath(LEADERBOARD_BINARY_NAME, writer->path, sizeof(writer->path))) {
+        writer->path[0] = '\0';
+    }
+    if (writer->journalPath[0] == '\0' &&
+        !GetLeaderboardSavePath(LEADERBOARD_JOURNAL_NAME, writer->journalPath,
+                                sizeof(writer->journalPath))) {
+        writer->journalPath[0] = '\0';
+    }
+    if (writer->playersPath[0] == '\0' &&
+        !GetLeaderboardSavePath(PLAYER_STATS_NAME, writer->playersPath,
+                                sizeof(writer->playersPath))) {
+        writer->playersPath[0] = '\0';
+    }
+    if (writer->historyPath[0] == '\0' &&
+        !GetLeaderboardSavePath(MATCH_HISTORY_NAME, writer->historyPath,
+                                sizeof(writer->historyPath))) {
+        writer->historyPath[0] = '\0';
+    }
+    // Mirror of the game's stats, kept current by replaying the same results
+    if (writer->playersPath[0] != '\0') LoadPlayerStats(&writer->players, writer->playersPath);
+    writer->journal.fd = -1;
+    if (writer->path[0] != '\0' && writer->journalPath[0] != '\0') {
+        OpenLeaderboardJournal(&writer->journal, writer->journalPath, writer->path);
+    }
+    writer->history.blocksFd = -1;
+    writer->history.tailFd = -1;
+    if (writer->historyPath[0] != '\0') {
+        LockSharedBoard(writer->shared);
+        OpenMatchHistoryLog(&writer->history, writer->historyPath);
+        UnlockSharedBoard(writer->shared);
+    }
+
+    // Results taken off the queue but not yet on disk
+    BoardResult pending[BOARD_WRITER_QUEUE_SIZE];
+    size_t pendingCount = 0;
+    // Match records of written results not yet in the history
+    MatchRecord matches[BOARD_WRITER_QUEUE_SIZE];
+    size_t matchCount = 0;
+    bool dirty = false;  // Appended since the last sync
+    bool historyDirty = false;
+    bool playersDirty = false;  // Stats changed since the last good save
+    double lastSync = NowSeconds();
+    bool stopping = false;
+    while (!stopping) {
+        double syncDue = ((dirty || historyDirty) && config->sync == BOARD_SYNC_INTERVAL)
+                             ? lastSync + config->syncSeconds : 0.0;
+        WaitForWork(writer, syncDue);
+        stopping = __atomic_load_n(&writer->stopping, __ATOMIC_ACQUIRE) != 0;
+
+        // Other instances write the same files: from picking up their
+        // changes to publishing ours, hold the lock
+        SharedBoard *shared = writer->shared;
+        LockSharedBoard(shared);
+        if (shared && writer->path[0] != '\0' && writer->journalPath[0] != '\0') {
+            RefreshLeaderboardJournal(&writer->journal, writer->journalPath, writer->path);
+        }
+        if (shared && !playersDirty && writer->playersPath[0] != '\0') {
+            LoadPlayerStats(&writer->players, writer->playersPath);
+        }
+        if (shared && writer->historyPath[0] != '\0') {
+            RefreshMatchHistoryLog(&writer->history, writer->historyPath);
+        }
+
+        // The game thread stops queueing before it asks us to stop; on the
+        // way out keep draining until the queue is empty or a write fails
+        bool more;
+        do {
+            size_t tail = writer->tail;
+            size_t head = __atomic_load_n(&writer->head, __ATOMIC_ACQUIRE);
+            while (tail != head && pendingCount < BOARD_WRITER_QUEUE_SIZE) {
+                pending[pendingCount++] = writer->queue[tail & QUEUE_MASK];
+                tail++;
+            }
+            __atomic_store_n(&writer->tail, tail, __ATOMIC_RELEASE);
+
+            if (pendingCount > 0) {
+                if (WritePending(writer, pending, pendingCount)) {
+                    PublishSharedResults(shared, pending, pendingCount);
+                    for (size_t i = 0; i < pendingCount; ++i) {
+                        RecordMatchResult(&writer->players, pending[i].entry.initials,
+                                          pending[i].loser, pending[i].entry.seconds);
+                        // While the history cannot be written its backlog is
+                        // bounded; past that, records are dropped
+                        if (pending[i].hasMatch && writer->historyPath[0] != '\0') {
+                            if (matchCount < BOARD_WRITER_QUEUE_SIZE) {
+                                matches[matchCount++] = pending[i].match;
+                            } else {
+                                writer->failures++;
+                            }
+                        }
+                    }
+                    playersDirty = writer->playersPath[0] != '\0';
+                    writer->saves++;
+                    writer->saved += pendingCount;
+                    pendingCount = 0;
+                    dirty = writer->journal.fd >= 0;
+                } else {
+                    writer->failures++;
+                }
+            }
+            more = stopping && pendingCount == 0 && tail != head;
+        } while (more);
+
+        // The whole table is small; rewrite it once per batch, and retry a
+        // failed save with the next one
+        if (playersDirty) playersDirty = !SavePlayers(writer);
+        if (AppendHistory(writer, matches, &matchCount)) historyDirty = true;
+
+        if ((dirty || historyDirty) &&
+            (stopping || config->sync == BOARD_SYNC_EVERY_WRITE ||
+             (config->sync == BOARD_SYNC_INTERVAL &&
+              NowSeconds() - lastSync >= config->syncSeconds))) {
+            if (dirty) SyncJournal(writer);
+            if (historyDirty) SyncHistory(writer);
+            dirty = false;
+            historyDirty = false;
+            lastSync = NowSeconds();
+        }
+
+        // Compaction rewrites the snapshot (fsynced) and restarts the journal
+        if (config->compactRecords > 0 && writer->journal.fd >= 0 &&
+            writer->journal.records >= config->compactRecords) {
+            if (dirty) SyncJournal(writer);
+            if (CompactLeaderboardJournal(&writer->journal, writer->journalPath, writer->path)) {
+                writer->compactions++;
+                dirty = false;
+            } else if (writer->journal.fd < 0) {
+                // Lost the journal mid-compaction: pick it up again
+                OpenLeaderboardJournal(&writer->journal, writer->journalPath, writer->path);
+            }
+        }
+        UnlockSharedBoard(shared);
+    }
+    if (playersDirty) {
+        LockSharedBoard(writer->shared);
+        SavePlayers(writer);
+        UnlockSharedBoard(writer->shared);
+    }
+    CloseMatchHistoryLog(&writer->history);
+    CloseLeaderboardJournal(&writer->journal);
+    FreePlayerStatsStore(&writer->players);
+    return NULL;
+}
+
+BoardWriterConfig DefaultBoardWriterConfig(void)
+{
+    BoardWriterConfig config = { BOARD_SYNC_EVERY_WRITE, BOARD_WRITER_SYNC_SECONDS,
+                                 BOARD_WRITER_COMPACT_RECORDS };
+    return config;
+}
+
+bool StartBoardWriter(BoardWriter *writer, const char *path, const char *journalPath,
+                      const char *playersPath, const char *historyPath, SharedBoard *shared,
+                      const BoardWriterConfig *config)
+{
+    if (!writer) return false;
+    memset(writer, 0, sizeof(*writer));
+    writer->config = config ? *config : DefaultBoardWriterConfig();
+    writer->shared = (shared && shared->fd >= 0) ? shared : NULL;
+    writer->journal.fd = -1;
+    if (path) snprintf(writer->path, sizeof(writer->path), "%s", path);
+    if (journalPath) snprintf(writer->journalPath, sizeof(writer->journalPath), "%s", journalPath);
+    if (playersPath) snprintf(writer->playersPath, sizeof(writer->playersPath), "%s", playersPath);
+    if (historyPath) snprintf(writer->historyPath, sizeof(writer->historyPath), "%s", historyPath);
+    if (sem_init(&writer->wake, 0, 0) != 0) return false;
+    if (pthread_create(&writer->thread, NULL, BoardWriterThread, writer) != 0) {
+        sem_destroy(&writer->wake);
+        return false;
+    }
+    writer->threaded = true;
+    return true;
+}
+
+bool QueueBoardEntry(BoardWriter *writer, const LeaderboardEntry *entry, const char *loser,
+                     const MatchRecord *match)
+{
+    if (!writer || !entry || !writer->threaded) return false;
+    size_t head = writer->head;
+    size_t tail = __atomic_load_n(&writer->tail, __ATOMIC_ACQUIRE);
+    if (head - tail >= BOARD_WRITER_QUEUE_SIZE) {
+        writer->dropped++;
+        return false;
+    }
+    BoardResult *result = &writer->queue[head & QUEUE_MASK];
+    result->entry = *entry;
+    snprintf(result->loser, sizeof(result->loser), "%s", loser ? loser : "");
+    result->hasMatch = match != NULL;
+    if (match) result->match = *match;
+    __atomic_store_n(&writer->head, head + 1, __ATOMIC_RELEASE);
+    sem_post(&writer->wake);
+    return true;
+}
+
+void StopBoardWriter(BoardWriter *writer)
+{
+    if (!writer || !writer->threaded) return;
+    __atomic_store_n(&writer->stopping, 1, __ATOMIC_RELEASE);
+    sem_post(&writer->wake);
+    pthread_join(writer->thread, NULL);
+    sem_destroy(&writer->wake);
+    writer->threaded = false;
+}
@@ -0,0 +1,101 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: boardwriter.h
+    Description: Background leaderboard persistence fed by a lock-free queue
+========================================================================= */
+
+#ifndef BOARDWRITER_H
+#define BOARDWRITER_H
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "leaderboard.h"
+#include "matchhistory.h"
+#include "playerstats.h"
+#include "sharedboard.h"
+
+#define BOARD_WRITER_QUEUE_SIZE 256  // Power of two
+#define BOARD_WRITER_MAX_PATH 512
+#define BOARD_WRITER_CACHE_LINE 64
+#define BOARD_WRITER_COMPACT_RECORDS 4096  // Journal length that triggers compaction
+#define BOARD_WRITER_SYNC_SECONDS 1.0
+
+// When journal appends are made durable
+typedef enum {
+    BOARD_SYNC_EVERY_WRITE,  // fdatasync after every append (default)
+    BOARD_SYNC_INTERVAL,     // At most once per syncSeconds; a crash loses at most that window
+    BOARD_SYNC_NEVER         // Left to the OS; synced at compaction and on stop
+} BoardSyncPolicy;
+
+typedef struct {
+    BoardSyncPolicy sync;
+    double syncSeconds;     // For BOARD_SYNC_INTERVAL
+    size_t compactRecords;  // Fold the journal into the snapshot at this length; 0 = never
+} BoardWriterConfig;
+
+// Single-producer/single-consumer ring of new results. The game thread only
+// copies an entry and bumps an index; the writer thread drains everything
+// pending and appends it to the journal in one write, so bursts of results
+// coalesce into a single append. Past a threshold the journal is compacted
+// into the snapshot, on the same thread. The writer applies the same
+// results to its own copy of the player stats and rewrites their file, and
+// appends their match records to the history. With a shared board, each
+// batch is written under its lock and then published to the other instances.
+typedef struct {
+    BoardResult queue[BOARD_WRITER_QUEUE_SIZE];
+    size_t head;  // Next slot to fill; written by the producer only
+    unsigned char headPad[BOARD_WRITER_CACHE_LINE];
+    size_t tail;  // Next slot to drain; written by the writer only
+    unsigned char tailPad[BOARD_WRITER_CACHE_LINE];
+
+    pthread_t thread;
+    sem_t wake;    // Posted per queued entry and on stop; never blocks the poster
+    int stopping;  // Accessed atomically
+    bool threaded;
+    BoardWriterConfig config;
+    char path[BOARD_WRITER_MAX_PATH];         // Snapshot; empty: ~/.purple/leaderboard.bin
+    char journalPath[BOARD_WRITER_MAX_PATH];  // Empty: ~/.purple/leaderboard.journal
+    char playersPath[BOARD_WRITER_MAX_PATH];  // Empty: ~/.purple/players.bin
+    char historyPath[BOARD_WRITER_MAX_PATH];  // Empty: ~/.purple/history.bin
+    LeaderboardJournal journal;               // Writer thread only
+    PlayerStatsStore players;                 // Writer thread only
+    MatchHistoryLog history;                  // Writer thread only
+    SharedBoard *shared;                      // NULL when this instance is alone
+
+    // Statistics; read the writer's after StopBoardWriter
+    uint64_t saves;         // Journal appends (or snapshot rewrites without a journal) (writer)
+    uint64_t saved;         // Entries written (writer)
+    uint64_t syncs;         // fdatasync calls (writer)
+    uint64_t compactions;   // Journal folds into the snapshot (writer)
+    uint64_t playerSaves;   // Player stats file rewrites (writer)
+    uint64_t historySaved;  // Match records appended to the history (writer)
+    uint64_t failures;      // Failed writes; their entries retry with the next batch (writer)
+    uint64_t dropped;       // Entries refused because the queue was full (producer)
+} BoardWriter;
+
+// Default policy: sync every append, compact at BOARD_WRITER_COMPACT_RECORDS
+BoardWriterConfig DefaultBoardWriterConfig(void);
+
+// Start the writer thread. NULL paths mean the default locations and NULL
+// config the default policy; shared may be NULL (or not open). The writer
+// only publishes to and locks shared; polling stays with its owner.
+// Returns false (and leaves saves to the caller) if the thread cannot start.
+bool StartBoardWriter(BoardWriter *writer, const char *path, const char *journalPath,
+                      const char *playersPath, const char *historyPath, SharedBoard *shared,
+                      const BoardWriterConfig *config);
+
+// Queue a result for saving; wait-free. loser and match may be NULL.
+// Returns false if the queue is full or the writer is not running.
+bool QueueBoardEntry(BoardWriter *writer, const LeaderboardEntry *entry, const char *loser,
+                     const MatchRecord *match);
+
+// Append and sync everything still queued, then join the thread
+void StopBoardWriter(BoardWriter *writer);
+
+#endif // BOARDWRITER_H
@@ -0,0 +1,297 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: checkpoint.c
+    Description: Binary checkpoints of simulation lanes with async writer
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "checkpoint.h"
+#include "binfile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CHECKPOINT_MAGIC "PRPLCKPT"
+#define CHECKPOINT_MAGIC_SIZE 8
+#define CHECKPOINT_VERSION 1u
+#define CHECKPOINT_HEADER_SIZE (CHECKPOINT_MAGIC_SIZE + 4 + 4 + 8 + 4 + 4 + 4)
+// rng + ball(5) + 2 paddles(5 + score) + speed/frames/rally + remaining + stats
+#define CHECKPOINT_LANE_SIZE (8 + 5 * 4 + 2 * 6 * 4 + 3 * 4 + 8 + 6 * 8 + 4)
+#define CHECKPOINT_CHECKSUM_SIZE 4
+
+static unsigned char *PutPaddle(unsigned char *p, const Paddle *paddle)
+{
+    p = PutF32(p, paddle->position.x);
+    p = PutF32(p, paddle->position.y);
+    p = PutF32(p, paddle->width);
+    p = PutF32(p, paddle->height);
+    p = PutF32(p, paddle->velocity);
+    return PutU32(p, (uint32_t)paddle->score);
+}
+
+static const unsigned char *GetPaddle(const unsigned char *p, Paddle *paddle)
+{
+    p = GetF32(p, &paddle->position.x);
+    p = GetF32(p, &paddle->position.y);
+    p = GetF32(p, &paddle->width);
+    p = GetF32(p, &paddle->height);
+    p = GetF32(p, &paddle->velocity);
+    return GetI32(p, &paddle->score);
+}
+
+static unsigned char *PutLane(unsigned char *p, const SimLane *lane)
+{
+    p = PutU64(p, lane->rng.state);
+    p = PutF32(p, lane->ball.position.x);
+    p = PutF32(p, lane->ball.position.y);
+    p = PutF32(p, lane->ball.velocity.x);
+    p = PutF32(p, lane->ball.velocity.y);
+    p = PutF32(p, lane->ball.radius);
+    p = PutPaddle(p, &lane->left);
+    p = PutPaddle(p, &lane->right);
+    p = PutF32(p, lane->speedMultiplier);
+    p = PutU32(p, lane->matchFrames);
+    p = PutU32(p, lane->rally);
+    p = PutU64(p, lane->matchesRemaining);
+    p = PutU64(p, lane->stats.matches);
+    p = PutU64(p, lane->stats.leftWins);
+    p = PutU64(p, lane->stats.rightWins);
+    p = PutU64(p, lane->stats.abandoned);
+    p = PutU64(p, lane->stats.frames);
+    p = PutU64(p, lane->stats.rallies);
+    return PutU32(p, lane->stats.longestRally);
+}
+
+static const unsigned char *GetLane(const unsigned char *p, SimLane *lane)
+{
+    p = GetU64(p, &lane->rng.state);
+    p = GetF32(p, &lane->ball.position.x);
+    p = GetF32(p, &lane->ball.position.y);
+    p = GetF32(p, &lane->ball.velocity.x);
+    p = GetF32(p, &lane->ball.velocity.y);
+    p = GetF32(p, &lane->ball.radius);
+    p = GetPaddle(p, &lane->left);
+    p = GetPaddle(p, &lane->right);
+    p = GetF32(p, &lane->speedMultiplier);
+    p = GetU32(p, &lane->matchFrames);
+    p = GetU32(p, &lane->rally);
+    p = GetU64(p, &lane->matchesRemaining);
+    p = GetU64(p, &lane->stats.matches);
+    p = GetU64(p, &lane->stats.leftWins);
+    p = GetU64(p, &lane->stats.rightWins);
+    p = GetU64(p, &lane->stats.abandoned);
+    p = GetU64(p, &lane->stats.frames);
+    p = GetU64(p, &lane->stats.rallies);
+    return GetU32(p, &lane->stats.longestRally);
+}
+
+static size_t CheckpointSize(size_t laneCount)
+{
+    return CHECKPOINT_HEADER_SIZE + laneCount * CHECKPOINT_LANE_SIZE + CHECKPOINT_CHECKSUM_SIZE;
+}
+
+bool SaveSimCheckpoint(const char *path, const SimConfig *config, uint64_t seed,
+                       const SimLane *lanes, size_t laneCount)
+{
+    if (path == NULL || config == NULL || (lanes == NULL && laneCount > 0)) return false;
+    if (laneCount > UINT32_MAX) return false;
+
+    size_t size = CheckpointSize(laneCount);
+    unsigned char *buffer = malloc(size);
+    if (buffer == NULL) return false;
+
+    unsigned char *p = buffer;
+    memcpy(p, CHECKPOINT_MAGIC, CHECKPOINT_MAGIC_SIZE);
+    p += CHECKPOINT_MAGIC_SIZE;
+    p = PutU32(p, CHECKPOINT_VERSION);
+    p = PutU32(p, (uint32_t)laneCount);
+    p = PutU64(p, seed);
+    p = PutU32(p, (uint32_t)config->pointsToWin);
+    p = PutF32(p, config->speedIncrement);
+    p = PutU32(p, config->maxMatchFrames);
+    for (size_t i = 0; i < laneCount; ++i) {
+        p = PutLane(p, &lanes[i]);
+    }
+    PutU32(p, Fnv1a(FNV1A_SEED, buffer, size - CHECKPOINT_CHECKSUM_SIZE));
+
+    bool ok = WriteBufferAtomic(path, buffer, size);
+    free(buffer);
+    return ok;
+}
+
+bool LoadSimCheckpoint(const char *path, SimConfig *config, uint64_t *seed,
+                       SimLane *lanes, size_t laneCapacity, size_t *laneCount)
+{
+    if (path == NULL || config == NULL || seed == NULL || laneCount == NULL) return false;
+
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) return false;
+
+    unsigned char header[CHECKPOINT_HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), fp) != sizeof(header) ||
+        memcmp(header, CHECKPOINT_MAGIC, CHECKPOINT_MAGIC_SIZE) != 0) {
+        fclose(fp);
+        return false;
+    }
+
+    uint32_t version = 0;
+    uint32_t storedLanes = 0;
+    const unsigned char *p = GetU32(header + CHECKPOINT_MAGIC_SIZE, &version);
+    p = GetU32(p, &storedLanes);
+    if (version != CHECKPOINT_VERSION || storedLanes > laneCapacity ||
+        (lanes == NULL && storedLanes > 0)) {
+        fclose(fp);
+        return false;
+    }
+
+    size_t size = CheckpointSize(storedLanes);
+    unsigned char *buffer = malloc(size);
+    if (buffer == NULL) {
+        fclose(fp);
+        return false;
+    }
+    memcpy(buffer, header, sizeof(header));
+    size_t remaining = size - sizeof(header);
+    bool ok = fread(buffer + sizeof(header), 1, remaining, fp) == remaining &&
+              fgetc(fp) == EOF;
+    fclose(fp);
+
+    uint32_t stored = 0;
+    if (ok) {
+        GetU32(buffer + size - CHECKPOINT_CHECKSUM_SIZE, &stored);
+        ok = stored == Fnv1a(FNV1A_SEED, buffer, size - CHECKPOINT_CHECKSUM_SIZE);
+    }
+    if (ok) {
+        p = buffer + CHECKPOINT_MAGIC_SIZE + 8;
+        p = GetU64(p, seed);
+        p = GetI32(p, &config->pointsToWin);
+        p = GetF32(p, &config->speedIncrement);
+        p = GetU32(p, &config->maxMatchFrames);
+        for (size_t i = 0; i < storedLanes; ++i) {
+            p = GetLane(p, &lanes[i]);
+        }
+        *laneCount = storedLanes;
+    }
+    free(buffer);
+    return ok;
+}
+
+static void WriteLatestCheckpoint(CheckpointWriter *writer)
+{
+    // Called with lock held; the copy is the only work done under it
+    uint64_t version = writer->publishedVersion;
+    memcpy(writer->scratch, writer->published, writer->laneCount * sizeof(SimLane));
+    pthread_mutex_unlock(&writer->lock);
+
+    bool ok = SaveSimCheckpoint(writer->path, &writer->config, writer->seed,
+                                writer->scratch, writer->laneCount);
+
+    pthread_mutex_lock(&writer->lock);
+    writer->failed = !ok;
+    if (ok) {
+        writer->writtenVersion = version;
+        writer->checkpointsWritten++;
+    }
+}
+
+static void *CheckpointThread(void *arg)
+{
+    CheckpointWriter *writer = (CheckpointWriter *)arg;
+
+    pthread_mutex_lock(&writer->lock);
+    while (!writer->stopping) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        double whole = (double)(long)writer->intervalSeconds;
+        deadline.tv_sec += (time_t)whole;
+        deadline.tv_nsec += (long)((writer->intervalSeconds - whole) * 1e9);
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        while (!writer->stopping &&
+               pthread_cond_timedwait(&writer->wake, &writer->lock, &deadline) == 0) {
+            // Spurious or early wake-up: keep waiting for the interval
+        }
+        if (writer->publishedVersion != writer->writtenVersion) {
+            WriteLatestCheckpoint(writer);
+        }
+    }
+    if (writer->publishedVersion != writer->writtenVersion) {
+        WriteLatestCheckpoint(writer);
+    }
+    pthread_mutex_unlock(&writer->lock);
+    return NULL;
+}
+
+bool StartCheckpointWriter(CheckpointWriter *writer, const char *path,
+                           const SimConfig *config, uint64_t seed,
+                           const SimLane *lanes, size_t laneCount,
+                           double intervalSeconds)
+{
+    if (writer == NULL || path == NULL || config == NULL || lanes == NULL || laneCount == 0) {
+        return false;
+    }
+
+    memset(writer, 0, sizeof(*writer));
+    snprintf(writer->path, sizeof(writer->path), "%s", path);
+    writer->config = *config;
+    writer->seed = seed;
+    writer->laneCount = laneCount;
+    writer->intervalSeconds = (intervalSeconds > 0.0) ? intervalSeconds : 1.0;
+    writer->published = malloc(laneCount * sizeof(SimLane));
+    writer->scratch = malloc(laneCount * sizeof(SimLane));
+    if (writer->published == NULL || writer->scratch == NULL) {
+        free(writer->published);
+        free(writer->scratch);
+        return false;
+    }
+    memcpy(writer->published, lanes, laneCount * sizeof(SimLane));
+
+    pthread_mutex_init(&writer->lock, NULL);
+    pthread_cond_init(&writer->wake, NULL);
+    if (pthread_create(&writer->thread, NULL, CheckpointThread, writer) != 0) {
+        pthread_cond_destroy(&writer->wake);
+        pthread_mutex_destroy(&writer->lock);
+        free(writer->published);
+        free(writer->scratch);
+        return false;
+    }
+    return true;
+}
+
+void PublishCheckpointLanes(CheckpointWriter *writer, const SimLane *lanes,
+                            size_t first, size_t count)
+{
+    if (writer == NULL || lanes == NULL || first >= writer->laneCount) return;
+    if (count > writer->laneCount - first) count = writer->laneCount - first;
+
+    pthread_mutex_lock(&writer->lock);
+    memcpy(&writer->published[first], lanes, count * sizeof(SimLane));
+    writer->publishedVersion++;
+    pthread_mutex_unlock(&writer->lock);
+}
+
+void StopCheckpointWriter(CheckpointWriter *writer)
+{
+    if (writer == NULL || writer->published == NULL) return;
+
+    pthread_mutex_lock(&writer->lock);
+    writer->stopping = true;
+    pthread_cond_signal(&writer->wake);
+    pthread_mutex_unlock(&writer->lock);
+    pthread_join(writer->thread, NULL);
+
+    pthread_cond_destroy(&writer->wake);
+    pthread_mutex_destroy(&writer->lock);
+    free(writer->published);
+    free(writer->scratch);
+    writer->published = NULL;
+    writer->scratch = NULL;
+}
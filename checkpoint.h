@@ -0,0 +1,64 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: checkpoint.h
+    Description: Binary checkpoints of simulation lanes with async writer
+========================================================================= */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "simulation.h"
+
+#define CHECKPOINT_MAX_PATH 512
+
+// Write config, seed and every lane to path (temp file + rename, so a crash
+// mid-write leaves the previous checkpoint intact). Returns true on success.
+bool SaveSimCheckpoint(const char *path, const SimConfig *config, uint64_t seed,
+                       const SimLane *lanes, size_t laneCount);
+
+// Read a checkpoint back. Fails on bad magic, version, size or checksum, or
+// if the file holds more than laneCapacity lanes.
+bool LoadSimCheckpoint(const char *path, SimConfig *config, uint64_t *seed,
+                       SimLane *lanes, size_t laneCapacity, size_t *laneCount);
+
+// Background checkpoint writer. Simulation threads publish lane states
+// (a memcpy under a short lock); file I/O happens only on the writer thread.
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    char path[CHECKPOINT_MAX_PATH];
+    SimConfig config;
+    uint64_t seed;
+    SimLane *published;         // Latest lane states, guarded by lock
+    SimLane *scratch;           // Writer-private copy used during I/O
+    size_t laneCount;
+    uint64_t publishedVersion;  // Bumped on every publish
+    uint64_t writtenVersion;    // Version of the last checkpoint on disk
+    uint64_t checkpointsWritten;
+    double intervalSeconds;
+    bool stopping;
+    bool failed;                // Last write failed
+} CheckpointWriter;
+
+// Start the writer thread; lanes provide the initial published state
+bool StartCheckpointWriter(CheckpointWriter *writer, const char *path,
+                           const SimConfig *config, uint64_t seed,
+                           const SimLane *lanes, size_t laneCount,
+                           double intervalSeconds);
+
+// Publish lanes [first, first + count) for the next checkpoint
+void PublishCheckpointLanes(CheckpointWriter *writer, const SimLane *lanes,
+                            size_t first, size_t count);
+
+// Write a final checkpoint of the latest published state and join the thread
+void StopCheckpointWriter(CheckpointWriter *writer);
+
+#endif // CHECKPOINT_H
@@ -25,6 +25,7 @@ DEBUG_MODE=false
 TEST_MODE=false
 FUZZ_MODE=false
 FUZZ_LONG_MODE=false
+HEADLESS_MODE=false
 if [ $# -gt 0 ]; then
     if [ "$1" = "--debug" ] || [ "$1" = "debug" ]; then
         DEBUG_MODE=true
@@ -39,6 +40,9 @@ if [ $# -gt 0 ]; then
         FUZZ_MODE=true
         FUZZ_LONG_MODE=true
         echo "Building coverage-guided FUZZ TESTING binaries (extended 60-minute run)..."
+    elif [ "$1" = "--headless" ] || [ "$1" = "headless" ]; then
+        HEADLESS_MODE=true
+        echo "Building HEADLESS game loop with the null render backend..."
     elif [ "$1" = "--clean" ] || [ "$1" = "clean" ]; then
         echo "Cleaning binaries and object files..."
         if [ -d build ]; then
@@ -49,12 +53,13 @@ if [ $# -gt 0 ]; then
         exit 0
     else
         echo "Error: Invalid argument '$1'"
-        echo "Usage: $0 [--debug|debug|--test|test|--fuzz|fuzz|--fuzz-long|fuzz-long|--clean|clean]"
+        echo "Usage: $0 [--debug|debug|--test|test|--fuzz|fuzz|--fuzz-long|fuzz-long|--headless|headless|--clean|clean]"
         echo "  No arguments: Production build with optimizations"
         echo "  --debug or debug: Debug build with ASAN, UBSan, and Valgrind checks"
         echo "  --test or test: Build and run unit tests"
         echo "  --fuzz or fuzz: Build and run coverage-guided fuzz testing (60s per target, 5 min total)"
         echo "  --fuzz-long or fuzz-long: Extended fuzz testing (12 min per target, 60 min total)"
+        echo "  --headless or headless: Game loop on null and software raylib backends (no display needed)"
         echo "  --clean or clean: Remove all binaries and object files"
         exit 1
     fi
@@ -62,6 +67,14 @@ else
     echo "Building in PRODUCTION mode with optimizations..."
 fi
 
+# Production and headless builds embed resources/ into the executable so
+# startup needs no filesystem probing; EMBED_ASSETS=0 loads them from disk.
+# PURPLE_RESOURCES=<dir> overrides embedded assets at run time.
+EMBED_FLAGS=""
+if [ "${EMBED_ASSETS:-1}" = "1" ]; then
+    EMBED_FLAGS="-DPURPLE_EMBED_ASSETS"
+fi
+
 # Create directories if they don't exist
 mkdir -p build
 mkdir -p fuzz/corpus/
@@ -113,14 +126,14 @@ if [ "$DEBUG_MODE" = true ]; then
         echo "Started: $(date)"
         echo ""
         echo "--- Building main-asan ---"
-        gcc main.c ball.c paddle.c resource.c leaderboard.c -o build/main-asan \
+        gcc main.c ball.c paddle.c resource.c binfile.c leaderboard.c scoreindex.c scorewindow.c boardwriter.c playerstats.c sharedboard.c matchhistory.c textcache.c hud.c profiler.c input.c pacer.c fontcache.c startup.c -o build/main-asan \
             -Wall -Wextra -Wpedantic -Wunused -Wshadow -Wconversion \
             -Wsign-conversion -Wdouble-promotion -Wformat=2 \
             -fno-omit-frame-pointer -fanalyzer -std=c99 -fsanitize=address \
             -lraylib -lm -lpthread -ldl -lrt -lX11 2>&1
         echo ""
         echo "--- Building main-ubsan ---"
-        gcc main.c ball.c paddle.c resource.c leaderboard.c -o build/main-ubsan \
+        gcc main.c ball.c paddle.c resource.c binfile.c leaderboard.c scoreindex.c scorewindow.c boardwriter.c playerstats.c sharedboard.c matchhistory.c textcache.c hud.c profiler.c input.c pacer.c fontcache.c startup.c -o build/main-ubsan \
             -Wall -Wextra -Wpedantic -Wunused -Wshadow -Wconversion \
             -Wsign-conversion -Wdouble-promotion -Wformat=2 \
             -fno-omit-frame-pointer -fanalyzer -std=c99 \
@@ -128,7 +141,7 @@ if [ "$DEBUG_MODE" = true ]; then
             -lraylib -lm -lpthread -ldl -lrt -lX11 2>&1
         echo ""
         echo "--- Building main-valgrind ---"
-        gcc main.c ball.c paddle.c resource.c leaderboard.c -o build/main-valgrind \
+        gcc main.c ball.c paddle.c resource.c binfile.c leaderboard.c scoreindex.c scorewindow.c boardwriter.c playerstats.c sharedboard.c matchhistory.c textcache.c hud.c profiler.c input.c pacer.c fontcache.c startup.c -o build/main-valgrind \
             -Wall -Wextra -Wpedantic -Wunused -Wshadow -Wconversion \
             -Wsign-conversion -Wdouble-promotion -Wformat=2 \
             -fno-omit-frame-pointer -fanalyzer -std=c99 \
@@ -154,7 +167,7 @@ if [ "$DEBUG_MODE" = true ]; then
         echo "Started: $(date)"
         echo ""
         echo "--- Building main-clang ---"
-        clang main.c ball.c paddle.c resource.c leaderboard.c -o build/main-clang \
+        clang main.c ball.c paddle.c resource.c binfile.c leaderboard.c scoreindex.c scorewindow.c boardwriter.c playerstats.c sharedboard.c matchhistory.c textcache.c hud.c profiler.c input.c pacer.c fontcache.c startup.c -o build/main-clang \
             -Wall -Wextra -Wpedantic -Wunused -Wshadow -Wconversion \
             -Wsign-conversion -Wdouble-promotion -Wformat=2 -std=c99 \
             -lraylib -lm -lpthread -ldl -lrt -lX11 2>&1
@@ -173,19 +186,56 @@ if [ "$DEBUG_MODE" = true ]; then
 elif [ "$TEST_MODE" = true ]; then
     # Test build
     echo "Compiling tests..."
-    gcc ball.c paddle.c resource.c leaderboard.c \
-        /usr/local/include/unity/unity.c test/test.c \
+    gcc ball.c paddle.c resource.c binfile.c leaderboard.c scoreindex.c scorewindow.c boardwriter.c playerstats.c sharedboard.c matchhistory.c simulation.c checkpoint.c \
+        textcache.c hud.c profiler.c input.c pacer.c fontcache.c startup.c /usr/local/include/unity/unity.c test/test.c \
         -o build/test_runner -Wall -Wextra -Wpedantic -std=c99 -I. \
         -lraylib -lm -lpthread -ldl -lrt -lX11
+    # Golden-image tests for the software rasterizer, on the headless core instead of raylib
+    gcc platform/rlnull.c platform/rlnull_font.c platform/rlsoft_draw.c /usr/local/include/unity/unity.c test/test_soft.c \
+        -o build/test_soft -Wall -Wextra -Wpedantic -std=c99 -O3 -I. -lm
+    # Headless game loop for the smoke run, and the tool that counts the matches it recorded
+    gcc main.c ball.c paddle.c resource.c binfile.c leaderboard.c scoreindex.c scorewindow.c boardwriter.c playerstats.c sharedboard.c matchhistory.c textcache.c hud.c profiler.c input.c pacer.c fontcache.c startup.c \
+        platform/rlnull.c platform/rlnull_font.c platform/rlnull_draw.c -o build/main-headless \
+        -Wall -Wextra -Wpedantic -std=c99 -O2 -I. -DDEFAULT_TARGET_FPS=0 $EMBED_FLAGS -lm -lpthread
+    gcc binfile.c matchhistory.c tools/histtool.c -o build/histtool \
+        -Wall -Wextra -Wpedantic -std=c99 -O2 -I. -lm
+    # Software-rendered loop for the determinism check
+    gcc main.c ball.c paddle.c resource.c binfile.c leaderboard.c scoreindex.c scorewindow.c boardwriter.c playerstats.c sharedboard.c matchhistory.c textcache.c hud.c profiler.c input.c pacer.c fontcache.c startup.c \
+        platform/rlnull.c platform/rlnull_font.c platform/rlsoft_draw.c -o build/main-soft \
+        -Wall -Wextra -Wpedantic -std=c99 -O3 -I. -DDEFAULT_TARGET_FPS=0 $EMBED_FLAGS -lm -lpthread
+elif [ "$HEADLESS_MODE" = true ]; then
+    # Unmodified game loop linked against the null backend instead of raylib:
+    # no window, scripted input, virtual time, unpaced by default
+    gcc main.c ball.c paddle.c resource.c binfile.c leaderboard.c scoreindex.c scorewindow.c boardwriter.c playerstats.c sharedboard.c matchhistory.c textcache.c hud.c profiler.c input.c pacer.c fontcache.c startup.c \
+        platform/rlnull.c platform/rlnull_font.c platform/rlnull_draw.c -o build/main-headless \
+        -Wall -Wextra -Wpedantic -std=c99 -O2 -I. -DDEFAULT_TARGET_FPS=0 $EMBED_FLAGS -lm -lpthread
+    # Same loop rendered by the software rasterizer; -O3 vectorizes its span loops
+    gcc main.c ball.c paddle.c resource.c binfile.c leaderboard.c scoreindex.c scorewindow.c boardwriter.c playerstats.c sharedboard.c matchhistory.c textcache.c hud.c profiler.c input.c pacer.c fontcache.c startup.c \
+        platform/rlnull.c platform/rlnull_font.c platform/rlsoft_draw.c -o build/main-soft \
+        -Wall -Wextra -Wpedantic -std=c99 -O3 -I. -DDEFAULT_TARGET_FPS=0 $EMBED_FLAGS -lm -lpthread
+    echo "Run with: PURPLE_NULL_FRAMES=100000 ./build/main-headless"
+    echo "Capture:  PURPLE_SOFT_CAPTURE=build ./build/main-soft"
 elif [ "$FUZZ_MODE" = false ] && [ "$DEBUG_MODE" = false ] && [ "$TEST_MODE" = false ]; then
     # Production build with size optimizations
-    gcc main.c ball.c paddle.c resource.c leaderboard.c -o build/main \
-        -Wall -Wextra -Wpedantic -std=c99 -Os -s -flto \
+    gcc main.c ball.c paddle.c resource.c binfile.c leaderboard.c scoreindex.c scorewindow.c boardwriter.c playerstats.c sharedboard.c matchhistory.c textcache.c hud.c profiler.c input.c pacer.c fontcache.c startup.c -o build/main \
+        -Wall -Wextra -Wpedantic -std=c99 -Os -s -flto $EMBED_FLAGS \
         -ffunction-sections -fdata-sections -fomit-frame-pointer \
         -fno-asynchronous-unwind-tables -fno-unwind-tables \
         -Wl,--gc-sections -Wl,--as-needed -Wl,-O1 \
         -lraylib -lm -lpthread -ldl -lrt -lX11
     strip --strip-all build/main
+    # Headless batch simulator (no window, so no raylib link)
+    gcc ball.c paddle.c simulation.c binfile.c checkpoint.c tools/simulate.c -o build/simulate \
+        -Wall -Wextra -Wpedantic -std=c99 -O2 -s -I. -lpthread
+    # Leaderboard index benchmark (insert and top-K at growing sizes)
+    gcc binfile.c leaderboard.c scoreindex.c scorewindow.c tools/bench_leaderboard.c -o build/bench_leaderboard \
+        -Wall -Wextra -Wpedantic -std=c99 -O2 -s -I. -lm
+    # Leaderboard text import/export tool and text throughput benchmark
+    gcc binfile.c leaderboard.c scoreindex.c scorewindow.c tools/lbtool.c -o build/lbtool \
+        -Wall -Wextra -Wpedantic -std=c99 -O2 -s -I. -lm
+    # Match history size and percentile query benchmark
+    gcc binfile.c matchhistory.c tools/histtool.c -o build/histtool \
+        -Wall -Wextra -Wpedantic -std=c99 -O2 -s -I. -lm
     echo "Production build complete"
 fi
 
@@ -226,7 +276,7 @@ if [ "$DEBUG_MODE" = true ]; then
         echo "Clang-Tidy Version: $(clang-tidy --version 2>&1 | grep -i 'version' | head -1)"
         echo "Started: $(date)"
         echo ""
-        clang-tidy main.c ball.c paddle.c resource.c leaderboard.c -- \
+        clang-tidy main.c ball.c paddle.c resource.c binfile.c leaderboard.c scoreindex.c scorewindow.c boardwriter.c playerstats.c sharedboard.c matchhistory.c textcache.c hud.c profiler.c input.c pacer.c fontcache.c startup.c -- \
             -std=c99 -I. -I/usr/include 2>&1 || true
         echo ""
         echo "Completed: $(date)"
@@ -248,8 +298,7 @@ if [ "$DEBUG_MODE" = true ]; then
         echo "Clang Version: $(clang --version 2>&1 | grep -i 'version' | head -1)"
         echo "Started: $(date)"
         echo ""
-        scan-build -o build/scan-build-results gcc main.c ball.c paddle.c \
-            resource.c leaderboard.c -o /dev/null -std=c99 \
+        scan-build -o build/scan-build-results gcc main.c ball.c paddle.c resource.c binfile.c leaderboard.c scoreindex.c scorewindow.c boardwriter.c playerstats.c sharedboard.c matchhistory.c textcache.c hud.c profiler.c input.c pacer.c fontcache.c startup.c -o /dev/null -std=c99 \
             -lraylib -lm -lpthread -ldl -lrt -lX11 2>&1 || true
         echo ""
         echo "Completed: $(date)"
@@ -363,7 +412,7 @@ elif [ "$TEST_MODE" = true ]; then
     echo ""
     echo "Running unit tests..."
     echo "===================="
-    ./build/test_runner
+    ./build/test_runner && ./build/test_soft
     TEST_EXIT_CODE=$?
     echo "===================="
     if [ $TEST_EXIT_CODE -eq 0 ]; then
@@ -372,6 +421,43 @@ elif [ "$TEST_MODE" = true ]; then
         echo "Tests failed with exit code $TEST_EXIT_CODE"
         exit $TEST_EXIT_CODE
     fi
+    echo ""
+    echo "Running headless smoke test..."
+    # The autopilot starts a match, plays it out and enters initials; every result is
+    # recorded as the loop returns to the start screen, so two of them mean the game
+    # went PLAYING -> START_SCREEN -> PLAYING. A scratch HOME keeps real files untouched.
+    SMOKE_FRAMES=100000
+    SMOKE_HOME=$(mktemp -d)
+    SMOKE_OUTPUT=$(HOME="$SMOKE_HOME" PURPLE_NULL_FRAMES=$SMOKE_FRAMES ./build/main-headless 2>&1)
+    SMOKE_EXIT_CODE=$?
+    SMOKE_MATCHES=$(./build/histtool median "$SMOKE_HOME/.purple/history.bin" | awk 'NR == 1 { print $1 }')
+    rm -rf "$SMOKE_HOME"
+    echo "$SMOKE_OUTPUT"
+    if [ $SMOKE_EXIT_CODE -ne 0 ]; then
+        echo "Headless run failed with exit code $SMOKE_EXIT_CODE"
+        exit $SMOKE_EXIT_CODE
+    elif ! echo "$SMOKE_OUTPUT" | grep -q "^rlnull: $SMOKE_FRAMES iterations"; then
+        echo "Headless run stopped before its $SMOKE_FRAMES frames"
+        exit 1
+    elif [ "${SMOKE_MATCHES:-0}" -lt 2 ]; then
+        echo "Headless run recorded ${SMOKE_MATCHES:-0} matches, expected at least 2"
+        exit 1
+    fi
+    echo "Headless run finished cleanly after $SMOKE_MATCHES matches"
+    # Same seed, same frames: two software-rendered runs must end on the same image
+    DETERMINISM_FRAMES=2000
+    FIRST_HOME=$(mktemp -d)
+    SECOND_HOME=$(mktemp -d)
+    FIRST_HASH=$(HOME="$FIRST_HOME" PURPLE_NULL_FRAMES=$DETERMINISM_FRAMES ./build/main-soft 2>&1 \
+        | sed -n 's/^rlsoft: .* last frame hash //p')
+    SECOND_HASH=$(HOME="$SECOND_HOME" PURPLE_NULL_FRAMES=$DETERMINISM_FRAMES ./build/main-soft 2>&1 \
+        | sed -n 's/^rlsoft: .* last frame hash //p')
+    rm -rf "$FIRST_HOME" "$SECOND_HOME"
+    if [ -z "$FIRST_HASH" ] || [ "$FIRST_HASH" != "$SECOND_HASH" ]; then
+        echo "Headless runs diverged: frame hash '$FIRST_HASH' then '$SECOND_HASH'"
+        exit 1
+    fi
+    echo "Headless runs are deterministic: frame hash $FIRST_HASH twice"
     TOTAL_END_TIME=$(date +%s%3N)
     TOTAL_ELAPSED_MS=$((TOTAL_END_TIME - BUILD_START_TIME))
     TOTAL_ELAPSED=$(format_elapsed_time "$TOTAL_ELAPSED_MS")
@@ -409,11 +495,17 @@ elif [ "$FUZZ_MODE" = true ]; then
             -std=c99 -Wall -Wextra -g -O1 2>&1
         echo ""
         echo "--- Building fuzz_leaderboard target ---"
-        clang leaderboard.c fuzz/fuzz_leaderboard.c -o build/fuzz_leaderboard \
+        clang binfile.c leaderboard.c scoreindex.c scorewindow.c fuzz/fuzz_leaderboard.c -o build/fuzz_leaderboard \
             -fsanitize=fuzzer,address,undefined \
             -fsanitize-coverage=inline-8bit-counters,indirect-calls \
             -std=c99 -Wall -Wextra -g -O1 2>&1
         echo ""
+        echo "--- Building fuzz_leaderboard_text target ---"
+        clang binfile.c leaderboard.c scoreindex.c scorewindow.c fuzz/fuzz_leaderboard_text.c -o build/fuzz_leaderboard_text \
+            -fsanitize=fuzzer,address,undefined \
+            -fsanitize-coverage=inline-8bit-counters,indirect-calls \
+            -std=c99 -Wall -Wextra -g -O1 -lm 2>&1
+        echo ""
         echo "--- Building fuzz_ai_paddle target ---"
         clang paddle.c fuzz/fuzz_ai_paddle.c -o build/fuzz_ai_paddle \
             -fsanitize=fuzzer,address,undefined \
@@ -462,6 +554,14 @@ elif [ "$FUZZ_MODE" = true ]; then
             -timeout=2 \
             fuzz/corpus/ 2>&1 || true
         echo ""
+        echo "--- Running leaderboard text parser fuzzer ($FUZZ_DESC) ---"
+        timeout $FUZZ_TIMEOUT ./build/fuzz_leaderboard_text \
+            -max_len=256 \
+            -artifact_prefix=build/fuzz_artifacts/leaderboard_text_ \
+            -use_value_profile=1 \
+            -timeout=2 \
+            fuzz/corpus/ 2>&1 || true
+        echo ""
         echo "--- Running AI paddle fuzzer ($FUZZ_DESC) ---"
         timeout $FUZZ_TIMEOUT ./build/fuzz_ai_paddle \
             -max_len=32 \
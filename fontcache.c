@@ -0,0 +1,360 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: fontcache.c
+    Description: Baked font atlas cache (glyph metrics plus atlas pixels)
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "fontcache.h"
+#include "binfile.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FONT_CACHE_MAGIC "PRPLFONT"
+#define FONT_CACHE_MAGIC_SIZE 8
+#define FONT_CACHE_VERSION 2u
+#define FONT_CACHE_HEADER_SIZE (FONT_CACHE_MAGIC_SIZE + 4 + 8 + 4 * 6)
+#define FONT_CACHE_GLYPH_SIZE (4 * 4 + 4 * 4)  // value, offsets, advance, rec
+#define FONT_CACHE_CHECKSUM_SIZE 4
+#define FONT_CACHE_MAX_GLYPHS 4096
+#define FONT_CACHE_MAX_ATLAS 8192
+#define FONT_SDF_PACK_SKYLINE 1  // GenImageFontAtlas packMethod
+
+// Same smoothstep-on-derivatives approach as raylib's SDF font example
+static const char *sdfFragmentShader =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    float distance = texture(texture0, fragTexCoord).a - 0.5;\n"
+    "    float width = length(vec2(dFdx(distance), dFdy(distance)));\n"
+    "    float alpha = smoothstep(-width, width, distance);\n"
+    "    finalColor = vec4(fragColor.rgb, fragColor.a * alpha) * colDiffuse;\n"
+    "}\n";
+
+uint64_t HashFontData(const unsigned char *data, size_t size)
+{
+    uint64_t hash = 14695981039346656037u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211u;
+    }
+    return hash;
+}
+
+static size_t AtlasPixelBytes(int width, int height)
+{
+    return (size_t)width * (size_t)height * 2u;  // GRAY_ALPHA
+}
+
+static size_t CacheFileSize(int glyphCount, int width, int height)
+{
+    return FONT_CACHE_HEADER_SIZE + (size_t)glyphCount * FONT_CACHE_GLYPH_SIZE +
+           AtlasPixelBytes(width, height) + FONT_CACHE_CHECKSUM_SIZE;
+}
+
+// Cache files sit next to the leaderboard in ~/.purple. False if the path
+// does not fit; the caller then bakes without a cache.
+static bool GetCachePath(uint64_t sourceHash, int fontSize, int type, char *path, size_t size)
+{
+    const char *suffix = (type == FONT_SDF) ? "-sdf" : "";
+    const char *home = getenv("HOME");
+    int length;
+    if (home && home[0] != '\0') {
+        // Leaves room for the file name: "/font-", 16 hex digits, size, suffix
+        char dir[FONT_CACHE_MAX_PATH - 64];
+        length = snprintf(dir, sizeof(dir), "%s/.purple", home);
+        if (length < 0 || (size_t)length >= sizeof(dir)) return false;
+        struct stat st;
+        if (stat(dir, &st) != 0) (void)mkdir(dir, 0700);
+        length = snprintf(path, size, "%s/font-%016llx-%d%s.atlas", dir,
+                          (unsigned long long)sourceHash, fontSize, suffix);
+    } else {
+        length = snprintf(path, size, "font-%016llx-%d%s.atlas", (unsigned long long)sourceHash,
+                          fontSize, suffix);
+    }
+    return length >= 0 && (size_t)length < size;
+}
+
+bool WriteFontAtlasCache(const char *path, uint64_t sourceHash, const FontAtlas *atlas)
+{
+    if (path == NULL || atlas == NULL || atlas->glyphs == NULL || atlas->recs == NULL ||
+        atlas->atlas.data == NULL || atlas->atlas.format != PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA) {
+        return false;
+    }
+
+    size_t size = CacheFileSize(atlas->glyphCount, atlas->atlas.width, atlas->atlas.height);
+    unsigned char *buffer = malloc(size);
+    if (buffer == NULL) return false;
+
+    unsigned char *p = buffer;
+    memcpy(p, FONT_CACHE_MAGIC, FONT_CACHE_MAGIC_SIZE);
+    p += FONT_CACHE_MAGIC_SIZE;
+    p = PutU32(p, FONT_CACHE_VERSION);
+    p = PutU64(p, sourceHash);
+    p = PutU32(p, (uint32_t)atlas->baseSize);
+    p = PutU32(p, (uint32_t)atlas->type);
+    p = PutU32(p, (uint32_t)atlas->glyphCount);
+    p = PutU32(p, (uint32_t)atlas->glyphPadding);
+    p = PutU32(p, (uint32_t)atlas->atlas.width);
+    p = PutU32(p, (uint32_t)atlas->atlas.height);
+    for (int i = 0; i < atlas->glyphCount; ++i) {
+        const GlyphInfo *glyph = &atlas->glyphs[i];
+        p = PutU32(p, (uint32_t)glyph->value);
+        p = PutU32(p, (uint32_t)glyph->offsetX);
+        p = PutU32(p, (uint32_t)glyph->offsetY);
+        p = PutU32(p, (uint32_t)glyph->advanceX);
+        p = PutF32(p, atlas->recs[i].x);
+        p = PutF32(p, atlas->recs[i].y);
+        p = PutF32(p, atlas->recs[i].width);
+        p = PutF32(p, atlas->recs[i].height);
+    }
+    size_t pixelBytes = AtlasPixelBytes(atlas->atlas.width, atlas->atlas.height);
+    memcpy(p, atlas->atlas.data, pixelBytes);
+    p += pixelBytes;
+    PutU32(p, Fnv1a(FNV1A_SEED, buffer, size - FONT_CACHE_CHECKSUM_SIZE));
+
+    // Write-then-rename so a crash never leaves a torn cache behind
+    bool ok = WriteBufferAtomic(path, buffer, size);
+    free(buffer);
+    return ok;
+}
+
+bool ReadFontAtlasCache(const char *path, uint64_t sourceHash, int fontSize, int type,
+                        FontAtlas *atlas)
+{
+    if (path == NULL || atlas == NULL) return false;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)(FONT_CACHE_HEADER_SIZE + FONT_CACHE_CHECKSUM_SIZE)) {
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t)st.st_size;
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return false;
+
+    const unsigned char *base = (const unsigned char *)mapping;
+    uint32_t version = 0, storedSize = 0, storedType = 0;
+    uint32_t glyphCount = 0, padding = 0, width = 0, height = 0;
+    uint64_t storedHash = 0;
+    const unsigned char *p = base + FONT_CACHE_MAGIC_SIZE;
+    p = GetU32(p, &version);
+    p = GetU64(p, &storedHash);
+    p = GetU32(p, &storedSize);
+    p = GetU32(p, &storedType);
+    p = GetU32(p, &glyphCount);
+    p = GetU32(p, &padding);
+    p = GetU32(p, &width);
+    p = GetU32(p, &height);
+
+    uint32_t storedChecksum = 0;
+    bool valid = memcmp(base, FONT_CACHE_MAGIC, FONT_CACHE_MAGIC_SIZE) == 0 &&
+                 version == FONT_CACHE_VERSION && storedHash == sourceHash &&
+                 storedSize == (uint32_t)fontSize && storedType == (uint32_t)type &&
+                 glyphCount > 0 &&
+                 glyphCount <= FONT_CACHE_MAX_GLYPHS && width > 0 && height > 0 &&
+                 width <= FONT_CACHE_MAX_ATLAS && height <= FONT_CACHE_MAX_ATLAS &&
+                 size == CacheFileSize((int)glyphCount, (int)width, (int)height);
+    if (valid) {
+        GetU32(base + size - FONT_CACHE_CHECKSUM_SIZE, &storedChecksum);
+        valid = storedChecksum == Fnv1a(FNV1A_SEED, base, size - FONT_CACHE_CHECKSUM_SIZE);
+    }
+
+    GlyphInfo *glyphs = valid ? MemAlloc((unsigned int)(glyphCount * sizeof(GlyphInfo))) : NULL;
+    Rectangle *recs = valid ? MemAlloc((unsigned int)(glyphCount * sizeof(Rectangle))) : NULL;
+    if (glyphs == NULL || recs == NULL) {
+        MemFree(glyphs);
+        MemFree(recs);
+        munmap(mapping, size);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < glyphCount; ++i) {
+        p = GetI32(p, &glyphs[i].value);
+        p = GetI32(p, &glyphs[i].offsetX);
+        p = GetI32(p, &glyphs[i].offsetY);
+        p = GetI32(p, &glyphs[i].advanceX);
+        p = GetF32(p, &recs[i].x);
+        p = GetF32(p, &recs[i].y);
+        p = GetF32(p, &recs[i].width);
+        p = GetF32(p, &recs[i].height);
+    }
+
+    *atlas = (FontAtlas){
+        .baseSize = fontSize,
+        .glyphCount = (int)glyphCount,
+        .glyphPadding = (int)padding,
+        .type = type,
+        .glyphs = glyphs,
+        .recs = recs,
+        // Pixels stay in the page cache; nothing is copied until upload
+        .atlas = { .data = (void *)p, .width = (int)width, .height = (int)height,
+                   .mipmaps = 1, .format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA },
+        .mapping = mapping,
+        .mappingSize = size,
+        .fromCache = true
+    };
+    return true;
+}
+
+// The same steps LoadFontEx takes, minus the GPU upload. SDF glyph images
+// already include their falloff border, so they pack without extra padding.
+static bool BakeFontAtlas(const unsigned char *data, int dataSize, int fontSize, int type,
+                          FontAtlas *atlas)
+{
+    GlyphInfo *glyphs = LoadFontData(data, dataSize, fontSize, NULL, 0, type);
+    if (glyphs == NULL) return false;
+
+    const int glyphCount = 95;  // LoadFontData's default printable ASCII set
+    const int padding = (type == FONT_SDF) ? 0 : FONT_ATLAS_PADDING;
+    const int packMethod = (type == FONT_SDF) ? FONT_SDF_PACK_SKYLINE : 0;
+    Rectangle *recs = NULL;
+    Image image = GenImageFontAtlas(glyphs, &recs, glyphCount, fontSize, padding, packMethod);
+    if (image.data == NULL || recs == NULL) {
+        UnloadFontData(glyphs, glyphCount);
+        return false;
+    }
+
+    // Glyph bitmaps are only needed to build the atlas
+    for (int i = 0; i < glyphCount; ++i) {
+        UnloadImage(glyphs[i].image);
+        glyphs[i].image = (Image){0};
+    }
+
+    *atlas = (FontAtlas){
+        .baseSize = fontSize,
+        .glyphCount = glyphCount,
+        .glyphPadding = padding,
+        .type = type,
+        .glyphs = glyphs,
+        .recs = recs,
+        .atlas = image
+    };
+    return true;
+}
+
+bool LoadFontAtlasFromMemory(const unsigned char *data, int dataSize, int fontSize, int type,
+                             FontAtlas *atlas)
+{
+    if (data == NULL || dataSize <= 0 || atlas == NULL || fontSize <= 0) return false;
+    memset(atlas, 0, sizeof(*atlas));
+
+    uint64_t hash = HashFontData(data, (size_t)dataSize);
+    char cachePath[FONT_CACHE_MAX_PATH];
+    bool cached = GetCachePath(hash, fontSize, type, cachePath, sizeof(cachePath));
+
+    if (cached && ReadFontAtlasCache(cachePath, hash, fontSize, type, atlas)) return true;
+    if (!BakeFontAtlas(data, dataSize, fontSize, type, atlas)) return false;
+    if (!cached) return true;
+    // A failed cache write only costs the next launch a re-bake
+    (void)WriteFontAtlasCache(cachePath, hash, atlas);
+    return true;
+}
+
+bool LoadFontAtlas(const char *fontPath, int fontSize, int type, FontAtlas *atlas)
+{
+    if (fontPath == NULL || atlas == NULL || fontSize <= 0) return false;
+
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(fontPath, &dataSize);
+    bool ok = LoadFontAtlasFromMemory(data, dataSize, fontSize, type, atlas);
+    UnloadFileData(data);
+    return ok;
+}
+
+static void ReleaseAtlasPixels(FontAtlas *atlas)
+{
+    if (atlas->mapping != NULL) {
+        munmap(atlas->mapping, atlas->mappingSize);
+    } else {
+        UnloadImage(atlas->atlas);
+    }
+    atlas->mapping = NULL;
+    atlas->mappingSize = 0;
+    atlas->atlas = (Image){0};
+}
+
+Font UploadFontAtlas(FontAtlas *atlas)
+{
+    Font font = {0};
+    if (atlas == NULL || atlas->glyphs == NULL) return font;
+
+    font.baseSize = atlas->baseSize;
+    font.glyphCount = atlas->glyphCount;
+    font.glyphPadding = atlas->glyphPadding;
+    font.glyphs = atlas->glyphs;
+    font.recs = atlas->recs;
+    font.texture = LoadTextureFromImage(atlas->atlas);
+    SetTextureFilter(font.texture,
+                     (atlas->type == FONT_SDF) ? TEXTURE_FILTER_BILINEAR : TEXTURE_FILTER_POINT);
+
+    ReleaseAtlasPixels(atlas);
+    atlas->glyphs = NULL;
+    atlas->recs = NULL;
+    return font;
+}
+
+void UnloadFontAtlas(FontAtlas *atlas)
+{
+    if (atlas == NULL) return;
+    ReleaseAtlasPixels(atlas);
+    MemFree(atlas->glyphs);
+    MemFree(atlas->recs);
+    atlas->glyphs = NULL;
+    atlas->recs = NULL;
+}
+
+static bool UploadLoadedAtlas(bool loaded, FontAtlas *atlas, Font *font)
+{
+    if (!loaded) return false;
+    *font = UploadFontAtlas(atlas);
+    if (font->texture.id != 0) return true;
+    // Upload failed: the glyphs moved into font; hand them back to raylib
+    UnloadFont(*font);
+    return false;
+}
+
+// On failure, a bitmap atlas drawn through the SDF shader is thresholded at
+// half coverage, which stays legible
+Font LoadFontCached(const char *fontPath, int fontSize, int type)
+{
+    FontAtlas atlas;
+    Font font;
+    if (UploadLoadedAtlas(LoadFontAtlas(fontPath, fontSize, type, &atlas), &atlas, &font)) {
+        return font;
+    }
+    return LoadFontEx(fontPath, fontSize, NULL, 0);
+}
+
+Font LoadFontCachedFromMemory(const unsigned char *data, int dataSize, int fontSize, int type)
+{
+    FontAtlas atlas;
+    Font font;
+    if (UploadLoadedAtlas(LoadFontAtlasFromMemory(data, dataSize, fontSize, type, &atlas),
+                          &atlas, &font)) {
+        return font;
+    }
+    return LoadFontFromMemory(".ttf", data, dataSize, fontSize, NULL, 0);
+}
+
+Shader LoadSdfTextShader(void)
+{
+    return LoadShaderFromMemory(NULL, sdfFragmentShader);
+}
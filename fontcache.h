@@ -0,0 +1,75 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: fontcache.h
+    Description: Baked font atlas cache (glyph metrics plus atlas pixels)
+========================================================================= */
+
+#ifndef FONTCACHE_H
+#define FONTCACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <raylib/raylib.h>
+
+#define FONT_CACHE_MAX_PATH 512
+#define FONT_ATLAS_PADDING 4  // Same glyph padding raylib's LoadFontEx uses
+
+// One signed-distance-field atlas serves every text size; the distance
+// field carries its own padding, so the atlas adds none
+#define FONT_SDF_BASE_SIZE 32
+
+// A baked font that has not been uploaded to the GPU yet. Glyphs and recs are
+// MemAlloc'd so the Font that owns them later can be released by UnloadFont.
+typedef struct {
+    int baseSize;
+    int glyphCount;
+    int glyphPadding;
+    int type;             // FONT_DEFAULT or FONT_SDF
+    GlyphInfo *glyphs;
+    Rectangle *recs;
+    Image atlas;          // GRAY_ALPHA pixels, either owned or inside the mapping
+    void *mapping;        // mmap'd cache file backing atlas.data, if any
+    size_t mappingSize;
+    bool fromCache;
+} FontAtlas;
+
+// 64-bit FNV-1a of the font file contents; the cache key together with
+// size and type
+uint64_t HashFontData(const unsigned char *data, size_t size);
+
+// CPU side: load the atlas from the disk cache, or bake it from the TTF and
+// refresh the cache. Safe to call before InitWindow.
+bool LoadFontAtlas(const char *fontPath, int fontSize, int type, FontAtlas *atlas);
+
+// Same, for a TTF already in memory (e.g. embedded in the executable)
+bool LoadFontAtlasFromMemory(const unsigned char *data, int dataSize, int fontSize, int type,
+                             FontAtlas *atlas);
+
+// GPU side: upload the atlas and hand glyphs/recs to the returned Font.
+// SDF atlases get bilinear filtering. The FontAtlas is emptied; UnloadFont
+// releases everything.
+Font UploadFontAtlas(FontAtlas *atlas);
+
+// Release a FontAtlas that was never uploaded
+void UnloadFontAtlas(FontAtlas *atlas);
+
+// LoadFontAtlas + UploadFontAtlas, falling back to LoadFontEx (or
+// LoadFontFromMemory) on failure
+Font LoadFontCached(const char *fontPath, int fontSize, int type);
+Font LoadFontCachedFromMemory(const unsigned char *data, int dataSize, int fontSize, int type);
+
+// Fragment shader that turns SDF atlas samples into antialiased coverage;
+// draw text from an SDF font between BeginShaderMode/EndShaderMode with it
+Shader LoadSdfTextShader(void);
+
+// Cache file I/O (exposed for tests). Reading maps the file; the atlas
+// pixels point into the mapping until the atlas is uploaded or unloaded.
+bool WriteFontAtlasCache(const char *path, uint64_t sourceHash, const FontAtlas *atlas);
+bool ReadFontAtlasCache(const char *path, uint64_t sourceHash, int fontSize, int type,
+                        FontAtlas *atlas);
+
+#endif // FONTCACHE_H
@@ -0,0 +1,63 @@
+/* =========================================================================
+    Purple - Fuzz Testing
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    See LICENSE.txt for 3rd party library and other resource licenses.
+    File: fuzz_leaderboard_text.c
+    Description: Coverage-guided fuzz testing for the leaderboard text parser
+========================================================================= */
+
+#include <stdint.h>
+#include <string.h>
+#include "../leaderboard.h"
+
+typedef struct {
+    size_t entries;
+    size_t reparsed;
+} FuzzCounts;
+
+static void CountLine(void *context, const LeaderboardEntry *e)
+{
+    (void)e;
+    ((FuzzCounts *)context)->entries++;
+}
+
+/* Every parsed entry must format to a line that parses again */
+static void CheckEntry(void *context, const LeaderboardEntry *e)
+{
+    FuzzCounts *counts = (FuzzCounts *)context;
+    counts->entries++;
+    if (e->initials[3] != '\0' || (e->winner != 'P' && e->winner != 'A')) {
+        __builtin_trap();
+    }
+    if (e->initials[0] == '\0') return;  /* A NUL byte as the first initial */
+
+    char line[LEADERBOARD_TEXT_LINE_MAX];
+    size_t length = FormatLeaderboardLine(line, e);
+    if (length > sizeof(line) || line[length - 1] != '\n') {
+        __builtin_trap();
+    }
+    LeaderboardTextStats stats;
+    ParseLeaderboardText(line, length, CountLine, &counts->reparsed, &stats);
+    if (stats.imported != 1) {
+        __builtin_trap();
+    }
+}
+
+/* Fuzz target: arbitrary bytes as a text dump (not NUL terminated)
+ * Tests line splitting, number parsing and the counters it reports
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    FuzzCounts counts = {0};
+    LeaderboardTextStats stats;
+    ParseLeaderboardText((const char *)data, size, CheckEntry, &counts, &stats);
+
+    if (stats.imported + stats.malformed != stats.lines || stats.imported != counts.entries) {
+        __builtin_trap();
+    }
+    if ((stats.malformed > 0) != (stats.firstMalformed > 0)) {
+        __builtin_trap();
+    }
+    return 0;
+}
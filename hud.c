@@ -0,0 +1,71 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: hud.c
+    Description: HUD labels formatted and laid out only when their value changes
+========================================================================= */
+
+#include "hud.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+void InitHudLabel(HudLabel *label, Font font, float fontSize, float spacing)
+{
+    if (!label) return;
+    memset(label, 0, sizeof(*label));
+    label->font = font;
+    label->fontSize = fontSize;
+    label->spacing = spacing;
+}
+
+bool IsHudLabelStale(const HudLabel *label, long key)
+{
+    if (!label) return false;
+    return !label->valid || label->key != key;
+}
+
+void SetHudLabel(HudLabel *label, long key, const char *text)
+{
+    if (!label || !text) return;
+
+    label->key = key;
+    label->valid = true;
+    label->updates++;
+    snprintf(label->text, sizeof(label->text), "%s", text);
+
+    const TextRun *run = GetTextRun(label->font, label->text, label->fontSize, label->spacing);
+    label->hasRun = (run != NULL);
+    if (run != NULL) label->run = *run;
+}
+
+bool SetHudLabelNumber(HudLabel *label, const char *prefix, int value)
+{
+    if (!IsHudLabelStale(label, value)) return false;
+
+    char text[HUD_LABEL_MAX_TEXT];
+    snprintf(text, sizeof(text), "%s%d", prefix ? prefix : "", value);
+    SetHudLabel(label, value, text);
+    return true;
+}
+
+void DrawHudLabel(const HudLabel *label, Vector2 position, Color tint)
+{
+    if (!label || !label->valid) return;
+    if (label->hasRun) {
+        DrawTextRun(label->font, &label->run, position, tint);
+    } else {
+        DrawTextEx(label->font, label->text, position, label->fontSize, label->spacing, tint);
+    }
+}
+
+void DrawHudLabelCentered(const HudLabel *label, int width, float y, Color tint)
+{
+    if (!label || !label->valid) return;
+    Vector2 size = label->hasRun ? label->run.size
+                                 : MeasureTextEx(label->font, label->text,
+                                                 label->fontSize, label->spacing);
+    DrawHudLabel(label, (Vector2){ ((float)width - size.x) / 2.0f, y }, tint);
+}
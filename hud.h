@@ -0,0 +1,48 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: hud.h
+    Description: HUD labels formatted and laid out only when their value changes
+========================================================================= */
+
+#ifndef HUD_H
+#define HUD_H
+
+#include <stdbool.h>
+#include <raylib/raylib.h>
+#include "textcache.h"
+
+#define HUD_LABEL_MAX_TEXT TEXT_RUN_MAX_TEXT
+
+// A piece of dynamic text keyed on the value it displays
+typedef struct {
+    Font font;
+    float fontSize;
+    float spacing;
+    long key;           // Value the current text was built from
+    bool valid;         // False until the first SetHudLabel
+    char text[HUD_LABEL_MAX_TEXT];
+    bool hasRun;        // False if the text could not be laid out (drawn via raylib)
+    TextRun run;        // Private copy, so text cache eviction cannot touch it
+    unsigned int updates;  // Number of times the text was rebuilt
+} HudLabel;
+
+// Prepare an empty label for a font, size and spacing
+void InitHudLabel(HudLabel *label, Font font, float fontSize, float spacing);
+
+// True if the label does not yet show the given key
+bool IsHudLabelStale(const HudLabel *label, long key);
+
+// Replace the text and lay it out once; later draws reuse the glyph quads
+void SetHudLabel(HudLabel *label, long key, const char *text);
+
+// Rebuild "<prefix><value>" only if value changed. Returns true if rebuilt.
+bool SetHudLabelNumber(HudLabel *label, const char *prefix, int value);
+
+// Draw at a position, or centered horizontally within a given width
+void DrawHudLabel(const HudLabel *label, Vector2 position, Color tint);
+void DrawHudLabelCentered(const HudLabel *label, int width, float y, Color tint);
+
+#endif // HUD_H
@@ -0,0 +1,75 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: input.c
+    Description: Per-frame input accumulated across one or more event polls
+========================================================================= */
+
+#include "input.h"
+#include <raylib/raylib.h>
+#include <stddef.h>
+#include "profiler.h"
+
+static const int keyCodes[INPUT_KEY_COUNT] = {
+    KEY_UP, KEY_DOWN, KEY_SPACE, KEY_ENTER, KEY_BACKSPACE, KEY_F3
+};
+
+void AccumulateInput(InputFrame *input)
+{
+    if (!input) return;
+
+    for (int key = 0; key < INPUT_KEY_COUNT; ++key) {
+        input->down[key] = IsKeyDown(keyCodes[key]);
+        if (IsKeyPressed(keyCodes[key])) input->pressed[key] = true;
+    }
+    for (int codepoint = GetCharPressed(); codepoint > 0; codepoint = GetCharPressed()) {
+        PushInputChar(input, codepoint);
+    }
+    input->sampledAt = ProfilerNow();
+}
+
+void ResetInputFrame(InputFrame *input)
+{
+    if (!input) return;
+    for (int key = 0; key < INPUT_KEY_COUNT; ++key) {
+        input->pressed[key] = false;
+    }
+    input->charCount = 0;
+    input->charRead = 0;
+}
+
+bool HasInputActivity(const InputFrame *input)
+{
+    if (!input) return false;
+    if (input->charCount > 0) return true;
+    for (int key = 0; key < INPUT_KEY_COUNT; ++key) {
+        if (input->down[key] || input->pressed[key]) return true;
+    }
+    return false;
+}
+
+bool IsInputDown(const InputFrame *input, InputKey key)
+{
+    if (!input || key >= INPUT_KEY_COUNT) return false;
+    return input->down[key];
+}
+
+bool IsInputPressed(const InputFrame *input, InputKey key)
+{
+    if (!input || key >= INPUT_KEY_COUNT) return false;
+    return input->pressed[key];
+}
+
+void PushInputChar(InputFrame *input, int codepoint)
+{
+    if (!input || input->charCount >= INPUT_MAX_CHARS) return;
+    input->chars[input->charCount++] = codepoint;
+}
+
+int PopInputChar(InputFrame *input)
+{
+    if (!input || input->charRead >= input->charCount) return 0;
+    return input->chars[input->charRead++];
+}
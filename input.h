@@ -0,0 +1,57 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: input.h
+    Description: Per-frame input accumulated across one or more event polls
+========================================================================= */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define INPUT_MAX_CHARS 16
+
+// Keys the game reacts to
+typedef enum {
+    INPUT_UP,
+    INPUT_DOWN,
+    INPUT_SPACE,
+    INPUT_ENTER,
+    INPUT_BACKSPACE,
+    INPUT_TOGGLE_PROFILER,
+    INPUT_KEY_COUNT
+} InputKey;
+
+// raylib forgets key edges and queued characters on every PollInputEvents.
+// Accumulating after each poll lets a frame poll twice (once inside
+// EndDrawing, once late before simulating) without dropping presses.
+typedef struct {
+    bool down[INPUT_KEY_COUNT];     // State at the latest poll
+    bool pressed[INPUT_KEY_COUNT];  // Pressed at any poll since the last reset
+    int chars[INPUT_MAX_CHARS];
+    int charCount;
+    int charRead;
+    uint64_t sampledAt;             // ProfilerNow() of the latest poll
+} InputFrame;
+
+// Fold the state of the most recent raylib poll into the frame
+void AccumulateInput(InputFrame *input);
+
+// Forget presses and characters once the update has consumed them
+void ResetInputFrame(InputFrame *input);
+
+// True if any key is held or was pressed, or a character was typed
+bool HasInputActivity(const InputFrame *input);
+
+bool IsInputDown(const InputFrame *input, InputKey key);
+bool IsInputPressed(const InputFrame *input, InputKey key);
+
+// Character queue; characters beyond INPUT_MAX_CHARS per frame are dropped
+void PushInputChar(InputFrame *input, int codepoint);
+int PopInputChar(InputFrame *input);  // 0 when empty
+
+#endif // INPUT_H
@@ -7,12 +7,42 @@
     Description: Leaderboard management (load, save, add entries)
 ========================================================================= */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "leaderboard.h"
+#include "binfile.h"
+#include "scoreindex.h"
+#include "scorewindow.h"
+#include <float.h>
+#include <math.h>
+#include <fcntl.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+// Binary layout (little-endian):
+//   header  magic[8] "PRPLLDBD", u32 version, u32 record size, u32 count, u32 generation
+//   records count x { char initials[4], char winner, u8 pad[3], f32 seconds,
+//                     i64 timestamp }
+//   footer  u32 FNV-1a of everything before it
+// The generation (header word 4) goes up with every rewrite; see the journal.
+// Version 1 records stop after seconds (12 bytes); they still load, unstamped.
+#define LEADERBOARD_MAGIC "PRPLLDBD"
+#define LEADERBOARD_MAGIC_SIZE 8
+#define LEADERBOARD_VERSION 2u
+#define LEADERBOARD_HEADER_SIZE (LEADERBOARD_MAGIC_SIZE + 4 * 4)
+#define LEADERBOARD_RECORD_SIZE 20
+#define LEADERBOARD_V1_RECORD_SIZE 12
+#define LEADERBOARD_CHECKSUM_SIZE 4
+#define LEADERBOARD_MAX_RECORDS (1u << 28)  // Sanity bound on the header count
+#define LEADERBOARD_WRITE_BATCH 256         // Records encoded per fwrite
+#define LEADERBOARD_TEXT_CHUNK 65536        // Bytes of text per export write
 
 static const char *GetLeaderboardDir(void)
 {
@@ -27,14 +57,14 @@ static const char *GetLeaderboardDir(void)
     return dir;
 }
 
-static const char *GetLeaderboardPath(void)
+static const char *GetLeaderboardFile(const char *name)
 {
     static char path[512];
     const char *dir = GetLeaderboardDir();
     if (strcmp(dir, ".") == 0) {
-        snprintf(path, sizeof(path), "leaderboard.txt");
+        snprintf(path, sizeof(path), "%s", name);
     } else {
-        snprintf(path, sizeof(path), "%s/leaderboard.txt", dir);
+        snprintf(path, sizeof(path), "%s/%s", dir, name);
     }
     return path;
 }
@@ -48,64 +78,880 @@ static void EnsureDirExists(void)
     (void)mkdir(dir, 0700);
 }
 
-static int CompareEntries(const void *a, const void *b)
+// Copy up to 3 initials and ensure null termination
+static void CopyInitials(char *dst, const char *src)
 {
-    const LeaderboardEntry *ea = (const LeaderboardEntry *)a;
-    const LeaderboardEntry *eb = (const LeaderboardEntry *)b;
-    if (ea->seconds < eb->seconds) return -1;
-    if (ea->seconds > eb->seconds) return 1;
-    return 0;
+    size_t j = 0;
+    for (; j < 3 && src[j] != '\0'; ++j) {
+        dst[j] = src[j];
+    }
+    for (; j < 4; ++j) {
+        dst[j] = '\0';
+    }
 }
 
-void LoadLeaderboard(Leaderboard *lb)
+// NaN ranks after every real time
+static float EntryKey(float seconds)
+{
+    return isnan(seconds) ? INFINITY : seconds;
+}
+
+static void ClearEntries(Leaderboard *lb)
 {
-    if (!lb) return;
     lb->count = 0;
-    const char *path = GetLeaderboardPath();
-    FILE *fp = fopen(path, "r");
-    if (!fp) return;
-
-    char line[256];
-    while (fgets(line, sizeof(line), fp) && lb->count < LEADERBOARD_MAX_ENTRIES) {
-        // Format: seconds;winner;initials
-        char initials[8] = {0};
-        char winner = 'P';
-        float seconds = 0.0f;
-        if (sscanf(line, "%f;%c;%7s", &seconds, &winner, initials) == 3) {
-            LeaderboardEntry *e = &lb->entries[lb->count++];
-            e->seconds = seconds;
-            e->winner = (winner == 'A') ? 'A' : 'P';
-            // Copy up to 3 chars and ensure null termination
-            size_t j = 0;
-            for (; j < 3 && initials[j] != '\0'; ++j) {
-                e->initials[j] = initials[j];
+    if (lb->index) ClearScoreIndex(lb->index);
+    for (int w = 0; w < LEADERBOARD_WINDOW_COUNT; ++w) ClearScoreWindow(lb->windows[w]);
+}
+
+// Keep the fastest LEADERBOARD_MAX_ENTRIES in entries[]. With an index the
+// full history goes there and entries[] mirrors its head; without one the
+// array is kept sorted by insertion (O(K), no full re-sort). Returns true if
+// entries[] changed.
+static bool InsertTopEntry(Leaderboard *lb, const LeaderboardEntry *e)
+{
+    if (lb->index) {
+        if (!InsertScore(lb->index, e)) return false;
+        bool visible = lb->count < LEADERBOARD_MAX_ENTRIES ||
+                       EntryKey(e->seconds) < EntryKey(lb->entries[lb->count - 1].seconds);
+        if (visible) {
+            lb->count = CopyTopScores(lb->index, lb->entries, LEADERBOARD_MAX_ENTRIES);
+        }
+        return visible;
+    }
+
+    // Equal times keep arrival order, so the new entry goes after them
+    float key = EntryKey(e->seconds);
+    size_t pos = lb->count;
+    while (pos > 0 && EntryKey(lb->entries[pos - 1].seconds) > key) pos--;
+    if (pos >= LEADERBOARD_MAX_ENTRIES) {
+        // Not good enough to enter top list
+        return false;
+    }
+    size_t kept = (lb->count < LEADERBOARD_MAX_ENTRIES) ? lb->count : LEADERBOARD_MAX_ENTRIES - 1;
+    memmove(&lb->entries[pos + 1], &lb->entries[pos], (kept - pos) * sizeof(LeaderboardEntry));
+    lb->entries[pos] = *e;
+    lb->count = kept + 1;
+    return true;
+}
+
+// Every board takes the result at once; returns true if any of them changed
+static bool InsertEntry(Leaderboard *lb, const LeaderboardEntry *e)
+{
+    bool changed = false;
+    for (int w = 0; w < LEADERBOARD_WINDOW_COUNT; ++w) {
+        changed = InsertWindowScore(lb->windows[w], e) || changed;
+    }
+    return InsertTopEntry(lb, e) || changed;
+}
+
+size_t LeaderboardTotal(const Leaderboard *lb)
+{
+    if (!lb) return 0;
+    return lb->index ? ScoreIndexCount(lb->index) : lb->count;
+}
+
+size_t LeaderboardRank(const Leaderboard *lb, float seconds)
+{
+    if (!lb) return 1;
+    if (lb->index) return ScoreRank(lb->index, seconds);
+    float key = EntryKey(seconds);
+    size_t faster = 0;
+    while (faster < lb->count && EntryKey(lb->entries[faster].seconds) < key) faster++;
+    return faster + 1;
+}
+
+bool LeaderboardEntryAtRank(const Leaderboard *lb, size_t rank, LeaderboardEntry *out)
+{
+    if (!lb || !out || rank == 0) return false;
+    if (lb->index) {
+        const LeaderboardEntry *e = ScoreAtRank(lb->index, rank);
+        if (!e) return false;
+        *out = *e;
+        return true;
+    }
+    if (rank > lb->count) return false;
+    *out = lb->entries[rank - 1];
+    return true;
+}
+
+// Map path and check magic, version, size and checksum. Returns the mapping
+// (records start after the header) or NULL.
+static const unsigned char *MapBoardFile(const char *path, size_t *size, uint32_t *count,
+                                         uint32_t *generation, size_t *recordSize)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)(LEADERBOARD_HEADER_SIZE + LEADERBOARD_CHECKSUM_SIZE)) {
+        close(fd);
+        return NULL;
+    }
+    *size = (size_t)st.st_size;
+    void *mapping = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return NULL;
+
+    const unsigned char *base = (const unsigned char *)mapping;
+    uint32_t version = 0, storedSize = 0, checksum = 0;
+    const unsigned char *p = base + LEADERBOARD_MAGIC_SIZE;
+    p = GetU32(p, &version);
+    p = GetU32(p, &storedSize);
+    p = GetU32(p, count);
+    GetU32(p, generation);
+    GetU32(base + *size - LEADERBOARD_CHECKSUM_SIZE, &checksum);
+    *recordSize = storedSize;
+
+    bool known = (version == LEADERBOARD_VERSION && storedSize == LEADERBOARD_RECORD_SIZE) ||
+                 (version == 1u && storedSize == LEADERBOARD_V1_RECORD_SIZE);
+    bool valid = memcmp(base, LEADERBOARD_MAGIC, LEADERBOARD_MAGIC_SIZE) == 0 && known &&
+                 *count <= LEADERBOARD_MAX_RECORDS &&
+                 *size == LEADERBOARD_HEADER_SIZE + (size_t)*count * storedSize +
+                          LEADERBOARD_CHECKSUM_SIZE &&
+                 checksum == Fnv1a(FNV1A_SEED, base, *size - LEADERBOARD_CHECKSUM_SIZE);
+    if (!valid) {
+        munmap(mapping, *size);
+        return NULL;
+    }
+    return base;
+}
+
+// Generation of a valid board file; 0 if it is missing or corrupt
+static uint32_t BoardGeneration(const char *path)
+{
+    size_t size = 0, recordSize = 0;
+    uint32_t count = 0, generation = 0;
+    const unsigned char *base = MapBoardFile(path, &size, &count, &generation, &recordSize);
+    if (!base) return 0;
+    munmap((void *)(uintptr_t)base, size);
+    return generation;
+}
+
+// recordSize tells the current layout from version 1, which has no timestamp
+static void DecodeRecord(const unsigned char *p, size_t recordSize, LeaderboardEntry *e)
+{
+    char initials[4];
+    memcpy(initials, p, 3);
+    initials[3] = '\0';
+    CopyInitials(e->initials, initials);
+    e->winner = (p[4] == 'A') ? 'A' : 'P';
+    uint32_t bits = 0;
+    GetU32(p + 8, &bits);
+    memcpy(&e->seconds, &bits, sizeof(e->seconds));
+    e->timestamp = 0;
+    if (recordSize >= LEADERBOARD_RECORD_SIZE) {
+        uint64_t timestamp = 0;
+        GetU64(p + 12, &timestamp);
+        e->timestamp = (int64_t)timestamp;
+    }
+}
+
+static void EncodeRecord(unsigned char *p, const LeaderboardEntry *e)
+{
+    memset(p, 0, LEADERBOARD_RECORD_SIZE);
+    memcpy(p, e->initials, 3);
+    p[4] = (unsigned char)e->winner;
+    uint32_t bits;
+    memcpy(&bits, &e->seconds, sizeof(bits));
+    PutU64(PutU32(p + 8, bits), (uint64_t)e->timestamp);
+}
+
+static bool LoadBoardFile(Leaderboard *lb, const char *path, uint32_t *generation)
+{
+    size_t size = 0, recordSize = 0;
+    uint32_t count = 0;
+    const unsigned char *base = MapBoardFile(path, &size, &count, generation, &recordSize);
+    if (!base) return false;
+
+    // Fixed records: field copies only, no text to scan
+    ClearEntries(lb);
+    const unsigned char *p = base + LEADERBOARD_HEADER_SIZE;
+    for (uint32_t i = 0; i < count; ++i, p += recordSize) {
+        LeaderboardEntry e;
+        DecodeRecord(p, recordSize, &e);
+        InsertEntry(lb, &e);
+    }
+    lb->revision++;
+    munmap((void *)(uintptr_t)base, size);
+    return true;
+}
+
+bool LoadLeaderboardFile(Leaderboard *lb, const char *path)
+{
+    if (!lb || !path) return false;
+    uint32_t generation = 0;
+    return LoadBoardFile(lb, path, &generation);
+}
+
+// Journal layout (little-endian):
+//   header  magic[8] "PRPLJRNL", u32 version, u32 generation
+//   records { board record, u32 FNV-1a of it } appended one by one
+// A record's own checksum lets replay stop cleanly at a torn final write.
+// Version 1 journals hold version 1 board records; opening one for appends
+// folds it into the snapshot first.
+#define JOURNAL_MAGIC "PRPLJRNL"
+#define JOURNAL_VERSION 2u
+#define JOURNAL_HEADER_SIZE (LEADERBOARD_MAGIC_SIZE + 2 * 4)
+#define JOURNAL_RECORD_SIZE (LEADERBOARD_RECORD_SIZE + 4)
+
+static bool JournalRecordValid(const unsigned char *p, size_t recordSize)
+{
+    uint32_t checksum = 0;
+    GetU32(p + recordSize, &checksum);
+    return checksum == Fnv1a(FNV1A_SEED, p, recordSize);
+}
+
+// Map a journal that follows the given snapshot generation. Sets records to
+// the length of its valid prefix and recordSize to the board record size
+// (journal records are 4 bytes longer).
+static const unsigned char *MapJournal(const char *path, uint32_t generation, size_t *size,
+                                       size_t *records, size_t *recordSize)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)JOURNAL_HEADER_SIZE) {
+        close(fd);
+        return NULL;
+    }
+    *size = (size_t)st.st_size;
+    void *mapping = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return NULL;
+
+    const unsigned char *base = (const unsigned char *)mapping;
+    uint32_t version = 0, journalGeneration = 0;
+    GetU32(GetU32(base + LEADERBOARD_MAGIC_SIZE, &version), &journalGeneration);
+    if (memcmp(base, JOURNAL_MAGIC, LEADERBOARD_MAGIC_SIZE) != 0 ||
+        (version != JOURNAL_VERSION && version != 1u) || journalGeneration != generation) {
+        munmap(mapping, *size);
+        return NULL;
+    }
+    *recordSize = (version == 1u) ? LEADERBOARD_V1_RECORD_SIZE : LEADERBOARD_RECORD_SIZE;
+    size_t stride = *recordSize + 4u;
+    size_t available = (*size - JOURNAL_HEADER_SIZE) / stride;
+    *records = 0;
+    while (*records < available &&
+           JournalRecordValid(base + JOURNAL_HEADER_SIZE + *records * stride, *recordSize)) {
+        (*records)++;
+    }
+    return base;
+}
+
+static size_t ReplayJournal(Leaderboard *lb, const char *path, uint32_t generation)
+{
+    size_t size = 0, records = 0, recordSize = 0;
+    const unsigned char *base = MapJournal(path, generation, &size, &records, &recordSize);
+    if (!base) return 0;
+    for (size_t i = 0; i < records; ++i) {
+        LeaderboardEntry e;
+        DecodeRecord(base + JOURNAL_HEADER_SIZE + i * (recordSize + 4u), recordSize, &e);
+        InsertEntry(lb, &e);
+    }
+    munmap((void *)(uintptr_t)base, size);
+    return records;
+}
+
+bool LoadLeaderboardJournaled(Leaderboard *lb, const char *path, const char *journalPath)
+{
+    if (!lb || !path || !journalPath) return false;
+    uint32_t generation = 0;
+    bool loaded = LoadBoardFile(lb, path, &generation);
+    if (!loaded) ClearEntries(lb);
+    size_t replayed = ReplayJournal(lb, journalPath, generation);
+    lb->revision++;
+    return loaded || replayed > 0;
+}
+
+// Encodes records in batches, keeping the running checksum
+typedef struct {
+    FILE *fp;
+    uint32_t hash;
+    size_t used;
+    bool ok;
+    unsigned char batch[LEADERBOARD_WRITE_BATCH * LEADERBOARD_RECORD_SIZE];
+} RecordBatch;
+
+static void FlushRecords(RecordBatch *out)
+{
+    out->hash = Fnv1a(out->hash, out->batch, out->used);
+    out->ok = out->ok && fwrite(out->batch, 1, out->used, out->fp) == out->used;
+    out->used = 0;
+}
+
+static void PutEncodedRecord(RecordBatch *out, const unsigned char *record)
+{
+    memcpy(&out->batch[out->used], record, LEADERBOARD_RECORD_SIZE);
+    out->used += LEADERBOARD_RECORD_SIZE;
+    if (out->used == sizeof(out->batch)) FlushRecords(out);
+}
+
+static void PutRecord(RecordBatch *out, const LeaderboardEntry *e)
+{
+    EncodeRecord(&out->batch[out->used], e);
+    out->used += LEADERBOARD_RECORD_SIZE;
+    if (out->used == sizeof(out->batch)) FlushRecords(out);
+}
+
+// Streams records fastest first from the index, or from entries[]
+static void PutBoardRecords(RecordBatch *out, const void *context)
+{
+    const Leaderboard *lb = (const Leaderboard *)context;
+    if (lb->index) {
+        ScoreCursor cursor;
+        for (const LeaderboardEntry *e = FirstScore(lb->index, &cursor); e; e = NextScore(&cursor)) {
+            PutRecord(out, e);
+        }
+    } else {
+        for (size_t i = 0; i < lb->count; ++i) PutRecord(out, &lb->entries[i]);
+    }
+}
+
+typedef struct {
+    const unsigned char *records;  // Already encoded, from the old file
+    size_t recordCount;
+    size_t recordSize;
+    const unsigned char *journal;  // Journal records (with their checksums)
+    size_t journalCount;
+    size_t journalRecordSize;      // Board record size inside the journal
+    const LeaderboardEntry *entries;
+    size_t entryCount;
+} AppendSource;
+
+// Current-format records are copied as they are; version 1 ones are
+// decoded and written again with an unknown timestamp
+static void PutAppendedRecords(RecordBatch *out, const void *context)
+{
+    const AppendSource *source = (const AppendSource *)context;
+    if (source->recordSize == LEADERBOARD_RECORD_SIZE) {
+        size_t bytes = source->recordCount * LEADERBOARD_RECORD_SIZE;
+        if (bytes > 0) {
+            out->hash = Fnv1a(out->hash, source->records, bytes);
+            out->ok = out->ok && fwrite(source->records, 1, bytes, out->fp) == bytes;
+        }
+    } else {
+        for (size_t i = 0; i < source->recordCount; ++i) {
+            LeaderboardEntry e;
+            DecodeRecord(source->records + i * source->recordSize, source->recordSize, &e);
+            PutRecord(out, &e);
+        }
+    }
+    size_t stride = source->journalRecordSize + 4u;
+    for (size_t i = 0; i < source->journalCount; ++i) {
+        const unsigned char *record = source->journal + i * stride;
+        if (source->journalRecordSize == LEADERBOARD_RECORD_SIZE) {
+            PutEncodedRecord(out, record);
+        } else {
+            LeaderboardEntry e;
+            DecodeRecord(record, source->journalRecordSize, &e);
+            PutRecord(out, &e);
+        }
+    }
+    for (size_t i = 0; i < source->entryCount; ++i) PutRecord(out, &source->entries[i]);
+}
+
+typedef struct {
+    const unsigned char *header;
+    void (*putRecords)(RecordBatch *out, const void *context);
+    const void *context;
+} BoardContents;
+
+static bool WriteBoardContents(FILE *fp, void *context)
+{
+    const BoardContents *board = (const BoardContents *)context;
+    RecordBatch out;
+    out.fp = fp;
+    out.hash = Fnv1a(FNV1A_SEED, board->header, LEADERBOARD_HEADER_SIZE);
+    out.used = 0;
+    out.ok = fwrite(board->header, 1, LEADERBOARD_HEADER_SIZE, fp) == LEADERBOARD_HEADER_SIZE;
+    board->putRecords(&out, board->context);
+    FlushRecords(&out);
+    unsigned char footer[LEADERBOARD_CHECKSUM_SIZE];
+    PutU32(footer, out.hash);
+    return (fwrite(footer, 1, sizeof(footer), fp) == sizeof(footer)) && out.ok;
+}
+
+// Write-then-rename: a crash leaves either the old board or the new one
+static bool WriteBoardFile(const char *path, size_t total, uint32_t generation,
+                           void (*putRecords)(RecordBatch *out, const void *context),
+                           const void *context)
+{
+    if (total > LEADERBOARD_MAX_RECORDS) return false;
+
+    unsigned char header[LEADERBOARD_HEADER_SIZE];
+    unsigned char *p = header;
+    memcpy(p, LEADERBOARD_MAGIC, LEADERBOARD_MAGIC_SIZE);
+    p += LEADERBOARD_MAGIC_SIZE;
+    p = PutU32(p, LEADERBOARD_VERSION);
+    p = PutU32(p, LEADERBOARD_RECORD_SIZE);
+    p = PutU32(p, (uint32_t)total);
+    PutU32(p, generation);
+
+    BoardContents board = { header, putRecords, context };
+    return WriteFileAtomic(path, WriteBoardContents, &board);
+}
+
+// Every rewrite takes a new generation, which retires the journal kept
+// against the old one
+bool SaveLeaderboardFile(const Leaderboard *lb, const char *path)
+{
+    if (!lb || !path) return false;
+    return WriteBoardFile(path, LeaderboardTotal(lb), BoardGeneration(path) + 1u,
+                          PutBoardRecords, lb);
+}
+
+// Rewrite path as its records plus journal records (of journalRecordSize
+// board bytes each) and entries; generation receives the new file's generation
+static bool AppendBoardFile(const char *path, const unsigned char *journal, size_t journalCount,
+                            size_t journalRecordSize, const LeaderboardEntry *entries,
+                            size_t count, uint32_t *generation)
+{
+    size_t size = 0, recordSize = 0;
+    uint32_t oldCount = 0, oldGeneration = 0;
+    const unsigned char *base = MapBoardFile(path, &size, &oldCount, &oldGeneration, &recordSize);
+    AppendSource source = { base ? base + LEADERBOARD_HEADER_SIZE : NULL, base ? oldCount : 0,
+                            recordSize, journal, journalCount, journalRecordSize, entries, count };
+    *generation = (base ? oldGeneration : 0) + 1u;
+    bool ok = WriteBoardFile(path, source.recordCount + journalCount + count, *generation,
+                             PutAppendedRecords, &source);
+    if (base) munmap((void *)(uintptr_t)base, size);
+    return ok;
+}
+
+bool AppendLeaderboardFile(const char *path, const LeaderboardEntry *entries, size_t count)
+{
+    if (!path || (!entries && count > 0)) return false;
+    uint32_t generation = 0;
+    return AppendBoardFile(path, NULL, 0, LEADERBOARD_RECORD_SIZE, entries, count, &generation);
+}
+
+// Replace the journal with an empty one for generation and open it for appends
+static bool ResetJournal(LeaderboardJournal *journal, const char *path, uint32_t generation)
+{
+    unsigned char header[JOURNAL_HEADER_SIZE];
+    memcpy(header, JOURNAL_MAGIC, LEADERBOARD_MAGIC_SIZE);
+    PutU32(PutU32(header + LEADERBOARD_MAGIC_SIZE, JOURNAL_VERSION), generation);
+
+    if (!WriteBufferAtomic(path, header, sizeof(header))) return false;
+    journal->fd = open(path, O_WRONLY | O_APPEND);
+    journal->generation = generation;
+    journal->records = 0;
+    return journal->fd >= 0;
+}
+
+bool OpenLeaderboardJournal(LeaderboardJournal *journal, const char *path, const char *snapshotPath)
+{
+    if (!journal || !path || !snapshotPath) return false;
+    journal->fd = -1;
+    uint32_t generation = BoardGeneration(snapshotPath);
+
+    size_t size = 0, records = 0, recordSize = 0;
+    const unsigned char *base = MapJournal(path, generation, &size, &records, &recordSize);
+    if (!base) return ResetJournal(journal, path, generation);
+    if (recordSize != LEADERBOARD_RECORD_SIZE) {
+        // Older record format: fold it into the snapshot rather than append
+        // records of two sizes
+        bool ok = AppendBoardFile(snapshotPath, base + JOURNAL_HEADER_SIZE, records, recordSize,
+                                  NULL, 0, &generation);
+        munmap((void *)(uintptr_t)base, size);
+        return ok && ResetJournal(journal, path, generation);
+    }
+    munmap((void *)(uintptr_t)base, size);
+
+    // Keep the valid prefix; a torn final record is cut off before appending
+    journal->fd = open(path, O_WRONLY | O_APPEND);
+    if (journal->fd < 0) return false;
+    if (ftruncate(journal->fd, (off_t)(JOURNAL_HEADER_SIZE + records * JOURNAL_RECORD_SIZE)) != 0) {
+        CloseLeaderboardJournal(journal);
+        return false;
+    }
+    journal->generation = generation;
+    journal->records = records;
+    return true;
+}
+
+bool AppendLeaderboardJournal(LeaderboardJournal *journal, const LeaderboardEntry *entries,
+                              size_t count)
+{
+    if (!journal || journal->fd < 0 || (!entries && count > 0)) return false;
+    unsigned char batch[LEADERBOARD_WRITE_BATCH * JOURNAL_RECORD_SIZE];
+    size_t done = 0;
+    while (done < count) {
+        size_t n = count - done;
+        if (n > LEADERBOARD_WRITE_BATCH) n = LEADERBOARD_WRITE_BATCH;
+        for (size_t i = 0; i < n; ++i) {
+            unsigned char *p = &batch[i * JOURNAL_RECORD_SIZE];
+            EncodeRecord(p, &entries[done + i]);
+            PutU32(p + LEADERBOARD_RECORD_SIZE, Fnv1a(FNV1A_SEED, p, LEADERBOARD_RECORD_SIZE));
+        }
+        size_t bytes = n * JOURNAL_RECORD_SIZE;
+        if (write(journal->fd, batch, bytes) != (ssize_t)bytes) {
+            // Cut a partial write back off; the caller retries the whole batch
+            off_t end = (off_t)(JOURNAL_HEADER_SIZE + journal->records * JOURNAL_RECORD_SIZE);
+            (void)ftruncate(journal->fd, end);
+            return false;
+        }
+        journal->records += n;
+        done += n;
+    }
+    return true;
+}
+
+bool SyncLeaderboardJournal(LeaderboardJournal *journal)
+{
+    if (!journal || journal->fd < 0) return false;
+    return fdatasync(journal->fd) == 0;
+}
+
+bool RefreshLeaderboardJournal(LeaderboardJournal *journal, const char *path,
+                               const char *snapshotPath)
+{
+    if (!journal || !path || !snapshotPath) return false;
+    struct stat current, named;
+    if (journal->fd >= 0 && fstat(journal->fd, &current) == 0 && stat(path, &named) == 0 &&
+        current.st_ino == named.st_ino && current.st_dev == named.st_dev &&
+        current.st_size >= (off_t)JOURNAL_HEADER_SIZE &&
+        (current.st_size - (off_t)JOURNAL_HEADER_SIZE) % JOURNAL_RECORD_SIZE == 0) {
+        journal->records =
+            (size_t)(current.st_size - (off_t)JOURNAL_HEADER_SIZE) / JOURNAL_RECORD_SIZE;
+        return true;
+    }
+    // Replaced, missing or ending in a torn record: open it afresh
+    CloseLeaderboardJournal(journal);
+    return OpenLeaderboardJournal(journal, path, snapshotPath);
+}
+
+bool CompactLeaderboardJournal(LeaderboardJournal *journal, const char *path,
+                               const char *snapshotPath)
+{
+    if (!journal || journal->fd < 0 || !path || !snapshotPath) return false;
+    size_t size = 0, records = 0, recordSize = 0;
+    const unsigned char *base = MapJournal(path, journal->generation, &size, &records, &recordSize);
+    if (!base) return false;
+
+    // New snapshot first: until the journal is reset it names the old
+    // generation, so a crash in between never replays records twice
+    uint32_t generation = 0;
+    bool ok = AppendBoardFile(snapshotPath, base + JOURNAL_HEADER_SIZE, records, recordSize,
+                              NULL, 0, &generation);
+    munmap((void *)(uintptr_t)base, size);
+    if (!ok) return false;
+    CloseLeaderboardJournal(journal);
+    return ResetJournal(journal, path, generation);
+}
+
+void CloseLeaderboardJournal(LeaderboardJournal *journal)
+{
+    if (!journal || journal->fd < 0) return;
+    close(journal->fd);
+    journal->fd = -1;
+}
+
+// Text format: "seconds;winner;initials[;timestamp]" per line, e.g.
+// "12.345;P;ABC;1767225600"; dumps from before timestamps have three fields.
+// Parsed straight from the mapped file: no per-line copies, no scanf and no
+// locale, so a decimal comma setting cannot change what a dump means.
+static const double powersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#define MAX_EXACT_POWER 22
+#define MAX_DECIMAL_EXPONENT 9999
+
+static bool IsBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// Case-insensitive match of a lowercase word at p
+static const char *MatchWord(const char *p, const char *end, const char *word)
+{
+    for (; *word != '\0'; ++p, ++word) {
+        if (p >= end || (char)(*p | 0x20) != *word) return NULL;
+    }
+    return p;
+}
+
+// Decimal number as scanf's %f takes it: optional sign, digits with an
+// optional point, optional exponent, or inf/infinity/nan. Digits past what
+// a 64-bit mantissa holds only move the exponent, far below float
+// precision. Returns the end of the number or NULL.
+static const char *ParseSeconds(const char *p, const char *end, float *out)
+{
+    while (p < end && IsBlank(*p)) p++;
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = *p == '-';
+        p++;
+    }
+    if (p < end && (*p == 'i' || *p == 'I' || *p == 'n' || *p == 'N')) {
+        const char *word = MatchWord(p, end, "infinity");
+        if (!word) word = MatchWord(p, end, "inf");
+        if (word) {
+            *out = negative ? -INFINITY : INFINITY;
+            return word;
+        }
+        word = MatchWord(p, end, "nan");
+        if (word) *out = negative ? -NAN : NAN;
+        return word;
+    }
+
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    bool any = false;
+    for (; p < end && IsDigit(*p); ++p, any = true) {
+        if (mantissa <= (UINT64_MAX - 9u) / 10u) {
+            mantissa = mantissa * 10u + (uint64_t)(*p - '0');
+        } else {
+            exponent++;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (++p; p < end && IsDigit(*p); ++p, any = true) {
+            if (mantissa <= (UINT64_MAX - 9u) / 10u) {
+                mantissa = mantissa * 10u + (uint64_t)(*p - '0');
+                exponent--;
             }
-            for (; j < 4; ++j) {
-                e->initials[j] = '\0';
+        }
+    }
+    if (!any) return NULL;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool negativeExponent = false;
+        if (q < end && (*q == '+' || *q == '-')) {
+            negativeExponent = *q == '-';
+            q++;
+        }
+        if (q < end && IsDigit(*q)) {
+            int value = 0;
+            for (; q < end && IsDigit(*q); ++q) {
+                if (value < MAX_DECIMAL_EXPONENT) value = value * 10 + (*q - '0');
             }
+            exponent += negativeExponent ? -value : value;
+            p = q;
         }
     }
-    fclose(fp);
 
-    // Ensure sorted
-    if (lb->count > 1) {
-        qsort(lb->entries, lb->count, sizeof(LeaderboardEntry), CompareEntries);
+    // One correctly rounded multiply or divide covers every time the game
+    // writes; longer exponents step through the table
+    double value = (double)mantissa;
+    while (value != 0.0 && exponent > MAX_EXACT_POWER && !isinf(value)) {
+        value *= powersOfTen[MAX_EXACT_POWER];
+        exponent -= MAX_EXACT_POWER;
+    }
+    while (value != 0.0 && exponent < -MAX_EXACT_POWER) {
+        value /= powersOfTen[MAX_EXACT_POWER];
+        exponent += MAX_EXACT_POWER;
+    }
+    if (value != 0.0 && exponent > 0 && exponent <= MAX_EXACT_POWER) value *= powersOfTen[exponent];
+    if (value != 0.0 && exponent < 0 && exponent >= -MAX_EXACT_POWER) value /= powersOfTen[-exponent];
+    float seconds = (value > (double)FLT_MAX) ? INFINITY : (float)value;
+    *out = negative ? -seconds : seconds;
+    return p;
+}
+
+// Unix seconds: digits only, up to INT64_MAX
+static const char *ParseTimestamp(const char *p, const char *end, int64_t *out)
+{
+    const char *start = p;
+    uint64_t value = 0;
+    for (; p < end && IsDigit(*p); ++p) {
+        uint64_t digit = (uint64_t)(*p - '0');
+        if (value > ((uint64_t)INT64_MAX - digit) / 10u) return NULL;
+        value = value * 10u + digit;
     }
+    if (p == start) return NULL;
+    *out = (int64_t)value;
+    return p;
 }
 
-void SaveLeaderboard(const Leaderboard *lb)
+static bool ParseTextLine(const char *p, const char *end, LeaderboardEntry *e)
 {
-    if (!lb) return;
-    EnsureDirExists();
-    const char *path = GetLeaderboardPath();
+    p = ParseSeconds(p, end, &e->seconds);
+    if (!p || end - p < 4 || p[0] != ';' || (p[1] != 'P' && p[1] != 'A') || p[2] != ';') {
+        return false;
+    }
+    e->winner = p[1];
+    p += 3;
+    while (p < end && IsBlank(*p)) p++;
+    const char *initials = p;
+    while (p < end && !IsBlank(*p) && *p != ';') p++;
+    size_t length = (size_t)(p - initials);
+    while (p < end && IsBlank(*p)) p++;
+    e->timestamp = 0;
+    if (length > 0 && p < end && *p == ';') {
+        p++;
+        while (p < end && IsBlank(*p)) p++;
+        p = ParseTimestamp(p, end, &e->timestamp);
+        if (!p) return false;
+        while (p < end && IsBlank(*p)) p++;
+    }
+    if (length == 0 || p != end) return false;
+
+    char copy[4] = {0};
+    memcpy(copy, initials, (length < 3) ? length : 3);
+    CopyInitials(e->initials, copy);
+    return true;
+}
+
+void ParseLeaderboardText(const char *text, size_t size, LeaderboardEntrySink sink, void *context,
+                          LeaderboardTextStats *stats)
+{
+    LeaderboardTextStats counts = {0};
+    const char *p = text;
+    const char *end = (text != NULL) ? text + size : text;
+    size_t lineNumber = 0;
+    while (p < end) {
+        const char *newline = memchr(p, '\n', (size_t)(end - p));
+        const char *lineEnd = newline ? newline : end;
+        lineNumber++;
+        while (p < lineEnd && IsBlank(*p)) p++;
+        if (p < lineEnd) {
+            counts.lines++;
+            LeaderboardEntry e;
+            if (ParseTextLine(p, lineEnd, &e)) {
+                counts.imported++;
+                if (sink) sink(context, &e);
+            } else if (counts.malformed++ == 0) {
+                counts.firstMalformed = lineNumber;
+            }
+        }
+        p = newline ? newline + 1 : end;
+    }
+    if (stats) *stats = counts;
+}
+
+static char *PutDecimal(char *p, unsigned long long value)
+{
+    char digits[24];
+    size_t n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10u);
+        value /= 10u;
+    } while (value > 0);
+    while (n > 0) *p++ = digits[--n];
+    return p;
+}
+
+size_t FormatLeaderboardLine(char *out, const LeaderboardEntry *e)
+{
+    char *p = out;
+    double seconds = (double)e->seconds;
+    if (isfinite(seconds) && fabs(seconds) < 1e15) {
+        // A float times 1000 is exact in a double, so rounding half to even
+        // here gives the digits printf's "%.3f" would
+        long long millis = llrint(seconds * 1000.0);
+        if (signbit(seconds)) *p++ = '-';
+        unsigned long long magnitude = (unsigned long long)((millis < 0) ? -millis : millis);
+        p = PutDecimal(p, magnitude / 1000u);
+        unsigned frac = (unsigned)(magnitude % 1000u);
+        *p++ = '.';
+        *p++ = (char)('0' + frac / 100u);
+        *p++ = (char)('0' + frac / 10u % 10u);
+        *p++ = (char)('0' + frac % 10u);
+    } else {
+        // inf, nan and absurd values: rare enough to leave to libc
+        // (room is left for the fields that follow, timestamp included)
+        p += snprintf(p, LEADERBOARD_TEXT_LINE_MAX - 32, "%0.3f", seconds);
+    }
+    *p++ = ';';
+    *p++ = e->winner;
+    *p++ = ';';
+    for (size_t i = 0; i < 3 && e->initials[i] != '\0'; ++i) *p++ = e->initials[i];
+    if (e->timestamp != 0) {
+        // Negative stamps cannot be read back; they only come from a bad clock
+        *p++ = ';';
+        p = PutDecimal(p, (e->timestamp > 0) ? (unsigned long long)e->timestamp : 0u);
+    }
+    *p++ = '\n';
+    return (size_t)(p - out);
+}
+
+static void InsertParsedEntry(void *context, const LeaderboardEntry *e)
+{
+    InsertEntry((Leaderboard *)context, e);
+}
+
+bool ImportLeaderboardText(Leaderboard *lb, const char *path, LeaderboardTextStats *stats)
+{
+    if (!lb || !path) return false;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t)st.st_size;
+    void *mapping = (size > 0) ? mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0) : NULL;
+    close(fd);
+    if (mapping == MAP_FAILED) return false;
+
+    ClearEntries(lb);
+    if (mapping) {
+        (void)posix_madvise(mapping, size, POSIX_MADV_SEQUENTIAL);
+        ParseLeaderboardText((const char *)mapping, size, InsertParsedEntry, lb, stats);
+        munmap(mapping, size);
+    } else {
+        ParseLeaderboardText(NULL, 0, NULL, NULL, stats);
+    }
+    lb->revision++;
+    return true;
+}
+
+bool ExportLeaderboardText(const Leaderboard *lb, const char *path)
+{
+    if (!lb || !path) return false;
     FILE *fp = fopen(path, "w");
-    if (!fp) return;
+    if (!fp) return false;
 
-    for (size_t i = 0; i < lb->count; ++i) {
-        const LeaderboardEntry *e = &lb->entries[i];
-        fprintf(fp, "%0.3f;%c;%s\n", (double)e->seconds, e->winner, e->initials);
+    // Lines are formatted into one buffer and written in large chunks
+    char buffer[LEADERBOARD_TEXT_CHUNK];
+    size_t used = 0;
+    bool ok = true;
+    ScoreCursor cursor;
+    const LeaderboardEntry *e = lb->index ? FirstScore(lb->index, &cursor) : NULL;
+    for (size_t i = 0; lb->index ? (e != NULL) : (i < lb->count); ++i) {
+        const LeaderboardEntry *row = lb->index ? e : &lb->entries[i];
+        if (used > sizeof(buffer) - LEADERBOARD_TEXT_LINE_MAX) {
+            ok = ok && fwrite(buffer, 1, used, fp) == used;
+            used = 0;
+        }
+        used += FormatLeaderboardLine(&buffer[used], row);
+        if (lb->index) e = NextScore(&cursor);
     }
-    fclose(fp);
+    ok = ok && fwrite(buffer, 1, used, fp) == used;
+    return (fclose(fp) == 0) && ok;
+}
+
+void LoadLeaderboard(Leaderboard *lb)
+{
+    if (!lb) return;
+    char journalPath[512];
+    snprintf(journalPath, sizeof(journalPath), "%s", GetLeaderboardFile(LEADERBOARD_JOURNAL_NAME));
+
+    uint32_t generation = 0;
+    bool loaded = LoadBoardFile(lb, GetLeaderboardFile(LEADERBOARD_BINARY_NAME), &generation);
+    // No (valid) binary board: carry over a board from the old text format
+    bool imported = !loaded &&
+                    ImportLeaderboardText(lb, GetLeaderboardFile(LEADERBOARD_TEXT_NAME), NULL);
+    if (!loaded && !imported) ClearEntries(lb);
+    ReplayJournal(lb, journalPath, generation);
+    // Convert an imported board right away; the new snapshot includes the
+    // journal, whose generation it retires
+    if (imported) SaveLeaderboard(lb);
+    lb->revision++;
+}
+
+void SaveLeaderboard(const Leaderboard *lb)
+{
+    if (!lb) return;
+    EnsureDirExists();
+    (void)SaveLeaderboardFile(lb, GetLeaderboardFile(LEADERBOARD_BINARY_NAME));
 }
 
 static void UppercaseInitials(char *dst3, const char *src)
@@ -120,32 +966,69 @@ static void UppercaseInitials(char *dst3, const char *src)
     dst3[3] = '\0';
 }
 
-void AddLeaderboardEntry(Leaderboard *lb, const char *initials, char winner, float seconds)
+bool GetLeaderboardSavePath(const char *name, char *path, size_t size)
+{
+    if (!name || !path || size == 0) return false;
+    EnsureDirExists();
+    int written = snprintf(path, size, "%s", GetLeaderboardFile(name));
+    return written > 0 && (size_t)written < size;
+}
+
+LeaderboardEntry AddLeaderboardEntry(Leaderboard *lb, const char *initials, char winner,
+                                     float seconds)
+{
+    return AddLeaderboardEntryAt(lb, initials, winner, seconds, (int64_t)time(NULL));
+}
+
+LeaderboardEntry AddLeaderboardEntryAt(Leaderboard *lb, const char *initials, char winner,
+                                       float seconds, int64_t timestamp)
 {
-    if (!lb) return;
     LeaderboardEntry e;
     UppercaseInitials(e.initials, initials ? initials : "   ");
     e.winner = (winner == 'A') ? 'A' : 'P';
     e.seconds = seconds;
+    e.timestamp = timestamp;
 
-    // Insert into array
-    if (lb->count < LEADERBOARD_MAX_ENTRIES) {
-        lb->entries[lb->count++] = e;
-    } else {
-        // Replace worst if current is better
-        size_t worst = 0;
-        for (size_t i = 1; i < lb->count; ++i) {
-            if (lb->entries[i].seconds > lb->entries[worst].seconds) worst = i;
-        }
-        if (e.seconds < lb->entries[worst].seconds) {
-            lb->entries[worst] = e;
-        } else {
-            // Not good enough to enter top list
-            return;
-        }
+    if (lb && InsertEntry(lb, &e)) {
+        lb->revision++;
     }
-    // Resort
-    if (lb->count > 1) {
-        qsort(lb->entries, lb->count, sizeof(LeaderboardEntry), CompareEntries);
+    return e;
+}
+
+void CreateLeaderboardWindows(Leaderboard *lb)
+{
+    if (!lb) return;
+    static const int64_t spans[LEADERBOARD_WINDOW_COUNT] = {
+        LEADERBOARD_DAY_SECONDS, LEADERBOARD_WEEK_SECONDS
+    };
+    for (int w = 0; w < LEADERBOARD_WINDOW_COUNT; ++w) {
+        if (!lb->windows[w]) lb->windows[w] = CreateScoreWindow(spans[w]);
+    }
+}
+
+void DestroyLeaderboardWindows(Leaderboard *lb)
+{
+    if (!lb) return;
+    for (int w = 0; w < LEADERBOARD_WINDOW_COUNT; ++w) {
+        DestroyScoreWindow(lb->windows[w]);
+        lb->windows[w] = NULL;
+    }
+}
+
+bool ExpireLeaderboardWindows(Leaderboard *lb, int64_t now)
+{
+    if (!lb) return false;
+    size_t expired = 0;
+    for (int w = 0; w < LEADERBOARD_WINDOW_COUNT; ++w) {
+        expired += ExpireScoreWindow(lb->windows[w], now);
     }
+    if (expired > 0) lb->revision++;
+    return expired > 0;
+}
+
+size_t CopyLeaderboardWindow(const Leaderboard *lb, LeaderboardWindow window,
+                             LeaderboardEntry *out, size_t k)
+{
+    if (!lb || !out || window < 0 || window >= LEADERBOARD_WINDOW_COUNT) return 0;
+    return CopyWindowTopScores(lb->windows[window], out, k);
 }
@@ -10,28 +10,155 @@
 #ifndef LEADERBOARD_H
 #define LEADERBOARD_H
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #define LEADERBOARD_MAX_ENTRIES 10
+#define LEADERBOARD_BINARY_NAME "leaderboard.bin"
+#define LEADERBOARD_JOURNAL_NAME "leaderboard.journal"
+#define LEADERBOARD_TEXT_NAME "leaderboard.txt"  // Legacy format, imported once
 
 typedef struct {
     char initials[4];
     char winner;   // 'P' for player, 'A' for AI
     float seconds; // time to win
+    int64_t timestamp;  // Unix time the result was recorded; 0 if unknown
 } LeaderboardEntry;
 
+// Rolling boards kept beside the all-time one
+typedef enum {
+    LEADERBOARD_TODAY,      // Last 24 hours
+    LEADERBOARD_THIS_WEEK,  // Last 7 days
+    LEADERBOARD_WINDOW_COUNT
+} LeaderboardWindow;
+
+#define LEADERBOARD_DAY_SECONDS 86400
+#define LEADERBOARD_WEEK_SECONDS (7 * LEADERBOARD_DAY_SECONDS)
+
+struct ScoreIndex;
+struct ScoreWindow;
+
 typedef struct {
-    LeaderboardEntry entries[LEADERBOARD_MAX_ENTRIES];
+    LeaderboardEntry entries[LEADERBOARD_MAX_ENTRIES];  // Fastest results, sorted
     size_t count;
+    unsigned int revision;  // Bumped whenever entries or a window change (for render caching)
+    struct ScoreIndex *index;  // Optional: every kept result (see scoreindex.h)
+    struct ScoreWindow *windows[LEADERBOARD_WINDOW_COUNT];  // Optional (see scorewindow.h)
 } Leaderboard;
 
-// Load leaderboard from persistent storage
+// Load leaderboard from persistent storage (~/.purple/leaderboard.bin plus
+// the journal appended since, falling back to importing leaderboard.txt)
 void LoadLeaderboard(Leaderboard *lb);
 
-// Save leaderboard to persistent storage
+// Save leaderboard to persistent storage (binary, atomically replaced)
 void SaveLeaderboard(const Leaderboard *lb);
 
-// Add an entry (keeps only fastest LEADERBOARD_MAX_ENTRIES, sorted ascending by time)
-void AddLeaderboardEntry(Leaderboard *lb, const char *initials, char winner, float seconds);
+// Binary board: fixed records with header and checksum, mapped on load and
+// written via temp file + fsync + rename. Every indexed result is written.
+// Load leaves lb untouched and returns false for a missing, truncated or
+// corrupt file.
+bool LoadLeaderboardFile(Leaderboard *lb, const char *path);
+bool SaveLeaderboardFile(const Leaderboard *lb, const char *path);
+
+// Rewrite path as its current records followed by entries, without loading
+// them into a board (a missing or corrupt file counts as empty)
+bool AppendLeaderboardFile(const char *path, const LeaderboardEntry *entries, size_t count);
+
+// Snapshot at path plus the journal records that follow its generation.
+// Returns false if neither holds anything.
+bool LoadLeaderboardJournaled(Leaderboard *lb, const char *path, const char *journalPath);
+
+// Append-only journal of new results. Each fixed record carries its own
+// checksum, so a torn last write is dropped. A journal belongs to the
+// snapshot generation it was started on; every snapshot rewrite bumps the
+// generation, so records are never replayed on top of a snapshot that
+// already holds them.
+typedef struct {
+    int fd;
+    uint32_t generation;  // Snapshot generation the records follow
+    size_t records;       // Valid records in the journal
+} LeaderboardJournal;
+
+// Open for appending after snapshotPath: keep the valid records if the
+// generations match, otherwise start an empty journal
+bool OpenLeaderboardJournal(LeaderboardJournal *journal, const char *path, const char *snapshotPath);
+bool AppendLeaderboardJournal(LeaderboardJournal *journal, const LeaderboardEntry *entries,
+                              size_t count);
+bool SyncLeaderboardJournal(LeaderboardJournal *journal);
+
+// Catch up with other processes appending to the same journal (call with
+// their writes excluded, e.g. under a shared lock): take on its current
+// length, or reopen it if it was replaced by a compaction
+bool RefreshLeaderboardJournal(LeaderboardJournal *journal, const char *path,
+                               const char *snapshotPath);
+
+// Fold the journal into a new snapshot generation and restart it empty
+bool CompactLeaderboardJournal(LeaderboardJournal *journal, const char *path,
+                               const char *snapshotPath);
+void CloseLeaderboardJournal(LeaderboardJournal *journal);
+
+// Resolve a file name under ~/.purple into path, creating the directory.
+// Uses the same static buffers as Load/SaveLeaderboard.
+bool GetLeaderboardSavePath(const char *name, char *path, size_t size);
+
+// Text format ("seconds;winner;initials[;timestamp]" per line, the
+// timestamp written only when known) for import and export.
+// Import maps the file and parses it in place; stats may be NULL. Lines
+// that do not parse are counted and skipped rather than failing the import.
+typedef struct {
+    size_t lines;           // Non-blank lines seen
+    size_t imported;
+    size_t malformed;
+    size_t firstMalformed;  // 1-based line number, 0 if none
+} LeaderboardTextStats;
+
+typedef void (*LeaderboardEntrySink)(void *context, const LeaderboardEntry *e);
+
+bool ImportLeaderboardText(Leaderboard *lb, const char *path, LeaderboardTextStats *stats);
+bool ExportLeaderboardText(const Leaderboard *lb, const char *path);
+
+// Streaming parser behind the import: text need not be NUL terminated, and
+// sink (may be NULL) gets each good line. Locale independent.
+void ParseLeaderboardText(const char *text, size_t size, LeaderboardEntrySink sink, void *context,
+                          LeaderboardTextStats *stats);
+
+// Write e as one text line, newline included and unterminated; returns the
+// length, at most LEADERBOARD_TEXT_LINE_MAX
+#define LEADERBOARD_TEXT_LINE_MAX 96
+size_t FormatLeaderboardLine(char *out, const LeaderboardEntry *e);
+
+// Add an entry stamped with the current time. entries[] keeps the fastest
+// LEADERBOARD_MAX_ENTRIES sorted ascending by time; with an index attached,
+// every result is kept there too (up to the index capacity) at O(log n) per
+// insert, and every attached window takes it in the same call. Returns the
+// entry as recorded (initials uppercased and padded), e.g. for queueing a save.
+LeaderboardEntry AddLeaderboardEntry(Leaderboard *lb, const char *initials, char winner,
+                                     float seconds);
+
+// As AddLeaderboardEntry with a given timestamp (0 keeps it out of the windows)
+LeaderboardEntry AddLeaderboardEntryAt(Leaderboard *lb, const char *initials, char winner,
+                                       float seconds, int64_t timestamp);
+
+// Attach a window per LeaderboardWindow (best effort: a window that cannot
+// be allocated stays NULL and shows nothing), and free them again
+void CreateLeaderboardWindows(Leaderboard *lb);
+void DestroyLeaderboardWindows(Leaderboard *lb);
+
+// Evict results that have aged out of the windows as of now (Unix time).
+// Cheap when nothing expires; bumps revision and returns true otherwise.
+bool ExpireLeaderboardWindows(Leaderboard *lb, int64_t now);
+
+// Copy up to k fastest results of a window in O(k); 0 without that window
+size_t CopyLeaderboardWindow(const Leaderboard *lb, LeaderboardWindow window,
+                             LeaderboardEntry *out, size_t k);
+
+// Results held: the index size when one is attached, else count
+size_t LeaderboardTotal(const Leaderboard *lb);
+
+// 1-based place a time would take (equal times share a place) and the
+// result held at a given place. O(log n) with an index attached.
+size_t LeaderboardRank(const Leaderboard *lb, float seconds);
+bool LeaderboardEntryAtRank(const Leaderboard *lb, size_t rank, LeaderboardEntry *out);
 
 #endif // LEADERBOARD_H
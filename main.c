@@ -8,13 +8,28 @@
 ========================================================================= */
 
 #include <raylib/raylib.h>
+#include <raylib/rlgl.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include "ball.h"
 #include "paddle.h"
 #include "resource.h"
 #include "leaderboard.h"
+#include "textcache.h"
+#include "hud.h"
+#include "profiler.h"
+#include "input.h"
+#include "pacer.h"
+#include "fontcache.h"
+#include "startup.h"
+#include "scoreindex.h"
+#include "boardwriter.h"
+#include "playerstats.h"
+#include "sharedboard.h"
+#include "matchhistory.h"
 
 #define SCREEN_WIDTH 1200
 #define SCREEN_HEIGHT 600
@@ -32,6 +47,42 @@
 #define SCORE_FONT_SIZE 28
 #define MESSAGE_FONT_SIZE 24
 #define GAME_OVER_FONT_SIZE 40
+#define LEADERBOARD_Y 120
+#define LEADERBOARD_ROW_HEIGHT 30
+#define PROFILE_Y (SCREEN_HEIGHT - 125)
+#define MATCH_HISTORY_Y (SCREEN_HEIGHT - 160)
+#define FPS_FONT_SIZE 20
+#ifndef DEFAULT_TARGET_FPS
+#define DEFAULT_TARGET_FPS 60  // Override with -DDEFAULT_TARGET_FPS=N (0 = unpaced)
+#endif
+#define DEFAULT_LEADERBOARD_HISTORY 1000000  // Results kept across sessions (--history)
+#define IDLE_REFRESH_SECONDS 1.0  // Still screens redraw at least this often
+#define ATTRACT_BOARD_SECONDS 5.0  // Start screen shows each board this long in turn
+#define ATTRACT_BOARD_COUNT (1 + LEADERBOARD_WINDOW_COUNT)  // All time, then each window
+#define IDLE_POLL_FPS 60          // Event polling rate while skipping frames unpaced
+#define HIDDEN_POLL_FPS 10        // Event polling rate while minimized on a still screen
+#define PROFILER_REFRESH_FRAMES 15  // Overlay text/histogram refresh period
+#define PROFILER_X 10
+#define PROFILER_Y 40
+#define PROFILER_BAR_WIDTH 8
+#define PROFILER_BAR_HEIGHT 60
+
+typedef struct {
+    char lines[FRAME_PHASE_COUNT][64];
+    char pacerLine[96];
+    unsigned int buckets[PROFILER_HISTOGRAM_BUCKETS];
+    unsigned int maxBucket;
+    int framesUntilRefresh;
+} ProfilerOverlay;
+
+// The start screen's 30-day median, recomputed only when the history or the
+// day changes rather than on every attract board rotation
+typedef struct {
+    bool valid;
+    unsigned int revision;
+    int64_t day;
+    char line[96];  // Empty when no match falls in the window
+} MonthMedian;
 
 typedef enum {
     START_SCREEN,
@@ -64,20 +115,355 @@ static void DrawPaddle(Paddle *paddle, Color colour)
 
 static void DrawCenteredText(Font font, const char *text, int y, int fontSize, Color colour)
 {
-    Vector2 textSize = MeasureTextEx(font, text, (float)fontSize, 1);
-    float x = (SCREEN_WIDTH - textSize.x) / 2.0f;
-    DrawTextEx(font, text, (Vector2){x, (float)y}, (float)fontSize, 1, colour);
+    // Static labels hit the layout cache, so measuring and glyph lookup happen once
+    const TextRun *run = GetTextRun(font, text, (float)fontSize, 1);
+    if (run == NULL) {
+        Vector2 textSize = MeasureTextEx(font, text, (float)fontSize, 1);
+        float x = (SCREEN_WIDTH - textSize.x) / 2.0f;
+        DrawTextEx(font, text, (Vector2){x, (float)y}, (float)fontSize, 1, colour);
+        return;
+    }
+    float x = (SCREEN_WIDTH - run->size.x) / 2.0f;
+    DrawTextRun(font, run, (Vector2){x, (float)y}, colour);
+}
+
+// Digits grouped in thousands: 1234567 -> "1,234,567"
+static void FormatCount(char *out, size_t size, size_t value)
+{
+    char digits[32];
+    int length = snprintf(digits, sizeof(digits), "%zu", value);
+    size_t o = 0;
+    for (int i = 0; i < length && o + 1 < size; ++i) {
+        if (i > 0 && (length - i) % 3 == 0 && o + 2 < size) out[o++] = ',';
+        out[o++] = digits[i];
+    }
+    out[o] = '\0';
+}
+
+// Record a result and hand the save to the writer thread. Saves inline only
+// if the writer is not running: a full rewrite behind its back would retire
+// the journal it appends to; the history log for those saves stays open
+// across results. loser may be NULL when nobody is known. match holds the
+// scores, rallies and seed; its time, length and winner come from the entry.
+static void RecordResult(Leaderboard *leaderboard, PlayerStatsStore *players,
+                         MatchHistory *history, MatchHistoryLog *historyLog, BoardWriter *writer,
+                         const char *initials, const char *loser, char winner, float seconds,
+                         MatchRecord *match)
+{
+    LeaderboardEntry entry = AddLeaderboardEntry(leaderboard, initials, winner, seconds);
+    RecordMatchResult(players, entry.initials, loser, seconds);
+    match->timestamp = entry.timestamp;
+    match->seconds = entry.seconds;
+    match->winner = entry.winner;
+    AppendMatchHistory(history, match);
+    if (!writer->threaded) {
+        char path[BOARD_WRITER_MAX_PATH];
+        SaveLeaderboard(leaderboard);
+        if (GetLeaderboardSavePath(PLAYER_STATS_NAME, path, sizeof(path))) {
+            SavePlayerStats(players, path);
+        }
+        // Refresh opens the log the first time and afterwards only looks
+        // at what changed
+        if (GetLeaderboardSavePath(MATCH_HISTORY_NAME, path, sizeof(path)) &&
+            RefreshMatchHistoryLog(historyLog, path)) {
+            AppendMatchHistoryLog(historyLog, path, match, 1);
+            SyncMatchHistoryLog(historyLog);
+        }
+    } else if (!QueueBoardEntry(writer, &entry, loser, match)) {
+        TraceLog(LOG_WARNING, "LEADERBOARD: Save queue full, result not saved");
+    }
+}
+
+static void DrawCenterLine(void)
+{
+    for (int i = 0; i < SCREEN_HEIGHT; i += CENTER_LINE_SEGMENT) {
+        DrawLineV((Vector2){ SCREEN_WIDTH / 2.0f, (float)i },
+                  (Vector2){ SCREEN_WIDTH / 2.0f, (float)(i + CENTER_LINE_GAP) }, LIGHTGRAY);
+    }
+}
+
+// Layers are full-screen render textures of content that rarely changes.
+// Alpha uses "over" blending so they stay opaque and composite as one quad.
+static void BeginLayer(RenderTexture2D layer)
+{
+    BeginTextureMode(layer);
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA,
+                              RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+}
+
+static void EndLayer(void)
+{
+    EndBlendMode();
+    EndTextureMode();
+}
+
+static void DrawLayer(RenderTexture2D layer)
+{
+    // Render textures are stored upside down, hence the negative height
+    DrawTextureRec(layer.texture,
+                   (Rectangle){ 0.0f, 0.0f, (float)SCREEN_WIDTH, -(float)SCREEN_HEIGHT },
+                   (Vector2){ 0.0f, 0.0f }, WHITE);
+}
+
+// Background, center line and title: baked once at startup
+static void RenderPlayfieldLayer(RenderTexture2D layer, Font font, Shader textShader)
+{
+    BeginLayer(layer);
+    ClearBackground(RAYWHITE);
+    DrawCenterLine();
+    BeginShaderMode(textShader);
+    DrawCenteredText(font, "PONG", 10, TITLE_FONT_SIZE, DARKGRAY);
+    EndShaderMode();
+    EndLayer();
 }
 
-int main(void)
+static const char *GetMonthMedianLine(MonthMedian *cache, const MatchHistory *history)
 {
+    int64_t now = (int64_t)time(NULL);
+    int64_t day = now / LEADERBOARD_DAY_SECONDS;
+    if (cache->valid && cache->revision == history->revision && cache->day == day) {
+        return cache->line;
+    }
+    cache->valid = true;
+    cache->revision = history->revision;
+    cache->day = day;
+    cache->line[0] = '\0';
+    MatchFilter month = { .from = now - MATCH_HISTORY_MONTH_SECONDS, .to = INT64_MAX };
+    MatchQueryStats stats;
+    float median = 0.0f;
+    if (MatchHistoryPercentile(history, &month, 0.5, &median, &stats)) {
+        snprintf(cache->line, sizeof(cache->line), "Median match, last 30 days: %.3fs over %zu",
+                 (double)median, stats.matches);
+    }
+    return cache->line;
+}
+
+// Whole start screen on top of the playfield; re-rendered only when the
+// leaderboard, player stats or match history change, or the board shown does. Board 0 is
+// all time, the rest the leaderboard's windows (O(K) copies of their tops).
+// Records come from hash lookups, so the cost does not grow with history;
+// medianLine comes from the MonthMedian cache.
+static void RenderAttractLayer(RenderTexture2D layer, RenderTexture2D playfield,
+                               Font font, Shader textShader, const Leaderboard *lb,
+                               const PlayerStatsStore *players, const char *medianLine,
+                               const char *lastPlayer, int board)
+{
+    static const char *titles[ATTRACT_BOARD_COUNT] = {
+        "Fastest Wins", "Fastest Today", "Fastest This Week"
+    };
+    LeaderboardEntry windowRows[LEADERBOARD_MAX_ENTRIES];
+    const LeaderboardEntry *rows = lb->entries;
+    size_t count = lb->count;
+    if (board > 0) {
+        count = CopyLeaderboardWindow(lb, (LeaderboardWindow)(board - 1), windowRows,
+                                      LEADERBOARD_MAX_ENTRIES);
+        rows = windowRows;
+    }
+
+    BeginLayer(layer);
+    DrawLayer(playfield);
+    BeginShaderMode(textShader);
+    DrawCenteredText(font, titles[board], 80, SCORE_FONT_SIZE, DARKGRAY);
+    if (count == 0 && board > 0) {
+        DrawCenteredText(font, "No wins yet", LEADERBOARD_Y, MESSAGE_FONT_SIZE, GRAY);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        const LeaderboardEntry *e = &rows[i];
+        const PlayerStats *stats = FindPlayerStats(players, e->initials);
+        char line[128];
+        snprintf(line, sizeof(line), "%2zu. %6.3fs  %c  %.3s  %4uW %4uL",
+                 i + 1, (double)e->seconds, e->winner, e->initials,
+                 (stats != NULL) ? (unsigned)stats->wins : 0u,
+                 (stats != NULL) ? (unsigned)stats->losses : 0u);
+        DrawCenteredText(font, line, LEADERBOARD_Y + (int)i * LEADERBOARD_ROW_HEIGHT,
+                         MESSAGE_FONT_SIZE, BLACK);
+    }
+    // Profile of whoever last entered initials
+    const PlayerStats *profile = FindPlayerStats(players, lastPlayer);
+    if (profile != NULL) {
+        char line[160];
+        snprintf(line, sizeof(line), "%s  %uW %uL  best %.3fs  avg %.3fs  streak %u (best %u)",
+                 profile->initials, (unsigned)profile->wins, (unsigned)profile->losses,
+                 (double)profile->bestSeconds, (double)PlayerMeanSeconds(profile),
+                 (unsigned)profile->streak, (unsigned)profile->bestStreak);
+        DrawCenteredText(font, line, PROFILE_Y, MESSAGE_FONT_SIZE, PURPLE);
+    }
+    if (medianLine[0] != '\0') {
+        DrawCenteredText(font, medianLine, MATCH_HISTORY_Y, MESSAGE_FONT_SIZE, DARKGRAY);
+    }
+    DrawCenteredText(font, "Press SPACE to play",
+                     SCREEN_HEIGHT - 80, MESSAGE_FONT_SIZE, DARKGRAY);
+    EndShaderMode();
+    EndLayer();
+}
+
+// Sorting and formatting only happen while the overlay is shown, a few times a second
+static void RefreshProfilerOverlay(ProfilerOverlay *overlay, const FrameProfiler *profiler,
+                                   const PacerStats *pacing)
+{
+    static const char *names[FRAME_PHASE_COUNT] = {
+        "input", "physics", "draw", "present", "frame", "latency", "pacing"
+    };
+    float samples[PROFILER_HISTORY];
+
+    if (--overlay->framesUntilRefresh > 0) return;
+    overlay->framesUntilRefresh = PROFILER_REFRESH_FRAMES;
+
+    for (int phase = 0; phase < FRAME_PHASE_COUNT; ++phase) {
+        size_t count = GetFramePhaseSamples(profiler, (FramePhase)phase,
+                                            samples, PROFILER_HISTORY);
+        if (phase == FRAME_PHASE_TOTAL) {
+            BuildFrameHistogram(samples, count, overlay->buckets);
+        }
+        FrameStats stats;
+        ComputeFrameStats(samples, count, &stats);
+        snprintf(overlay->lines[phase], sizeof(overlay->lines[phase]),
+                 "%-8s p50 %6.2f  p99 %6.2f  max %6.2f ms", names[phase],
+                 (double)stats.p50, (double)stats.p99, (double)stats.max);
+    }
+    char summary[80];
+    FormatPacerStats(pacing, summary, sizeof(summary));
+    snprintf(overlay->pacerLine, sizeof(overlay->pacerLine), "%-8s %s", "pacer", summary);
+
+    overlay->maxBucket = 1;
+    for (int i = 0; i < PROFILER_HISTOGRAM_BUCKETS; ++i) {
+        if (overlay->buckets[i] > overlay->maxBucket) overlay->maxBucket = overlay->buckets[i];
+    }
+}
+
+static void DrawProfilerOverlay(const ProfilerOverlay *overlay)
+{
+    int width = PROFILER_HISTOGRAM_BUCKETS * PROFILER_BAR_WIDTH;
+    int rows = FRAME_PHASE_COUNT + 1;  // Phases, then the pacer summary
+    int height = rows * 12 + PROFILER_BAR_HEIGHT + 16;
+    DrawRectangle(PROFILER_X - 4, PROFILER_Y - 4, width + 180, height, (Color){ 0, 0, 0, 180 });
+
+    for (int phase = 0; phase < FRAME_PHASE_COUNT; ++phase) {
+        DrawText(overlay->lines[phase], PROFILER_X, PROFILER_Y + phase * 12, 10, RAYWHITE);
+    }
+    DrawText(overlay->pacerLine, PROFILER_X, PROFILER_Y + FRAME_PHASE_COUNT * 12, 10, RAYWHITE);
+
+    // Frame time histogram, one bar per PROFILER_BUCKET_MS
+    int baseY = PROFILER_Y + rows * 12 + 4 + PROFILER_BAR_HEIGHT;
+    for (int i = 0; i < PROFILER_HISTOGRAM_BUCKETS; ++i) {
+        int bar = (int)((overlay->buckets[i] * PROFILER_BAR_HEIGHT) / overlay->maxBucket);
+        // Green within a 60 Hz frame, red for the open-ended last bucket
+        Color colour = (i < 17) ? LIME : (i < PROFILER_HISTOGRAM_BUCKETS - 1) ? ORANGE : RED;
+        DrawRectangle(PROFILER_X + i * PROFILER_BAR_WIDTH, baseY - bar,
+                      PROFILER_BAR_WIDTH - 1, bar, colour);
+    }
+}
+
+static void PrintUsage(const char *program)
+{
+    printf("Usage: %s [options]\n", program);
+    printf("  --low-latency     Sleep first, then sample input just before simulating\n");
+    printf("  --fps N           Target frame rate, 0 for unpaced (default %d)\n",
+           DEFAULT_TARGET_FPS);
+    printf("  --vsync           Sync buffer swaps to the display refresh\n");
+    printf("  --always-redraw   Render every frame even when nothing changed\n");
+    printf("  --history N       Results kept on the leaderboard, 0 for all (default %d)\n",
+           DEFAULT_LEADERBOARD_HISTORY);
+    printf("  --journal-sync M  Leaderboard journal sync: every, interval or never (default every)\n");
+}
+
+static bool ParseHistory(const char *text, size_t *history)
+{
+    char *end = NULL;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || text[0] == '-' || parsed > SIZE_MAX) return false;
+    *history = (size_t)parsed;
+    return true;
+}
+
+static bool ParseSyncPolicy(const char *text, BoardSyncPolicy *policy)
+{
+    if (strcmp(text, "every") == 0) {
+        *policy = BOARD_SYNC_EVERY_WRITE;
+    } else if (strcmp(text, "interval") == 0) {
+        *policy = BOARD_SYNC_INTERVAL;
+    } else if (strcmp(text, "never") == 0) {
+        *policy = BOARD_SYNC_NEVER;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool ParseFps(const char *text, int *fps)
+{
+    char *end = NULL;
+    long parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || parsed < 0 || parsed > 1000) return false;
+    *fps = (int)parsed;
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    bool lowLatency = false;
+    bool vsync = false;
+    bool alwaysRedraw = false;
+    int targetFps = DEFAULT_TARGET_FPS;
+    size_t history = DEFAULT_LEADERBOARD_HISTORY;
+    BoardWriterConfig boardConfig = DefaultBoardWriterConfig();
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--low-latency") == 0) {
+            lowLatency = true;
+        } else if (strcmp(argv[i], "--vsync") == 0) {
+            vsync = true;
+        } else if (strcmp(argv[i], "--always-redraw") == 0) {
+            alwaysRedraw = true;
+        } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc &&
+                   ParseFps(argv[i + 1], &targetFps)) {
+            i++;
+        } else if (strcmp(argv[i], "--history") == 0 && i + 1 < argc &&
+                   ParseHistory(argv[i + 1], &history)) {
+            i++;
+        } else if (strcmp(argv[i], "--journal-sync") == 0 && i + 1 < argc &&
+                   ParseSyncPolicy(argv[i + 1], &boardConfig.sync)) {
+            i++;
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
     // Initialization
     srand((unsigned int)time(NULL));  // Seed random number generator
+
+    // Read and bake the font (embedded in the executable when built with
+    // PURPLE_EMBED_ASSETS, otherwise found on disk) and parse the leaderboard
+    // on worker threads while the window and GL context come up. The baked
+    // atlas is cached in ~/.purple so later launches skip TTF rasterization.
+    // Other instances on this host share the board through a mapped file;
+    // without it this instance simply keeps to itself
+    size_t fontDataSize = 0;
+    const unsigned char *fontData = FindFontData(&fontDataSize);
+    SharedBoard sharedBoard;
+    OpenSharedBoard(&sharedBoard, NULL);
+    StartupLoader startup;
+    StartStartupLoader(&startup, fontData, (int)fontDataSize,
+                       (fontData != NULL) ? NULL : FindFontPath(), FONT_SDF_BASE_SIZE, FONT_SDF,
+                       history, &sharedBoard);
+
+    if (vsync) SetConfigFlags(FLAG_VSYNC_HINT);
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Purple - Pong");
-    SetTargetFPS(60);
+    SetTargetFPS(0);  // The frame pacer below replaces raylib's sleep
+
+    // With vsync the swap already blocks each refresh; pace on top of it only
+    // to wake late, anchored to the refresh the swap returned on
+    if (vsync) {
+        int refresh = GetMonitorRefreshRate(GetCurrentMonitor());
+        targetFps = lowLatency ? ((refresh > 0) ? refresh : targetFps) : 0;
+    }
+    FramePacer pacer;
+    InitFramePacer(&pacer, targetFps, lowLatency);
 
-    // Load custom font from multiple possible locations
-    Font orbitronFont = LoadFontEx(FindFontPath(), 32, 0, 0);
+    // A single distance-field atlas stays sharp at every size from 24 to 48 px
+    Font orbitronFont = JoinStartupFont(&startup);
+    Shader textShader = LoadSdfTextShader();
 
     // Initialize ball
     Ball ball = {
@@ -110,26 +496,105 @@ int main(void)
     double gameStartTime = 0.0;
     float lastGameSeconds = 0.0f;
 
-    Leaderboard leaderboard;
-    LoadLeaderboard(&leaderboard);
+    Leaderboard leaderboard = {0};
+    PlayerStatsStore players = {0};
+    MatchHistory matchHistory = {0};
+    JoinStartupLeaderboard(&startup, &leaderboard, &players, &matchHistory);
+    // Saves from here on go through a background thread
+    BoardWriter boardWriter;
+    StartBoardWriter(&boardWriter, NULL, NULL, NULL, NULL, &sharedBoard, &boardConfig);
+    // Each match reseeds from a counter so the history can replay its serve
+    // directions; consecutive seeds also compress to a byte. The counter starts
+    // from the seeded generator, so a headless run's seed carries through.
+    uint32_t matchSeed = (uint32_t)rand();
+    uint32_t rallies = 0;
+    MatchHistoryLog historyLog = { .blocksFd = -1, .tailFd = -1 };  // Saves without the writer
+    MonthMedian monthMedian = {0};
+
+    // Static layers: the playfield never changes, the attract screen only
+    // when the leaderboard revision does
+    RenderTexture2D playfieldLayer = LoadRenderTexture(SCREEN_WIDTH, SCREEN_HEIGHT);
+    RenderTexture2D attractLayer = LoadRenderTexture(SCREEN_WIDTH, SCREEN_HEIGHT);
+    RenderPlayfieldLayer(playfieldLayer, orbitronFont, textShader);
+    unsigned int attractRevision =
+        leaderboard.revision + players.revision + matchHistory.revision - 1u;
+    int attractBoard = 0;
 
     char initials[4] = {' ', ' ', ' ', '\0'};
     int initialsCount = 0;
+    // Whoever entered initials last; their profile shows on the start screen
+    char lastPlayer[4] = "";
+
+    // Dynamic HUD text is rebuilt only when the value behind it changes
+    HudLabel playerScoreLabel, aiScoreLabel, promptLabel, fpsLabel;
+    InitHudLabel(&playerScoreLabel, orbitronFont, SCORE_FONT_SIZE, 1);
+    InitHudLabel(&aiScoreLabel, orbitronFont, SCORE_FONT_SIZE, 1);
+    InitHudLabel(&promptLabel, orbitronFont, GAME_OVER_FONT_SIZE - 8, 1);
+    HudLabel placeLabel;
+    InitHudLabel(&placeLabel, orbitronFont, MESSAGE_FONT_SIZE, 1);
+    InitHudLabel(&fpsLabel, GetFontDefault(), FPS_FONT_SIZE, FPS_FONT_SIZE / 10.0f);
     
     // Set initial ball velocity using multiplier
     ResetBall(&ball, SCREEN_WIDTH, SCREEN_HEIGHT, ballSpeedMultiplier);
 
+    // Frame timing runs always; F3 toggles the overlay
+    static FrameProfiler profiler;
+    ProfilerOverlay profilerOverlay = {0};
+
+    // Input gathered by every poll since the last update
+    InputFrame input = {0};
+    AccumulateInput(&input);
+
+    // Still screens (start, initials) are only redrawn when something changed
+    GameState drawnState = gameState;
+    double lastDrawTime = -IDLE_REFRESH_SECONDS;
+    bool wasFocused = true;
+    bool startupReported = false;  // Time to first frame is logged once
+
     // Main game loop
     while (!WindowShouldClose())
     {
+        BeginFrameProfile(&profiler);
+        if (pacer.periodNs > 0) {
+            // Sleep first, then poll, so the frame sees the freshest input.
+            // Low-latency mode wakes just early enough to finish by the deadline.
+            RecordPacingError(&profiler, WaitForFrameDeadline(&pacer));
+            MarkFramePhase(&profiler, FRAME_PHASE_PRESENT);
+
+            PollInputEvents();
+            AccumulateInput(&input);
+        }
+        uint64_t workStart = ProfilerNow();
+
+        // Results other instances saved since the last frame; already on
+        // disk, so they only join the in-memory board and stats
+        BoardResult incoming[SHARED_BOARD_POLL_MAX];
+        size_t incomingCount = PollSharedBoard(&sharedBoard, incoming, SHARED_BOARD_POLL_MAX);
+        for (size_t i = 0; i < incomingCount; ++i) {
+            const LeaderboardEntry *e = &incoming[i].entry;
+            AddLeaderboardEntryAt(&leaderboard, e->initials, e->winner, e->seconds, e->timestamp);
+            RecordMatchResult(&players, e->initials, incoming[i].loser, e->seconds);
+        }
+        // Rolling boards drop results as they age out, not only on inserts
+        ExpireLeaderboardWindows(&leaderboard, (int64_t)time(NULL));
+        int shownBoard = (int)(GetTime() / ATTRACT_BOARD_SECONDS) % ATTRACT_BOARD_COUNT;
+
+        if (IsInputPressed(&input, INPUT_TOGGLE_PROFILER)) {
+            profiler.visible = !profiler.visible;
+            profilerOverlay.framesUntilRefresh = 0;
+        }
+
         // Update
+        GameState updateState = gameState;
         if (gameState == START_SCREEN)
         {
-            if (IsKeyPressed(KEY_SPACE)) {
+            if (IsInputPressed(&input, INPUT_SPACE)) {
                 // Reset scores and positions for new game
                 player.score = 0;
                 ai.score = 0;
                 ballSpeedMultiplier = 1.0f;
+                srand(++matchSeed);
+                rallies = 0;
                 ResetBall(&ball, SCREEN_WIDTH, SCREEN_HEIGHT, ballSpeedMultiplier);
                 player.position.y = (float)(SCREEN_HEIGHT - PADDLE_HEIGHT) / 2.0f;
                 ai.position.y = (float)(SCREEN_HEIGHT - PADDLE_HEIGHT) / 2.0f;
@@ -140,22 +605,25 @@ int main(void)
         else if (gameState == PLAYING)
         {
             // Player input
-            if (IsKeyDown(KEY_UP)) {
+            if (IsInputDown(&input, INPUT_UP)) {
                 MovePaddleUp(&player);
-            } else if (IsKeyDown(KEY_DOWN)) {
+            } else if (IsInputDown(&input, INPUT_DOWN)) {
                 MovePaddleDown(&player);
             } else {
                 StopPaddle(&player);
             }
+            MarkFramePhase(&profiler, FRAME_PHASE_INPUT);
 
             // Update positions
             UpdatePaddlePosition(&player, SCREEN_HEIGHT);
             UpdateAIPaddle(&ai, ball.position, ball.radius, SCREEN_HEIGHT);
             UpdateBallPosition(&ball);
 
-            // Handle paddle collisions
+            // Handle paddle collisions; a hit always flips the horizontal direction
+            float velocityBefore = ball.velocity.x;
             HandlePaddleCollision(&ball, player.position, PADDLE_WIDTH, PADDLE_HEIGHT);
             HandlePaddleCollision(&ball, ai.position, PADDLE_WIDTH, PADDLE_HEIGHT);
+            if ((velocityBefore < 0.0f) != (ball.velocity.x < 0.0f)) rallies++;
 
             // Handle top/bottom wall collisions
             if (IsCollidingVertical(&ball, SCREEN_HEIGHT)) {
@@ -169,9 +637,12 @@ int main(void)
                 ballSpeedMultiplier = CalculateSpeedMultiplier(ai.score + player.score);
                 if (ai.score >= POINTS_TO_WIN) {
                     lastGameSeconds = (float)(GetTime() - gameStartTime);
-                    // Save AI win automatically
-                    AddLeaderboardEntry(&leaderboard, "AI", 'A', lastGameSeconds);
-                    SaveLeaderboard(&leaderboard);
+                    // Save AI win automatically; without initials nobody takes the loss
+                    MatchRecord match = { .playerScore = (uint8_t)player.score,
+                                          .aiScore = (uint8_t)ai.score,
+                                          .rallies = rallies, .seed = matchSeed };
+                    RecordResult(&leaderboard, &players, &matchHistory, &historyLog,
+                                 &boardWriter, "AI", NULL, 'A', lastGameSeconds, &match);
                     gameState = START_SCREEN;
                 } else {
                     ResetBall(&ball, SCREEN_WIDTH, SCREEN_HEIGHT, ballSpeedMultiplier);
@@ -182,6 +653,12 @@ int main(void)
                 ballSpeedMultiplier = CalculateSpeedMultiplier(ai.score + player.score);
                 if (player.score >= POINTS_TO_WIN) {
                     lastGameSeconds = (float)(GetTime() - gameStartTime);
+                    // Place among every result on record, counting this one
+                    char place[24], total[24], text[HUD_LABEL_MAX_TEXT];
+                    FormatCount(place, sizeof(place), LeaderboardRank(&leaderboard, lastGameSeconds));
+                    FormatCount(total, sizeof(total), LeaderboardTotal(&leaderboard) + 1);
+                    snprintf(text, sizeof(text), "You placed #%s of %s", place, total);
+                    SetHudLabel(&placeLabel, 0, text);
                     // Move to initials entry state
                     initials[0] = initials[1] = initials[2] = ' ';
                     initials[3] = '\0';
@@ -195,7 +672,7 @@ int main(void)
         else if (gameState == NAME_ENTRY)
         {
             // Handle initials input (A-Z), backspace, and enter to save
-            int key = GetCharPressed();
+            int key = PopInputChar(&input);
             while (key > 0) {
                 if ((key >= 'a' && key <= 'z') || (key >= 'A' && key <= 'Z')) {
                     if (initialsCount < 3) {
@@ -204,81 +681,165 @@ int main(void)
                         initials[initialsCount++] = c;
                     }
                 }
-                key = GetCharPressed();
+                key = PopInputChar(&input);
             }
-            if (IsKeyPressed(KEY_BACKSPACE) && initialsCount > 0) {
+            if (IsInputPressed(&input, INPUT_BACKSPACE) && initialsCount > 0) {
                 initials[--initialsCount] = ' ';
             }
-            if (IsKeyPressed(KEY_ENTER) && initialsCount > 0) {
-                AddLeaderboardEntry(&leaderboard, initials, 'P', lastGameSeconds);
-                SaveLeaderboard(&leaderboard);
+            if (IsInputPressed(&input, INPUT_ENTER) && initialsCount > 0) {
+                MatchRecord match = { .playerScore = (uint8_t)player.score,
+                                      .aiScore = (uint8_t)ai.score,
+                                      .rallies = rallies, .seed = matchSeed };
+                RecordResult(&leaderboard, &players, &matchHistory, &historyLog, &boardWriter,
+                             initials, "AI", 'P', lastGameSeconds, &match);
+                memcpy(lastPlayer, initials, sizeof(lastPlayer));
                 gameState = START_SCREEN;
             }
         }
 
-        // Draw
-        BeginDrawing();
-        ClearBackground(RAYWHITE);
+        // Everything after the PLAYING input mark is simulation; other states
+        // only handle input
+        MarkFramePhase(&profiler, (updateState == PLAYING) ? FRAME_PHASE_PHYSICS
+                                                           : FRAME_PHASE_INPUT);
+        bool hadInput = HasInputActivity(&input);
+        ResetInputFrame(&input);
+
+        // Decide whether this frame needs rendering at all
+        bool hidden = IsWindowMinimized() || IsWindowHidden();
+        bool focused = IsWindowFocused();
+        bool redraw = !hidden;
+        if (redraw && !alwaysRedraw && gameState != PLAYING && !profiler.visible) {
+            redraw = hadInput || gameState != drawnState || focused != wasFocused ||
+                     (gameState == START_SCREEN &&
+                      (attractRevision !=
+                           leaderboard.revision + players.revision + matchHistory.revision ||
+                       attractBoard != shownBoard)) ||
+                     GetTime() - lastDrawTime >= IDLE_REFRESH_SECONDS;
+        }
+        wasFocused = focused;
+
+        if (!redraw) {
+            // Nothing to show: EndDrawing will not run, so poll events here.
+            // Still screens that are not visible at all are polled slowly.
+            if (hidden && gameState != PLAYING) {
+                WaitTime(1.0 / HIDDEN_POLL_FPS);
+                AlignFramePacer(&pacer, ProfilerNow());
+            } else if (pacer.periodNs == 0) {
+                WaitTime(1.0 / IDLE_POLL_FPS);
+            }
+            if (pacer.periodNs == 0) {
+                PollInputEvents();
+                AccumulateInput(&input);
+            }
+            continue;
+        }
+        drawnState = gameState;
+        lastDrawTime = GetTime();
 
-        // Draw center line
-        for (int i = 0; i < SCREEN_HEIGHT; i += CENTER_LINE_SEGMENT) {
-            DrawLineV((Vector2){ SCREEN_WIDTH / 2.0f, (float)i }, 
-                      (Vector2){ SCREEN_WIDTH / 2.0f, (float)(i + CENTER_LINE_GAP) }, LIGHTGRAY);
+        // Draw
+        if (gameState == START_SCREEN &&
+            (attractRevision != leaderboard.revision + players.revision + matchHistory.revision ||
+             attractBoard != shownBoard)) {
+            // Must happen outside BeginDrawing/EndDrawing
+            RenderAttractLayer(attractLayer, playfieldLayer, orbitronFont, textShader,
+                               &leaderboard, &players,
+                               GetMonthMedianLine(&monthMedian, &matchHistory), lastPlayer,
+                               shownBoard);
+            attractRevision = leaderboard.revision + players.revision + matchHistory.revision;
+            attractBoard = shownBoard;
         }
 
-        // Draw title
-        DrawCenteredText(orbitronFont, "PONG", 10, TITLE_FONT_SIZE, DARKGRAY);
+        BeginDrawing();
 
         if (gameState == START_SCREEN) {
-            // Show leaderboard
-            DrawCenteredText(orbitronFont, "Fastest Wins", 80, SCORE_FONT_SIZE, DARKGRAY);
-            int startY = 120;
-            for (size_t i = 0; i < leaderboard.count; ++i) {
-                const LeaderboardEntry *e = &leaderboard.entries[i];
-                char line[128];
-                snprintf(line, sizeof(line), "%2zu. %6.3fs  %c  %s",
-                         i + 1, (double)e->seconds, e->winner, e->initials);
-                DrawCenteredText(orbitronFont, line, startY + (int)i * 30,
-                                
-                                 MESSAGE_FONT_SIZE, BLACK);
-            }
-            DrawCenteredText(orbitronFont, "Press SPACE to play",
-                             SCREEN_HEIGHT - 80, MESSAGE_FONT_SIZE, DARKGRAY);
+            // Background, title and leaderboard in a single quad
+            DrawLayer(attractLayer);
         } else if (gameState == PLAYING) {
+            DrawLayer(playfieldLayer);
+
             // Draw paddles and ball during gameplay
             DrawPaddle(&player, BLUE);
             DrawPaddle(&ai, RED);
             DrawCircleV(ball.position, ball.radius, PURPLE);
 
             // Draw scores
-            char playerScoreText[20], aiScoreText[20];
-            snprintf(playerScoreText, sizeof(playerScoreText), "Player: %d", player.score);
-            snprintf(aiScoreText, sizeof(aiScoreText), "AI: %d", ai.score);
-
-            DrawTextEx(orbitronFont, playerScoreText, (Vector2){50, 80},
-                       SCORE_FONT_SIZE, 1, BLUE);
-            DrawTextEx(orbitronFont, aiScoreText,
-                       (Vector2){SCREEN_WIDTH - 250, 80}, SCORE_FONT_SIZE, 1, RED);
+            SetHudLabelNumber(&playerScoreLabel, "Player: ", player.score);
+            SetHudLabelNumber(&aiScoreLabel, "AI: ", ai.score);
+            BeginShaderMode(textShader);
+            DrawHudLabel(&playerScoreLabel, (Vector2){50, 80}, BLUE);
+            DrawHudLabel(&aiScoreLabel, (Vector2){SCREEN_WIDTH - 250, 80}, RED);
+            EndShaderMode();
         } else if (gameState == NAME_ENTRY) {
+            DrawLayer(playfieldLayer);
+
             // Only draw the win message and initials prompt
+            BeginShaderMode(textShader);
             DrawCenteredText(orbitronFont, "YOU WIN!", 220,
                              GAME_OVER_FONT_SIZE, GREEN);
-            char prompt[64];
-            snprintf(prompt, sizeof(prompt), "Enter Initials: %c%c%c",
-                     initials[0], initials[1], initials[2]);
-            DrawCenteredText(orbitronFont, prompt, 280,
-                             GAME_OVER_FONT_SIZE - 8, DARKGRAY);
+            long promptKey = ((long)initials[0] << 16) | ((long)initials[1] << 8) | initials[2];
+            if (IsHudLabelStale(&promptLabel, promptKey)) {
+                char prompt[64];
+                snprintf(prompt, sizeof(prompt), "Enter Initials: %c%c%c",
+                         initials[0], initials[1], initials[2]);
+                SetHudLabel(&promptLabel, promptKey, prompt);
+            }
+            DrawHudLabelCentered(&promptLabel, SCREEN_WIDTH, 280.0f, DARKGRAY);
             DrawCenteredText(orbitronFont, "Press ENTER to save", 340, MESSAGE_FONT_SIZE, GRAY);
+            DrawHudLabelCentered(&placeLabel, SCREEN_WIDTH, 400.0f, PURPLE);
+            EndShaderMode();
+        }
+
+        // Draw FPS (same look as DrawFPS, without formatting every frame)
+        int fps = GetFPS();
+        if (IsHudLabelStale(&fpsLabel, fps)) {
+            char fpsText[16];
+            snprintf(fpsText, sizeof(fpsText), "%2i FPS", fps);
+            SetHudLabel(&fpsLabel, fps, fpsText);
         }
+        Color fpsColour = (fps < 15) ? RED : (fps < 30) ? ORANGE : LIME;
+        DrawHudLabel(&fpsLabel, (Vector2){10, 10}, fpsColour);
 
-        // Draw FPS
-        DrawFPS(10, 10);
+        if (profiler.visible) {
+            RefreshProfilerOverlay(&profilerOverlay, &profiler, &pacer.stats);
+            DrawProfilerOverlay(&profilerOverlay);
+        }
+        MarkFramePhase(&profiler, FRAME_PHASE_DRAW);
+        RecordInputLatency(&profiler, input.sampledAt);
 
         EndDrawing();
+        uint64_t presentedAt = ProfilerNow();
+        if (!startupReported) {
+            ReportStartup(&startup, presentedAt);
+            startupReported = true;
+        }
+        MarkFramePhase(&profiler, FRAME_PHASE_PRESENT);
+        RecordFrameWork(&pacer, presentedAt - workStart);
+        if (vsync) AlignFramePacer(&pacer, presentedAt);
+
+        // EndDrawing polled events; keep its edges for the next update
+        AccumulateInput(&input);
+        MarkFramePhase(&profiler, FRAME_PHASE_INPUT);
+        EndFrameProfile(&profiler);
     }
 
     // De-Initialization
+    UnloadRenderTexture(attractLayer);
+    UnloadRenderTexture(playfieldLayer);
+    StopBoardWriter(&boardWriter);  // Flushes results still queued
+    CloseSharedBoard(&sharedBoard);
+    DestroyScoreIndex(leaderboard.index);
+    DestroyLeaderboardWindows(&leaderboard);
+    FreePlayerStatsStore(&players);
+    FreeMatchHistory(&matchHistory);
+    CloseMatchHistoryLog(&historyLog);
+    ClearTextCache();
+    UnloadShader(textShader);
     UnloadFont(orbitronFont);
+    if (pacer.periodNs > 0) {
+        char summary[80];
+        FormatPacerStats(&pacer.stats, summary, sizeof(summary));
+        TraceLog(LOG_INFO, "PACER: %s", summary);
+    }
     CloseWindow();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,941 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: matchhistory.c
+    Description: Compressed columnar history of every finished match
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "matchhistory.h"
+#include "binfile.h"
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+// Block file layout (little-endian):
+//   header  magic[8] "PRPLHIST", u32 version, u32 matches per block
+//   blocks  { header, columns, u32 FNV-1a of header and columns } appended
+//           one after another as they fill
+// Block header: u32 count, u32 column bytes, i64 min/max timestamp,
+// u32 min/max millis, u32 player wins, u32 max rallies, u32 column offsets[6]
+//
+// Columns, each a run of its own:
+//   timestamps  zigzag varint of the difference from the previous match
+//               (the first from the block's minimum)
+//   seconds     varint of milliseconds above the block's minimum
+//   winners     bitmap, one bit per match, set for an AI win
+//   scores      one byte per match, player score << 4 | AI score
+//   rallies     varint
+//   seeds       zigzag varint of the 32-bit difference from the previous seed
+// Matches a minute or so apart with sequential seeds come to about 8 bytes.
+#define HISTORY_MAGIC "PRPLHIST"
+#define HISTORY_MAGIC_SIZE 8
+#define HISTORY_VERSION 1u
+#define HISTORY_HEADER_SIZE (HISTORY_MAGIC_SIZE + 2 * 4)
+#define BLOCK_HEADER_SIZE (2 * 4 + 2 * 8 + 4 * 4 + MATCH_HISTORY_COLUMNS * 4)
+#define BLOCK_CHECKSUM_SIZE 4
+#define VARINT_MAX 10
+#define MAX_COLUMN_BYTES \
+    (MATCH_HISTORY_BLOCK * (VARINT_MAX + 5 + 1 + 5 + 5) + MATCH_HISTORY_BLOCK / 8)
+
+enum { COLUMN_TIMESTAMPS, COLUMN_SECONDS, COLUMN_WINNERS, COLUMN_SCORES, COLUMN_RALLIES,
+       COLUMN_SEEDS };
+
+// Tail layout (little-endian):
+//   header  magic[8] "PRPLHTAL", u32 version, u32 reserved, u64 ordinal of the first record
+//   records { i64 timestamp, u32 millis, u32 rallies, u32 seed, u8 winner, u8 scores,
+//             u8 pad[2], u32 FNV-1a of the record } appended one by one
+// The ordinal tells records already sealed into a block (a crash between
+// sealing and restarting the tail) from the ones still open.
+#define TAIL_MAGIC "PRPLHTAL"
+#define TAIL_VERSION 1u
+#define TAIL_HEADER_SIZE (HISTORY_MAGIC_SIZE + 2 * 4 + 8)
+#define TAIL_RECORD_SIZE 24
+#define TAIL_STRIDE (TAIL_RECORD_SIZE + 4)
+#define TAIL_WRITE_BATCH 256
+
+static unsigned char *PutVarint(unsigned char *p, uint64_t v)
+{
+    while (v >= 0x80u) {
+        *p++ = (unsigned char)(v | 0x80u);
+        v >>= 7;
+    }
+    *p++ = (unsigned char)v;
+    return p;
+}
+
+// Bounded by end; a value running past it (or past 64 bits) reads as NULL
+static const unsigned char *GetVarint(const unsigned char *p, const unsigned char *end,
+                                      uint64_t *v)
+{
+    uint64_t value = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        unsigned char byte = *p++;
+        value |= (uint64_t)(byte & 0x7Fu) << shift;
+        if (byte < 0x80u) {
+            *v = value;
+            return p;
+        }
+    }
+    return NULL;
+}
+
+static uint64_t ZigZag(uint64_t difference)
+{
+    int64_t v = (int64_t)difference;
+    return (v < 0) ? ~((uint64_t)v << 1) : (uint64_t)v << 1;
+}
+
+static uint64_t UnZigZag(uint64_t v)
+{
+    return (v & 1u) ? ~(v >> 1) : (v >> 1);
+}
+
+static uint32_t Millis(float seconds)
+{
+    if (!(seconds > 0.0f)) return 0;  // Also NaN
+    if ((double)seconds >= (double)UINT32_MAX / 1000.0) return UINT32_MAX;
+    return (uint32_t)llrint((double)seconds * 1000.0);
+}
+
+// The record as the history stores it
+static MatchRecord Normalize(const MatchRecord *match)
+{
+    MatchRecord m = *match;
+    m.seconds = (float)((double)Millis(match->seconds) / 1000.0);
+    m.winner = (match->winner == 'A') ? 'A' : 'P';
+    if (m.playerScore > 15) m.playerScore = 15;
+    if (m.aiScore > 15) m.aiScore = 15;
+    return m;
+}
+
+// --- Blocks ---------------------------------------------------------------
+
+static void Summarize(const MatchRecord *matches, size_t count, MatchBlockSummary *summary)
+{
+    memset(summary, 0, sizeof(*summary));
+    summary->count = (uint32_t)count;
+    if (count == 0) return;
+    summary->minTimestamp = summary->maxTimestamp = matches[0].timestamp;
+    summary->minMillis = summary->maxMillis = Millis(matches[0].seconds);
+    for (size_t i = 0; i < count; ++i) {
+        const MatchRecord *m = &matches[i];
+        uint32_t millis = Millis(m->seconds);
+        if (m->timestamp < summary->minTimestamp) summary->minTimestamp = m->timestamp;
+        if (m->timestamp > summary->maxTimestamp) summary->maxTimestamp = m->timestamp;
+        if (millis < summary->minMillis) summary->minMillis = millis;
+        if (millis > summary->maxMillis) summary->maxMillis = millis;
+        if (m->winner != 'A') summary->playerWins++;
+        if (m->rallies > summary->maxRallies) summary->maxRallies = m->rallies;
+    }
+}
+
+// Encode matches into block (data is allocated to fit). False on no memory.
+static bool EncodeBlock(const MatchRecord *matches, size_t count, MatchBlock *block)
+{
+    unsigned char *data = malloc(MAX_COLUMN_BYTES);
+    if (data == NULL) return false;
+    Summarize(matches, count, &block->summary);
+    const MatchBlockSummary *summary = &block->summary;
+    unsigned char *p = data;
+
+    block->columns[COLUMN_TIMESTAMPS] = 0;
+    uint64_t previous = (uint64_t)summary->minTimestamp;
+    for (size_t i = 0; i < count; ++i) {
+        p = PutVarint(p, ZigZag((uint64_t)matches[i].timestamp - previous));
+        previous = (uint64_t)matches[i].timestamp;
+    }
+    block->columns[COLUMN_SECONDS] = (uint32_t)(p - data);
+    for (size_t i = 0; i < count; ++i) {
+        p = PutVarint(p, Millis(matches[i].seconds) - summary->minMillis);
+    }
+    block->columns[COLUMN_WINNERS] = (uint32_t)(p - data);
+    memset(p, 0, (count + 7) / 8);
+    for (size_t i = 0; i < count; ++i) {
+        if (matches[i].winner == 'A') p[i / 8] |= (unsigned char)(1u << (i % 8));
+    }
+    p += (count + 7) / 8;
+    block->columns[COLUMN_SCORES] = (uint32_t)(p - data);
+    for (size_t i = 0; i < count; ++i) {
+        *p++ = (unsigned char)(matches[i].playerScore << 4 | (matches[i].aiScore & 0x0Fu));
+    }
+    block->columns[COLUMN_RALLIES] = (uint32_t)(p - data);
+    for (size_t i = 0; i < count; ++i) p = PutVarint(p, matches[i].rallies);
+    block->columns[COLUMN_SEEDS] = (uint32_t)(p - data);
+    uint32_t previousSeed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        // A 32-bit wrap-around difference read as signed
+        uint32_t difference = matches[i].seed - previousSeed;
+        int64_t signedDifference = (difference & 0x80000000u) ? (int64_t)difference - 0x100000000LL
+                                                              : (int64_t)difference;
+        p = PutVarint(p, ZigZag((uint64_t)signedDifference));
+        previousSeed = matches[i].seed;
+    }
+
+    block->size = (uint32_t)(p - data);
+    unsigned char *fitted = realloc(data, (block->size > 0) ? block->size : 1u);
+    block->data = (fitted != NULL) ? fitted : data;
+    return true;
+}
+
+static const unsigned char *ColumnEnd(const MatchBlock *block, int column)
+{
+    uint32_t end = (column + 1 < MATCH_HISTORY_COLUMNS) ? block->columns[column + 1] : block->size;
+    return block->data + end;
+}
+
+// Decode a whole block; false if its columns do not hold count matches
+static bool DecodeBlock(const MatchBlock *block, MatchRecord *out)
+{
+    const MatchBlockSummary *summary = &block->summary;
+    size_t count = summary->count;
+    const unsigned char *p = block->data + block->columns[COLUMN_TIMESTAMPS];
+    const unsigned char *end = ColumnEnd(block, COLUMN_TIMESTAMPS);
+    uint64_t previous = (uint64_t)summary->minTimestamp;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t v = 0;
+        if ((p = GetVarint(p, end, &v)) == NULL) return false;
+        previous += UnZigZag(v);
+        out[i].timestamp = (int64_t)previous;
+    }
+    p = block->data + block->columns[COLUMN_SECONDS];
+    end = ColumnEnd(block, COLUMN_SECONDS);
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t v = 0;
+        if ((p = GetVarint(p, end, &v)) == NULL) return false;
+        out[i].seconds = (float)((double)(summary->minMillis + v) / 1000.0);
+    }
+    const unsigned char *winners = block->data + block->columns[COLUMN_WINNERS];
+    const unsigned char *scores = block->data + block->columns[COLUMN_SCORES];
+    for (size_t i = 0; i < count; ++i) {
+        out[i].winner = (winners[i / 8] & (1u << (i % 8))) ? 'A' : 'P';
+        out[i].playerScore = (uint8_t)(scores[i] >> 4);
+        out[i].aiScore = (uint8_t)(scores[i] & 0x0Fu);
+    }
+    p = block->data + block->columns[COLUMN_RALLIES];
+    end = ColumnEnd(block, COLUMN_RALLIES);
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t v = 0;
+        if ((p = GetVarint(p, end, &v)) == NULL) return false;
+        out[i].rallies = (uint32_t)v;
+    }
+    p = block->data + block->columns[COLUMN_SEEDS];
+    end = ColumnEnd(block, COLUMN_SEEDS);
+    uint32_t seed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t v = 0;
+        if ((p = GetVarint(p, end, &v)) == NULL) return false;
+        seed += (uint32_t)UnZigZag(v);
+        out[i].seed = seed;
+    }
+    return true;
+}
+
+// Offsets must be ordered, inside the data, and leave the fixed-width
+// columns their full size
+static bool BlockLayoutValid(const MatchBlock *block)
+{
+    size_t count = block->summary.count;
+    if (count == 0 || count > MATCH_HISTORY_BLOCK || block->columns[0] != 0) return false;
+    for (int c = 0; c < MATCH_HISTORY_COLUMNS; ++c) {
+        uint32_t next = (c + 1 < MATCH_HISTORY_COLUMNS) ? block->columns[c + 1] : block->size;
+        if (block->columns[c] > next) return false;
+    }
+    return block->columns[COLUMN_SCORES] - block->columns[COLUMN_WINNERS] == (count + 7) / 8 &&
+           block->columns[COLUMN_RALLIES] - block->columns[COLUMN_SCORES] == count;
+}
+
+static void PutBlockHeader(unsigned char *p, const MatchBlock *block)
+{
+    const MatchBlockSummary *summary = &block->summary;
+    p = PutU32(p, summary->count);
+    p = PutU32(p, block->size);
+    p = PutU64(p, (uint64_t)summary->minTimestamp);
+    p = PutU64(p, (uint64_t)summary->maxTimestamp);
+    p = PutU32(p, summary->minMillis);
+    p = PutU32(p, summary->maxMillis);
+    p = PutU32(p, summary->playerWins);
+    p = PutU32(p, summary->maxRallies);
+    for (int c = 0; c < MATCH_HISTORY_COLUMNS; ++c) p = PutU32(p, block->columns[c]);
+}
+
+static void GetBlockHeader(const unsigned char *p, MatchBlock *block)
+{
+    MatchBlockSummary *summary = &block->summary;
+    uint64_t minTimestamp = 0, maxTimestamp = 0;
+    p = GetU32(p, &summary->count);
+    p = GetU32(p, &block->size);
+    p = GetU64(p, &minTimestamp);
+    p = GetU64(p, &maxTimestamp);
+    summary->minTimestamp = (int64_t)minTimestamp;
+    summary->maxTimestamp = (int64_t)maxTimestamp;
+    p = GetU32(p, &summary->minMillis);
+    p = GetU32(p, &summary->maxMillis);
+    p = GetU32(p, &summary->playerWins);
+    p = GetU32(p, &summary->maxRallies);
+    for (int c = 0; c < MATCH_HISTORY_COLUMNS; ++c) p = GetU32(p, &block->columns[c]);
+    block->data = NULL;
+}
+
+// Walk the valid blocks of a mapped block file from offset (the start of a
+// block); visit (may be NULL) sees each one with data pointing into the
+// mapping. Returns where the valid run ends and adds up its matches.
+typedef bool (*BlockVisitor)(void *context, const MatchBlock *block);
+
+static size_t ScanBlockRun(const unsigned char *base, size_t size, size_t offset,
+                           BlockVisitor visit, void *context, uint64_t *matches)
+{
+    *matches = 0;
+    while (size - offset >= BLOCK_HEADER_SIZE + BLOCK_CHECKSUM_SIZE) {
+        MatchBlock block;
+        GetBlockHeader(base + offset, &block);
+        if (block.size > size - offset - BLOCK_HEADER_SIZE - BLOCK_CHECKSUM_SIZE) break;
+        size_t length = BLOCK_HEADER_SIZE + block.size;
+        uint32_t checksum = 0;
+        GetU32(base + offset + length, &checksum);
+        if (checksum != Fnv1a(FNV1A_SEED, base + offset, length) ||
+            !BlockLayoutValid(&block)) {
+            break;
+        }
+        block.data = (unsigned char *)(uintptr_t)(base + offset + BLOCK_HEADER_SIZE);
+        if (visit != NULL && !visit(context, &block)) break;
+        *matches += block.summary.count;
+        offset += length + BLOCK_CHECKSUM_SIZE;
+    }
+    return offset;
+}
+
+// The whole file: returns the length of the valid prefix, 0 if the file
+// header is bad
+static size_t ScanBlocks(const unsigned char *base, size_t size, BlockVisitor visit, void *context,
+                         uint64_t *matches)
+{
+    *matches = 0;
+    uint32_t version = 0, perBlock = 0;
+    if (size < HISTORY_HEADER_SIZE || memcmp(base, HISTORY_MAGIC, HISTORY_MAGIC_SIZE) != 0) {
+        return 0;
+    }
+    GetU32(GetU32(base + HISTORY_MAGIC_SIZE, &version), &perBlock);
+    if (version != HISTORY_VERSION || perBlock != MATCH_HISTORY_BLOCK) return 0;
+    return ScanBlockRun(base, size, HISTORY_HEADER_SIZE, visit, context, matches);
+}
+
+static const unsigned char *MapFile(const char *path, size_t *size)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+    *size = (size_t)st.st_size;
+    void *mapping = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    return (mapping != MAP_FAILED) ? (const unsigned char *)mapping : NULL;
+}
+
+static void Unmap(const unsigned char *base, size_t size)
+{
+    if (base != NULL) munmap((void *)(uintptr_t)base, size);
+}
+
+// --- Tail records ---------------------------------------------------------
+
+static void EncodeTailRecord(unsigned char *p, const MatchRecord *m)
+{
+    memset(p, 0, TAIL_STRIDE);
+    unsigned char *q = PutU64(p, (uint64_t)m->timestamp);
+    q = PutU32(q, Millis(m->seconds));
+    q = PutU32(q, m->rallies);
+    q = PutU32(q, m->seed);
+    q[0] = (unsigned char)m->winner;
+    q[1] = (unsigned char)(m->playerScore << 4 | (m->aiScore & 0x0Fu));
+    PutU32(p + TAIL_RECORD_SIZE, Fnv1a(FNV1A_SEED, p, TAIL_RECORD_SIZE));
+}
+
+static bool DecodeTailRecord(const unsigned char *p, MatchRecord *m)
+{
+    uint32_t checksum = 0;
+    GetU32(p + TAIL_RECORD_SIZE, &checksum);
+    if (checksum != Fnv1a(FNV1A_SEED, p, TAIL_RECORD_SIZE)) return false;
+    uint64_t timestamp = 0;
+    uint32_t millis = 0;
+    const unsigned char *q = GetU64(p, &timestamp);
+    q = GetU32(q, &millis);
+    q = GetU32(q, &m->rallies);
+    q = GetU32(q, &m->seed);
+    m->timestamp = (int64_t)timestamp;
+    m->seconds = (float)((double)millis / 1000.0);
+    m->winner = (q[0] == 'A') ? 'A' : 'P';
+    m->playerScore = (uint8_t)(q[1] >> 4);
+    m->aiScore = (uint8_t)(q[1] & 0x0Fu);
+    return true;
+}
+
+static void TailPath(const char *path, char *out, size_t size)
+{
+    snprintf(out, size, "%s.tail", path);
+}
+
+typedef bool (*RecordSink)(void *context, const MatchRecord *m);
+
+// Tail records whose ordinal is at least sealed go to sink; returns false
+// if the tail is missing or not a tail. untidy is set when anything after
+// the header was not a valid record, or the ordinals did not line up.
+static bool ReadTail(const char *tailPath, uint64_t sealed, RecordSink sink, void *context,
+                     bool *untidy)
+{
+    size_t size = 0;
+    const unsigned char *base = MapFile(tailPath, &size);
+    *untidy = true;
+    if (base == NULL) return false;
+    uint32_t version = 0;
+    uint64_t first = 0;
+    if (size < TAIL_HEADER_SIZE || memcmp(base, TAIL_MAGIC, HISTORY_MAGIC_SIZE) != 0) {
+        Unmap(base, size);
+        return false;
+    }
+    GetU64(GetU32(base + HISTORY_MAGIC_SIZE, &version) + 4, &first);
+    if (version != TAIL_VERSION) {
+        Unmap(base, size);
+        return false;
+    }
+    size_t available = (size - TAIL_HEADER_SIZE) / TAIL_STRIDE;
+    size_t valid = 0;
+    bool ok = true;
+    for (; valid < available && ok; ++valid) {
+        MatchRecord m;
+        if (!DecodeTailRecord(base + TAIL_HEADER_SIZE + valid * TAIL_STRIDE, &m)) break;
+        if (first + valid >= sealed) ok = sink(context, &m);
+    }
+    *untidy = first != sealed || size != TAIL_HEADER_SIZE + valid * TAIL_STRIDE || !ok;
+    Unmap(base, size);
+    return true;
+}
+
+// --- In-memory history ----------------------------------------------------
+
+void FreeMatchHistory(MatchHistory *history)
+{
+    if (history == NULL) return;
+    for (size_t i = 0; i < history->blockCount; ++i) free(history->blocks[i].data);
+    free(history->blocks);
+    free(history->open);
+    unsigned int revision = history->revision;
+    memset(history, 0, sizeof(*history));
+    history->revision = revision + 1u;
+}
+
+static bool PushBlock(MatchHistory *history, const MatchBlock *block)
+{
+    if (history->blockCount == history->blockCapacity) {
+        size_t capacity = (history->blockCapacity > 0) ? history->blockCapacity * 2 : 16;
+        MatchBlock *blocks = realloc(history->blocks, capacity * sizeof(MatchBlock));
+        if (blocks == NULL) return false;
+        history->blocks = blocks;
+        history->blockCapacity = capacity;
+    }
+    history->blocks[history->blockCount++] = *block;
+    return true;
+}
+
+bool AppendMatchHistory(MatchHistory *history, const MatchRecord *match)
+{
+    if (history == NULL || match == NULL) return false;
+    if (history->open == NULL) {
+        history->open = malloc(MATCH_HISTORY_BLOCK * sizeof(MatchRecord));
+        if (history->open == NULL) return false;
+    }
+    if (history->openCount == MATCH_HISTORY_BLOCK) {
+        // Sealing failed last time (out of memory); try again
+        MatchBlock block;
+        if (!EncodeBlock(history->open, history->openCount, &block)) return false;
+        if (!PushBlock(history, &block)) {
+            free(block.data);
+            return false;
+        }
+        history->openCount = 0;
+    }
+    history->open[history->openCount++] = Normalize(match);
+    history->revision++;
+    if (history->openCount == MATCH_HISTORY_BLOCK) {
+        MatchBlock block;
+        if (EncodeBlock(history->open, history->openCount, &block)) {
+            if (PushBlock(history, &block)) {
+                history->openCount = 0;
+            } else {
+                free(block.data);
+            }
+        }
+    }
+    return true;
+}
+
+size_t MatchHistoryCount(const MatchHistory *history)
+{
+    if (history == NULL) return 0;
+    size_t count = history->openCount;
+    for (size_t i = 0; i < history->blockCount; ++i) count += history->blocks[i].summary.count;
+    return count;
+}
+
+size_t CopyMatchHistory(const MatchHistory *history, size_t first, MatchRecord *out, size_t max)
+{
+    if (history == NULL || out == NULL) return 0;
+    MatchRecord *decoded = NULL;
+    size_t copied = 0;
+    size_t position = 0;  // Index of the first match in the current block
+    for (size_t b = 0; b < history->blockCount && copied < max; ++b) {
+        const MatchBlock *block = &history->blocks[b];
+        size_t count = block->summary.count;
+        if (first + copied < position + count) {
+            if (decoded == NULL) decoded = malloc(MATCH_HISTORY_BLOCK * sizeof(MatchRecord));
+            if (decoded == NULL || !DecodeBlock(block, decoded)) break;
+            for (size_t i = first + copied - position; i < count && copied < max; ++i) {
+                out[copied++] = decoded[i];
+            }
+        }
+        position += count;
+    }
+    free(decoded);
+    for (size_t i = 0; i < history->openCount && copied < max; ++i) {
+        if (position + i >= first + copied) out[copied++] = history->open[i];
+    }
+    return copied;
+}
+
+// Collected millis, grown as blocks are read
+typedef struct {
+    uint32_t *values;
+    size_t count;
+} MillisList;
+
+static bool Wanted(const MatchFilter *filter, int64_t timestamp, char winner)
+{
+    return timestamp >= filter->from && timestamp < filter->to &&
+           (filter->winner == 0 || filter->winner == winner);
+}
+
+// Read one block's qualifying millis into list. Decodes the seconds column
+// always, winners only when the block has both kinds, timestamps only when
+// the block straddles the range.
+static bool ReadBlockMillis(const MatchBlock *block, const MatchFilter *filter, MillisList *list,
+                            int64_t *timestamps)
+{
+    const MatchBlockSummary *summary = &block->summary;
+    size_t count = summary->count;
+    bool inside = summary->minTimestamp >= filter->from && summary->maxTimestamp < filter->to;
+    bool mixed = summary->playerWins > 0 && summary->playerWins < count;
+    const unsigned char *winners = block->data + block->columns[COLUMN_WINNERS];
+    unsigned char wantBit = (filter->winner == 'A') ? 1u : 0u;
+
+    if (!inside) {
+        const unsigned char *p = block->data + block->columns[COLUMN_TIMESTAMPS];
+        const unsigned char *end = ColumnEnd(block, COLUMN_TIMESTAMPS);
+        uint64_t previous = (uint64_t)summary->minTimestamp;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t v = 0;
+            if ((p = GetVarint(p, end, &v)) == NULL) return false;
+            previous += UnZigZag(v);
+            timestamps[i] = (int64_t)previous;
+        }
+    }
+
+    const unsigned char *p = block->data + block->columns[COLUMN_SECONDS];
+    const unsigned char *end = ColumnEnd(block, COLUMN_SECONDS);
+    uint32_t base = summary->minMillis;
+    uint32_t *out = list->values + list->count;
+    if (inside && (filter->winner == 0 || !mixed)) {
+        // Every match counts: the seconds column alone, straight into the list
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t v = 0;
+            if ((p = GetVarint(p, end, &v)) == NULL) return false;
+            out[i] = base + (uint32_t)v;
+        }
+        list->count += count;
+        return true;
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t v = 0;
+        if ((p = GetVarint(p, end, &v)) == NULL) return false;
+        bool take = inside || (timestamps[i] >= filter->from && timestamps[i] < filter->to);
+        if (filter->winner != 0 && mixed) {
+            take = take && ((winners[i / 8] >> (i % 8)) & 1u) == wantBit;
+        }
+        if (take) out[kept++] = base + (uint32_t)v;
+    }
+    list->count += kept;
+    return true;
+}
+
+static void SwapMillis(uint32_t *a, uint32_t *b)
+{
+    uint32_t t = *a;
+    *a = *b;
+    *b = t;
+}
+
+// k-th smallest (0-based) by quickselect; expected O(n), reorders values
+static uint32_t SelectMillis(uint32_t *values, size_t count, size_t k)
+{
+    size_t low = 0, high = count - 1;
+    while (low < high) {
+        // Median of three as the pivot, then a Hoare partition
+        size_t mid = low + (high - low) / 2;
+        if (values[mid] < values[low]) SwapMillis(&values[mid], &values[low]);
+        if (values[high] < values[low]) SwapMillis(&values[high], &values[low]);
+        if (values[high] < values[mid]) SwapMillis(&values[high], &values[mid]);
+        uint32_t pivot = values[mid];
+        size_t i = low, j = high;
+        while (i <= j) {
+            while (values[i] < pivot) i++;
+            while (values[j] > pivot) j--;
+            if (i <= j) {
+                SwapMillis(&values[i], &values[j]);
+                i++;
+                if (j == 0) break;
+                j--;
+            }
+        }
+        if (k <= j) {
+            high = j;
+        } else if (k >= i) {
+            low = i;
+        } else {
+            return values[k];
+        }
+    }
+    return values[k];
+}
+
+bool MatchHistoryPercentile(const MatchHistory *history, const MatchFilter *filter,
+                            double percentile, float *seconds, MatchQueryStats *stats)
+{
+    MatchQueryStats counts = {0};
+    if (stats != NULL) *stats = counts;
+    if (history == NULL || filter == NULL || seconds == NULL || filter->from >= filter->to) {
+        return false;
+    }
+
+    // Rule blocks out on their summaries first, which also bounds the list
+    size_t bound = history->openCount;
+    for (size_t b = 0; b < history->blockCount; ++b) {
+        const MatchBlockSummary *summary = &history->blocks[b].summary;
+        bool skip = summary->maxTimestamp < filter->from || summary->minTimestamp >= filter->to ||
+                    (filter->winner == 'P' && summary->playerWins == 0) ||
+                    (filter->winner == 'A' && summary->playerWins == summary->count);
+        if (skip) {
+            counts.blocksSkipped++;
+        } else {
+            bound += summary->count;
+        }
+    }
+    MillisList list = { malloc((bound > 0 ? bound : 1u) * sizeof(uint32_t)), 0 };
+    int64_t *timestamps = malloc(MATCH_HISTORY_BLOCK * sizeof(int64_t));
+    bool ok = list.values != NULL && timestamps != NULL;
+    for (size_t b = 0; b < history->blockCount && ok; ++b) {
+        const MatchBlockSummary *summary = &history->blocks[b].summary;
+        bool skip = summary->maxTimestamp < filter->from || summary->minTimestamp >= filter->to ||
+                    (filter->winner == 'P' && summary->playerWins == 0) ||
+                    (filter->winner == 'A' && summary->playerWins == summary->count);
+        if (skip) continue;
+        counts.blocksRead++;
+        ok = ReadBlockMillis(&history->blocks[b], filter, &list, timestamps);
+    }
+    for (size_t i = 0; i < history->openCount && ok; ++i) {
+        const MatchRecord *m = &history->open[i];
+        if (Wanted(filter, m->timestamp, m->winner)) list.values[list.count++] = Millis(m->seconds);
+    }
+    free(timestamps);
+
+    counts.matches = list.count;
+    if (stats != NULL) *stats = counts;
+    ok = ok && list.count > 0;
+    if (ok) {
+        double p = (percentile < 0.0) ? 0.0 : (percentile > 1.0) ? 1.0 : percentile;
+        size_t rank = (size_t)ceil(p * (double)list.count);
+        size_t k = (rank > 0) ? rank - 1 : 0;
+        *seconds = (float)((double)SelectMillis(list.values, list.count, k) / 1000.0);
+    }
+    free(list.values);
+    return ok;
+}
+
+// --- Files ----------------------------------------------------------------
+
+static bool CopyBlock(void *context, const MatchBlock *block)
+{
+    MatchHistory *history = (MatchHistory *)context;
+    MatchBlock copy = *block;
+    copy.data = malloc((block->size > 0) ? block->size : 1u);
+    if (copy.data == NULL) return false;
+    memcpy(copy.data, block->data, block->size);
+    if (!PushBlock(history, &copy)) {
+        free(copy.data);
+        return false;
+    }
+    return true;
+}
+
+static bool AppendLoaded(void *context, const MatchRecord *m)
+{
+    return AppendMatchHistory((MatchHistory *)context, m);
+}
+
+bool LoadMatchHistory(MatchHistory *history, const char *path)
+{
+    if (history == NULL || path == NULL) return false;
+    FreeMatchHistory(history);
+
+    uint64_t sealed = 0;
+    size_t size = 0;
+    const unsigned char *base = MapFile(path, &size);
+    if (base != NULL) {
+        (void)posix_madvise((void *)(uintptr_t)base, size, POSIX_MADV_SEQUENTIAL);
+        ScanBlocks(base, size, CopyBlock, history, &sealed);
+        Unmap(base, size);
+    }
+    char tailPath[520];
+    TailPath(path, tailPath, sizeof(tailPath));
+    bool untidy = false;
+    ReadTail(tailPath, sealed, AppendLoaded, history, &untidy);
+    history->revision++;
+    return true;
+}
+
+typedef struct {
+    uint64_t sealed;
+    const MatchRecord *records;
+    size_t count;
+} TailContents;
+
+static bool WriteTailContents(FILE *fp, void *context)
+{
+    const TailContents *contents = (const TailContents *)context;
+    unsigned char header[TAIL_HEADER_SIZE] = {0};
+    memcpy(header, TAIL_MAGIC, HISTORY_MAGIC_SIZE);
+    PutU64(PutU32(header + HISTORY_MAGIC_SIZE, TAIL_VERSION) + 4, contents->sealed);
+    bool ok = fwrite(header, 1, sizeof(header), fp) == sizeof(header);
+    unsigned char record[TAIL_STRIDE];
+    for (size_t i = 0; i < contents->count && ok; ++i) {
+        EncodeTailRecord(record, &contents->records[i]);
+        ok = fwrite(record, 1, sizeof(record), fp) == sizeof(record);
+    }
+    return ok;
+}
+
+// Replace the tail with records (ordinals from log->sealed) and open it for appends
+static bool ResetTail(MatchHistoryLog *log, const char *tailPath, const MatchRecord *records,
+                      size_t count)
+{
+    if (log->tailFd >= 0) close(log->tailFd);
+    log->tailFd = -1;
+    log->tailCount = 0;
+
+    TailContents contents = { log->sealed, records, count };
+    if (!WriteFileAtomic(tailPath, WriteTailContents, &contents)) return false;
+    log->tailFd = open(tailPath, O_WRONLY | O_APPEND);
+    if (log->tailFd < 0) return false;
+    if (records != log->tail && count > 0) memcpy(log->tail, records, count * sizeof(MatchRecord));
+    log->tailCount = count;
+    return true;
+}
+
+static bool CollectTail(void *context, const MatchRecord *m)
+{
+    MatchHistoryLog *log = (MatchHistoryLog *)context;
+    if (log->tailCount >= MATCH_HISTORY_BLOCK) return false;
+    log->tail[log->tailCount++] = *m;
+    return true;
+}
+
+// Read the tail afresh (records not yet sealed) and open it for appends,
+// rewriting it if it holds anything else
+static bool ReopenTail(MatchHistoryLog *log, const char *path)
+{
+    if (log->tailFd >= 0) close(log->tailFd);
+    log->tailFd = -1;
+    log->tailCount = 0;
+    char tailPath[520];
+    TailPath(path, tailPath, sizeof(tailPath));
+    bool untidy = false;
+    ReadTail(tailPath, log->sealed, CollectTail, log, &untidy);
+    if (untidy) return ResetTail(log, tailPath, log->tail, log->tailCount);
+    log->tailFd = open(tailPath, O_WRONLY | O_APPEND);
+    return log->tailFd >= 0;
+}
+
+bool OpenMatchHistoryLog(MatchHistoryLog *log, const char *path)
+{
+    if (log == NULL || path == NULL) return false;
+    log->blocksFd = -1;
+    log->tailFd = -1;
+    log->sealed = 0;
+    log->blocksSize = 0;
+    log->tailCount = 0;
+    log->tail = malloc(MATCH_HISTORY_BLOCK * sizeof(MatchRecord));
+    if (log->tail == NULL) return false;
+
+    // Blocks: keep the valid prefix, starting the file if it has none
+    log->blocksFd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (log->blocksFd < 0) return false;
+    size_t size = 0;
+    const unsigned char *base = MapFile(path, &size);
+    size_t valid = (base != NULL) ? ScanBlocks(base, size, NULL, NULL, &log->sealed) : 0;
+    Unmap(base, size);
+    if (valid == 0) {
+        unsigned char header[HISTORY_HEADER_SIZE];
+        memcpy(header, HISTORY_MAGIC, HISTORY_MAGIC_SIZE);
+        PutU32(PutU32(header + HISTORY_MAGIC_SIZE, HISTORY_VERSION), MATCH_HISTORY_BLOCK);
+        if (ftruncate(log->blocksFd, 0) != 0 ||
+            write(log->blocksFd, header, sizeof(header)) != (ssize_t)sizeof(header)) {
+            CloseMatchHistoryLog(log);
+            return false;
+        }
+        valid = HISTORY_HEADER_SIZE;
+    } else if (valid < size && ftruncate(log->blocksFd, (off_t)valid) != 0) {
+        CloseMatchHistoryLog(log);
+        return false;
+    }
+    log->blocksSize = valid;
+    return ReopenTail(log, path);
+}
+
+// Encode the full tail as a block, append and sync it, then restart the tail
+static bool SealTail(MatchHistoryLog *log, const char *path)
+{
+    MatchBlock block;
+    if (!EncodeBlock(log->tail, log->tailCount, &block)) return false;
+    size_t length = BLOCK_HEADER_SIZE + block.size + BLOCK_CHECKSUM_SIZE;
+    unsigned char *buffer = malloc(length);
+    struct stat st;
+    bool ok = buffer != NULL && fstat(log->blocksFd, &st) == 0;
+    if (ok) {
+        PutBlockHeader(buffer, &block);
+        memcpy(buffer + BLOCK_HEADER_SIZE, block.data, block.size);
+        PutU32(buffer + BLOCK_HEADER_SIZE + block.size,
+               Fnv1a(FNV1A_SEED, buffer, BLOCK_HEADER_SIZE + block.size));
+        ok = write(log->blocksFd, buffer, length) == (ssize_t)length &&
+             fdatasync(log->blocksFd) == 0;
+        if (!ok) (void)ftruncate(log->blocksFd, st.st_size);
+    }
+    if (ok) log->blocksSize = (uint64_t)st.st_size + length;
+    free(buffer);
+    free(block.data);
+    if (!ok) return false;
+
+    // Until the tail restarts it names the old ordinal, so a crash here
+    // leaves its records recognisably sealed
+    log->sealed += log->tailCount;
+    char tailPath[520];
+    TailPath(path, tailPath, sizeof(tailPath));
+    ResetTail(log, tailPath, NULL, 0);
+    return true;
+}
+
+bool AppendMatchHistoryLog(MatchHistoryLog *log, const char *path, const MatchRecord *matches,
+                           size_t count)
+{
+    if (log == NULL || path == NULL || log->blocksFd < 0 || (matches == NULL && count > 0)) {
+        return false;
+    }
+    if (log->tailFd < 0) {
+        // Lost the tail after a seal: pick the files up again
+        CloseMatchHistoryLog(log);
+        if (!OpenMatchHistoryLog(log, path)) return false;
+    }
+    unsigned char batch[TAIL_WRITE_BATCH * TAIL_STRIDE];
+    size_t done = 0;
+    while (done < count) {
+        if (log->tailCount == MATCH_HISTORY_BLOCK && !SealTail(log, path)) return false;
+        if (log->tailFd < 0) return false;
+        size_t n = count - done;
+        if (n > MATCH_HISTORY_BLOCK - log->tailCount) n = MATCH_HISTORY_BLOCK - log->tailCount;
+        if (n > TAIL_WRITE_BATCH) n = TAIL_WRITE_BATCH;
+        for (size_t i = 0; i < n; ++i) {
+            MatchRecord m = Normalize(&matches[done + i]);
+            EncodeTailRecord(&batch[i * TAIL_STRIDE], &m);
+            log->tail[log->tailCount + i] = m;
+        }
+        size_t bytes = n * TAIL_STRIDE;
+        if (write(log->tailFd, batch, bytes) != (ssize_t)bytes) {
+            off_t end = (off_t)(TAIL_HEADER_SIZE + log->tailCount * TAIL_STRIDE);
+            (void)ftruncate(log->tailFd, end);
+            return false;
+        }
+        log->tailCount += n;
+        done += n;
+    }
+    // The records are safe in the tail; a seal that fails is retried by the
+    // next append
+    if (log->tailCount == MATCH_HISTORY_BLOCK) SealTail(log, path);
+    return true;
+}
+
+bool SyncMatchHistoryLog(MatchHistoryLog *log)
+{
+    if (log == NULL || log->tailFd < 0) return false;
+    return fdatasync(log->tailFd) == 0;
+}
+
+bool RefreshMatchHistoryLog(MatchHistoryLog *log, const char *path)
+{
+    if (log == NULL || path == NULL) return false;
+    struct stat blocks;
+    if (log->blocksFd < 0 || log->tail == NULL || fstat(log->blocksFd, &blocks) != 0 ||
+        (uint64_t)blocks.st_size < log->blocksSize) {
+        // Never opened, or the file was started over: read it all again
+        CloseMatchHistoryLog(log);
+        return OpenMatchHistoryLog(log, path);
+    }
+    if ((uint64_t)blocks.st_size > log->blocksSize) {
+        // Blocks other writers sealed: check only those, and trim anything
+        // torn behind them before appending after it
+        size_t size = 0;
+        const unsigned char *base = MapFile(path, &size);
+        uint64_t added = 0;
+        size_t valid = (size_t)log->blocksSize;
+        if (base != NULL && size >= valid) {
+            valid = ScanBlockRun(base, size, valid, NULL, NULL, &added);
+        }
+        Unmap(base, size);
+        log->sealed += added;
+        log->blocksSize = valid;
+        if ((uint64_t)blocks.st_size > valid) (void)ftruncate(log->blocksFd, (off_t)valid);
+    }
+
+    char tailPath[520];
+    TailPath(path, tailPath, sizeof(tailPath));
+    struct stat current, named;
+    if (log->tailFd >= 0 && fstat(log->tailFd, &current) == 0 && stat(tailPath, &named) == 0 &&
+        current.st_ino == named.st_ino && current.st_dev == named.st_dev &&
+        current.st_size == (off_t)(TAIL_HEADER_SIZE + log->tailCount * TAIL_STRIDE)) {
+        return true;
+    }
+    // Another writer appended to or restarted the tail; it is at most a
+    // block's worth of records
+    return ReopenTail(log, path);
+}
+
+void CloseMatchHistoryLog(MatchHistoryLog *log)
+{
+    if (log == NULL) return;
+    if (log->blocksFd >= 0) close(log->blocksFd);
+    if (log->tailFd >= 0) close(log->tailFd);
+    free(log->tail);
+    log->blocksFd = -1;
+    log->tailFd = -1;
+    log->tail = NULL;
+    log->tailCount = 0;
+}
@@ -0,0 +1,131 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: matchhistory.h
+    Description: Compressed columnar history of every finished match
+========================================================================= */
+
+#ifndef MATCHHISTORY_H
+#define MATCHHISTORY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MATCH_HISTORY_NAME "history.bin"   // Sealed blocks; the open block is in "<name>.tail"
+#define MATCH_HISTORY_BLOCK 4096           // Matches per block
+#define MATCH_HISTORY_COLUMNS 6           // Timestamps, seconds, winners, scores, rallies, seeds
+#define MATCH_HISTORY_MONTH_SECONDS (30 * 86400)
+
+// One finished match. Stored seconds are quantized to milliseconds and each
+// score to 0-15; everything else is kept exactly.
+typedef struct {
+    int64_t timestamp;    // Unix time the match was recorded
+    float seconds;        // Match length
+    char winner;          // 'P' for player, 'A' for AI
+    uint8_t playerScore;
+    uint8_t aiScore;
+    uint32_t rallies;     // Paddle hits in the match
+    uint32_t seed;        // What the match's randomness was seeded with
+} MatchRecord;
+
+// What a block's summary says about all of its matches, so queries can
+// rule a block in or out without decoding it
+typedef struct {
+    int64_t minTimestamp;
+    int64_t maxTimestamp;
+    uint32_t count;
+    uint32_t minMillis;     // Quantized seconds
+    uint32_t maxMillis;
+    uint32_t playerWins;
+    uint32_t maxRallies;
+} MatchBlockSummary;
+
+// Sealed block: one column after another, each encoded on its own (see
+// matchhistory.c), so a query decodes only the columns it reads
+typedef struct {
+    MatchBlockSummary summary;
+    uint32_t columns[MATCH_HISTORY_COLUMNS];  // Offset of each column in data
+    uint32_t size;
+    unsigned char *data;
+} MatchBlock;
+
+// In-memory history: sealed blocks plus the open block as plain records.
+// Appends are O(1) amortised; every MATCH_HISTORY_BLOCK matches the open
+// block is encoded and sealed. Matches are expected in roughly time order
+// (blocks record their own earliest and latest times, so out-of-order matches
+// only make summaries less selective, never answers wrong). Appends store
+// the match as it will read back: quantized, with winner 'P' or 'A'.
+typedef struct {
+    MatchBlock *blocks;
+    size_t blockCount;
+    size_t blockCapacity;
+    MatchRecord *open;     // MATCH_HISTORY_BLOCK records, allocated on first use
+    size_t openCount;
+    unsigned int revision;  // Bumped on every append (for render caching)
+} MatchHistory;
+
+void FreeMatchHistory(MatchHistory *history);
+bool AppendMatchHistory(MatchHistory *history, const MatchRecord *match);
+size_t MatchHistoryCount(const MatchHistory *history);
+
+// Decode up to max matches starting at index first (in append order);
+// returns how many were copied
+size_t CopyMatchHistory(const MatchHistory *history, size_t first, MatchRecord *out, size_t max);
+
+// Matches a query looks at: recorded in [from, to), won by winner ('P',
+// 'A' or 0 for either)
+typedef struct {
+    int64_t from;
+    int64_t to;
+    char winner;
+} MatchFilter;
+
+typedef struct {
+    size_t matches;        // Matches that passed the filter
+    size_t blocksRead;     // Blocks with at least one column decoded
+    size_t blocksSkipped;  // Ruled out by their summary alone
+} MatchQueryStats;
+
+// Nearest-rank percentile (0 to 1; 0.5 is the median) of match length over
+// the matches passing filter. Blocks outside the time range or without a
+// win by the wanted side are skipped on their summaries; blocks wholly
+// inside the range decode only the seconds (and winner) columns. Returns
+// false if no match passes. stats may be NULL.
+bool MatchHistoryPercentile(const MatchHistory *history, const MatchFilter *filter,
+                            double percentile, float *seconds, MatchQueryStats *stats);
+
+// Files: sealed blocks in path (each with its summary and checksum) and the
+// open block's records in "<path>.tail", appended one by one with their own
+// checksums like the leaderboard journal. A missing file is an empty
+// history; a torn final block or record is dropped. Load replaces history.
+bool LoadMatchHistory(MatchHistory *history, const char *path);
+
+// Writer side: the tail and the number of sealed matches, enough to append
+// and seal without holding the whole history in memory
+typedef struct {
+    int blocksFd;
+    int tailFd;
+    uint64_t sealed;     // Matches in sealed blocks
+    uint64_t blocksSize; // Length of the blocks file checked so far
+    MatchRecord *tail;   // The tail file's records
+    size_t tailCount;
+} MatchHistoryLog;
+
+bool OpenMatchHistoryLog(MatchHistoryLog *log, const char *path);
+
+// Append records to the tail; a full tail is encoded, appended to path and
+// synced, then the tail restarts empty
+bool AppendMatchHistoryLog(MatchHistoryLog *log, const char *path, const MatchRecord *matches,
+                           size_t count);
+bool SyncMatchHistoryLog(MatchHistoryLog *log);
+
+// Catch up with other processes writing the same files (call with their
+// writes excluded): checks only blocks appended since the last look and
+// rereads the tail if it changed behind this log
+bool RefreshMatchHistoryLog(MatchHistoryLog *log, const char *path);
+void CloseMatchHistoryLog(MatchHistoryLog *log);
+
+#endif // MATCHHISTORY_H
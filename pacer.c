@@ -0,0 +1,105 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: pacer.c
+    Description: Hybrid sleep/spin frame pacing with deadline error statistics
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "pacer.h"
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "profiler.h"
+
+static void SleepUntil(uint64_t target)
+{
+    struct timespec ts = {
+        .tv_sec = (time_t)(target / 1000000000u),
+        .tv_nsec = (long)(target % 1000000000u)
+    };
+    // Absolute deadline, so an interrupted sleep just resumes
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+}
+
+void InitFramePacer(FramePacer *pacer, int fps, bool lateWake)
+{
+    if (!pacer) return;
+    memset(pacer, 0, sizeof(*pacer));
+    pacer->periodNs = (fps > 0) ? 1000000000u / (uint64_t)fps : 0;
+    pacer->lateWake = lateWake;
+    pacer->deadline = ProfilerNow() + pacer->periodNs;
+}
+
+uint64_t NextFrameDeadline(uint64_t deadline, uint64_t periodNs, uint64_t now, bool *missed)
+{
+    uint64_t next = deadline + periodNs;
+    bool late = next <= now;
+    if (late) {
+        // Drop the missed frames instead of rushing to catch up
+        next = now + periodNs;
+    }
+    if (missed) *missed = late;
+    return next;
+}
+
+int64_t WaitForFrameDeadline(FramePacer *pacer)
+{
+    if (!pacer || pacer->periodNs == 0) return 0;
+
+    uint64_t reserve = pacer->lateWake ? pacer->reserveNs + PACER_RESERVE_MARGIN_NS : 0;
+    if (reserve > pacer->periodNs / 2) reserve = pacer->periodNs / 2;
+    uint64_t target = pacer->deadline - reserve;
+
+    uint64_t now = ProfilerNow();
+    if (now >= target) {
+        pacer->stats.missed++;
+    } else {
+        if (target - now > PACER_SPIN_NS) SleepUntil(target - PACER_SPIN_NS);
+        while ((now = ProfilerNow()) < target) {
+        }
+    }
+
+    int64_t error = (int64_t)(now - target);
+    pacer->stats.frames++;
+    pacer->stats.lastErrorNs = error;
+    pacer->stats.sumAbsErrorNs += (uint64_t)((error < 0) ? -error : error);
+    if (error > 0 && (uint64_t)error > pacer->stats.maxLateNs) {
+        pacer->stats.maxLateNs = (uint64_t)error;
+    }
+
+    pacer->deadline = NextFrameDeadline(pacer->deadline, pacer->periodNs, now + reserve, NULL);
+    return error;
+}
+
+int FormatPacerStats(const PacerStats *stats, char *buffer, size_t size)
+{
+    if (!stats || !buffer || size == 0) return 0;
+    if (stats->frames == 0) return snprintf(buffer, size, "unpaced");
+    double meanMs = (double)stats->sumAbsErrorNs / (double)stats->frames / 1e6;
+    return snprintf(buffer, size,
+                    "missed %" PRIu64 "/%" PRIu64 "  max late %.2f  mean |err| %.3f ms",
+                    stats->missed, stats->frames, (double)stats->maxLateNs / 1e6, meanMs);
+}
+
+void RecordFrameWork(FramePacer *pacer, uint64_t workNs)
+{
+    if (!pacer) return;
+    if (workNs > pacer->reserveNs) {
+        pacer->reserveNs = workNs;
+    } else {
+        pacer->reserveNs = (uint64_t)((double)pacer->reserveNs * PACER_RESERVE_DECAY);
+    }
+}
+
+void AlignFramePacer(FramePacer *pacer, uint64_t presentedAt)
+{
+    if (!pacer || pacer->periodNs == 0) return;
+    pacer->deadline = presentedAt + pacer->periodNs;
+}
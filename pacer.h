@@ -0,0 +1,59 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: pacer.h
+    Description: Hybrid sleep/spin frame pacing with deadline error statistics
+========================================================================= */
+
+#ifndef PACER_H
+#define PACER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PACER_SPIN_NS 1000000u        // Spin the last 1 ms instead of trusting the scheduler
+#define PACER_RESERVE_MARGIN_NS 1000000u
+#define PACER_RESERVE_DECAY 0.99      // Per-frame decay of the peak work estimate
+
+typedef struct {
+    uint64_t frames;
+    uint64_t missed;        // Deadlines already passed when the wait began
+    int64_t lastErrorNs;    // Wake time minus target (positive = late)
+    uint64_t maxLateNs;
+    uint64_t sumAbsErrorNs;
+} PacerStats;
+
+typedef struct {
+    uint64_t periodNs;      // 0 = unpaced (e.g. vsync does the pacing)
+    uint64_t deadline;      // Next frame deadline, ProfilerNow() time
+    bool lateWake;          // Wake early enough to finish just before the deadline
+    uint64_t reserveNs;     // Decaying peak of recent frame work
+    PacerStats stats;
+} FramePacer;
+
+// fps <= 0 disables pacing. With lateWake the pacer wakes reserveNs before
+// the deadline so input can be sampled as late as possible.
+void InitFramePacer(FramePacer *pacer, int fps, bool lateWake);
+
+// Sleep with clock_nanosleep(TIMER_ABSTIME), spin the final PACER_SPIN_NS,
+// then advance the deadline. Returns the wake error in nanoseconds.
+int64_t WaitForFrameDeadline(FramePacer *pacer);
+
+// Feed how long simulate+draw+submit took, for the late-wake reserve
+void RecordFrameWork(FramePacer *pacer, uint64_t workNs);
+
+// With vsync the swap returns at a vblank; anchor the next deadline to it
+void AlignFramePacer(FramePacer *pacer, uint64_t presentedAt);
+
+// One-line summary for the F3 overlay and the exit log: deadlines missed,
+// worst late wake and mean absolute wake error. Returns snprintf's result.
+int FormatPacerStats(const PacerStats *stats, char *buffer, size_t size);
+
+// Deadline after `deadline`, skipping ahead (and flagging a miss) if `now`
+// is already past it
+uint64_t NextFrameDeadline(uint64_t deadline, uint64_t periodNs, uint64_t now, bool *missed);
+
+#endif // PACER_H
@@ -0,0 +1,555 @@
+/* =========================================================================
+    Purple - Platform
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: rlnull.c
+    Description: Headless raylib core: no window, scripted input, virtual
+                 time and a frame limit, so the unmodified game loop runs
+                 at full speed on machines without a display
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "rlnull.h"
+#include <limits.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Environment:
+//   PURPLE_NULL_FRAMES  Loop iterations before WindowShouldClose (default 36000)
+//   PURPLE_NULL_FPS     Virtual frames per second for GetTime (default 60)
+//   PURPLE_NULL_SCRIPT  Input script; without it an autopilot plays
+//   PURPLE_NULL_SEED    rand() seed, replacing main.c's time-based one (default 1)
+//
+// Script lines are "<frame> press|hold|release <KEY>" or "<frame> type <TEXT>",
+// with KEY one of UP, DOWN, SPACE, ENTER, BACKSPACE, F3. '#' starts a comment.
+#define NULL_DEFAULT_FRAMES 36000
+#define NULL_DEFAULT_FPS 60
+#define NULL_MAX_EVENTS 4096
+#define NULL_MAX_CHARS 32
+#define NULL_MAX_KEYS 512
+#define NULL_FONT_GLYPHS 95   // Printable ASCII
+#define NULL_FONT_PADDING 4   // Atlas padding LoadFontEx uses
+#define AUTOPILOT_DEADZONE 10.0f
+#define AUTOPILOT_PERIOD 120  // Frames between SPACE / typed initial / ENTER
+
+typedef enum { EVENT_PRESS, EVENT_HOLD, EVENT_RELEASE, EVENT_TYPE } ScriptAction;
+
+typedef struct {
+    uint64_t frame;
+    ScriptAction action;
+    int key;       // Key for press/hold/release, codepoint for type
+} ScriptEvent;
+
+static struct {
+    int width;
+    int height;
+    uint64_t frameLimit;
+    double virtualFps;
+    uint64_t iteration;        // WindowShouldClose calls
+    uint64_t presented;        // EndDrawing calls
+    uint64_t drawCalls;
+    uint64_t startNs;
+
+    ScriptEvent events[NULL_MAX_EVENTS];
+    size_t eventCount;
+    size_t nextEvent;
+    bool scripted;
+
+    bool down[NULL_MAX_KEYS];
+    bool pressed[NULL_MAX_KEYS];
+    bool pendingPress[NULL_MAX_KEYS];
+    int chars[NULL_MAX_CHARS];
+    int charCount;
+    int charRead;
+    int pendingChars[NULL_MAX_CHARS];
+    int pendingCharCount;
+
+    bool paddleSeen;
+    bool ballSeen;
+    Vector2 paddle;
+    Vector2 paddleSize;
+    Vector2 ball;
+} core;
+
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t EnvCount(const char *name, uint64_t fallback)
+{
+    const char *value = getenv(name);
+    if (value == NULL || *value == '\0') return fallback;
+    char *end = NULL;
+    unsigned long long parsed = strtoull(value, &end, 10);
+    return (end != value && *end == '\0' && parsed > 0) ? (uint64_t)parsed : fallback;
+}
+
+static int ParseKeyName(const char *name)
+{
+    static const struct { const char *name; int key; } keys[] = {
+        { "UP", KEY_UP }, { "DOWN", KEY_DOWN }, { "SPACE", KEY_SPACE },
+        { "ENTER", KEY_ENTER }, { "BACKSPACE", KEY_BACKSPACE }, { "F3", KEY_F3 }
+    };
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); ++i) {
+        if (strcmp(name, keys[i].name) == 0) return keys[i].key;
+    }
+    return -1;
+}
+
+static void AddEvent(uint64_t frame, ScriptAction action, int key)
+{
+    if (core.eventCount >= NULL_MAX_EVENTS) return;
+    core.events[core.eventCount++] = (ScriptEvent){ frame, action, key };
+}
+
+static int CompareEvents(const void *a, const void *b)
+{
+    const ScriptEvent *ea = (const ScriptEvent *)a;
+    const ScriptEvent *eb = (const ScriptEvent *)b;
+    return (ea->frame > eb->frame) - (ea->frame < eb->frame);
+}
+
+static void LoadScript(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "rlnull: cannot open input script %s\n", path);
+        return;
+    }
+
+    char line[256];
+    int lineNumber = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        lineNumber++;
+        char *comment = strchr(line, '#');
+        if (comment != NULL) *comment = '\0';
+
+        unsigned long long frame = 0;
+        char action[16] = {0};
+        char argument[128] = {0};
+        int fields = sscanf(line, "%llu %15s %127s", &frame, action, argument);
+        if (fields <= 0) continue;  // Blank or comment-only line
+        if (fields != 3) {
+            fprintf(stderr, "rlnull: %s:%d: expected <frame> <action> <arg>\n", path, lineNumber);
+            continue;
+        }
+
+        if (strcmp(action, "type") == 0) {
+            for (const char *c = argument; *c; ++c) {
+                AddEvent((uint64_t)frame, EVENT_TYPE, (unsigned char)*c);
+            }
+            continue;
+        }
+        int key = ParseKeyName(argument);
+        ScriptAction parsed = EVENT_PRESS;
+        if (strcmp(action, "hold") == 0) parsed = EVENT_HOLD;
+        else if (strcmp(action, "release") == 0) parsed = EVENT_RELEASE;
+        else if (strcmp(action, "press") != 0) key = -1;
+        if (key < 0) {
+            fprintf(stderr, "rlnull: %s:%d: unknown action or key\n", path, lineNumber);
+            continue;
+        }
+        AddEvent((uint64_t)frame, parsed, key);
+    }
+    fclose(file);
+
+    // Stable order by frame keeps same-frame events in file order
+    for (size_t i = 1; i < core.eventCount; ++i) {
+        for (size_t j = i; j > 0 && CompareEvents(&core.events[j - 1], &core.events[j]) > 0; --j) {
+            ScriptEvent swap = core.events[j];
+            core.events[j] = core.events[j - 1];
+            core.events[j - 1] = swap;
+        }
+    }
+    core.scripted = true;
+}
+
+static void QueuePress(int key)
+{
+    core.pendingPress[key] = true;
+    core.down[key] = true;
+}
+
+static void QueueChar(int codepoint)
+{
+    if (core.pendingCharCount < NULL_MAX_CHARS) {
+        core.pendingChars[core.pendingCharCount++] = codepoint;
+    }
+}
+
+// Stage the script events due at this iteration
+static void RunScript(void)
+{
+    while (core.nextEvent < core.eventCount &&
+           core.events[core.nextEvent].frame <= core.iteration) {
+        const ScriptEvent *event = &core.events[core.nextEvent++];
+        switch (event->action) {
+            case EVENT_PRESS: QueuePress(event->key); break;
+            case EVENT_HOLD: core.down[event->key] = true; break;
+            case EVENT_RELEASE: core.down[event->key] = false; break;
+            case EVENT_TYPE: QueueChar(event->key); break;
+        }
+    }
+}
+
+// Track the ball drawn this frame with the left paddle
+static void SteerAutopilot(void)
+{
+    core.down[KEY_UP] = false;
+    core.down[KEY_DOWN] = false;
+    if (core.ballSeen && core.paddleSeen) {
+        float center = core.paddle.y + core.paddleSize.y / 2.0f;
+        if (core.ball.y < center - AUTOPILOT_DEADZONE) core.down[KEY_UP] = true;
+        if (core.ball.y > center + AUTOPILOT_DEADZONE) core.down[KEY_DOWN] = true;
+    }
+}
+
+// Periodically start a match, type an initial and submit it
+static void RunAutopilot(void)
+{
+    switch (core.iteration % AUTOPILOT_PERIOD) {
+        case 0: QueuePress(KEY_SPACE); break;
+        case AUTOPILOT_PERIOD / 3: QueueChar('N'); break;
+        case 2 * AUTOPILOT_PERIOD / 3: QueuePress(KEY_ENTER); break;
+        default: break;
+    }
+}
+
+void InitWindow(int width, int height, const char *title)
+{
+    (void)title;
+    core.width = width;
+    core.height = height;
+    core.frameLimit = EnvCount("PURPLE_NULL_FRAMES", NULL_DEFAULT_FRAMES);
+    core.virtualFps = (double)EnvCount("PURPLE_NULL_FPS", NULL_DEFAULT_FPS);
+
+    // main.c seeds from the wall clock just before InitWindow; reseed so
+    // headless runs (and captured frames) are reproducible
+    srand((unsigned int)EnvCount("PURPLE_NULL_SEED", 1));
+
+    const char *script = getenv("PURPLE_NULL_SCRIPT");
+    if (script != NULL && *script != '\0') LoadScript(script);
+    core.startNs = NowNs();
+}
+
+void CloseWindow(void)
+{
+    double wall = (double)(NowNs() - core.startNs) / 1.0e9;
+    printf("rlnull: %llu iterations, %llu frames presented, %llu draw calls\n",
+           (unsigned long long)core.iteration, (unsigned long long)core.presented,
+           (unsigned long long)core.drawCalls);
+    printf("rlnull: %.3f s wall, %.3f s virtual, %.0f iterations/s\n",
+           wall, (double)core.iteration / core.virtualFps,
+           (wall > 0.0) ? (double)core.iteration / wall : 0.0);
+    NullBackendReport();
+}
+
+bool WindowShouldClose(void)
+{
+    if (core.iteration >= core.frameLimit) return true;
+    core.iteration++;
+    if (core.scripted) {
+        RunScript();
+    } else {
+        RunAutopilot();
+    }
+    return false;
+}
+
+bool IsWindowReady(void) { return core.width > 0; }
+bool IsWindowHidden(void) { return false; }
+bool IsWindowMinimized(void) { return false; }
+bool IsWindowFocused(void) { return true; }
+bool IsWindowResized(void) { return false; }
+void SetConfigFlags(unsigned int flags) { (void)flags; }
+int GetCurrentMonitor(void) { return 0; }
+int GetMonitorRefreshRate(int monitor) { (void)monitor; return (int)core.virtualFps; }
+
+// Never sleeps; virtual time only advances per loop iteration
+void SetTargetFPS(int fps) { (void)fps; }
+void WaitTime(double seconds) { (void)seconds; }
+int GetFPS(void) { return (int)core.virtualFps; }
+float GetFrameTime(void) { return (float)(1.0 / core.virtualFps); }
+
+double GetTime(void)
+{
+    return (double)core.iteration / core.virtualFps;
+}
+
+void PollInputEvents(void)
+{
+    // Edges and characters are visible until the next poll, as in raylib
+    for (int key = 0; key < NULL_MAX_KEYS; ++key) {
+        core.pressed[key] = core.pendingPress[key];
+        core.pendingPress[key] = false;
+    }
+    memcpy(core.chars, core.pendingChars, sizeof(int) * (size_t)core.pendingCharCount);
+    core.charCount = core.pendingCharCount;
+    core.charRead = 0;
+    core.pendingCharCount = 0;
+}
+
+bool IsKeyPressed(int key)
+{
+    return key >= 0 && key < NULL_MAX_KEYS && core.pressed[key];
+}
+
+bool IsKeyDown(int key)
+{
+    return key >= 0 && key < NULL_MAX_KEYS && core.down[key];
+}
+
+int GetCharPressed(void)
+{
+    return (core.charRead < core.charCount) ? core.chars[core.charRead++] : 0;
+}
+
+void NullPresentFrame(void)
+{
+    core.presented++;
+    if (!core.scripted) SteerAutopilot();
+    PollInputEvents();
+    core.ballSeen = false;
+    core.paddleSeen = false;
+}
+
+void NullObserveRectangle(Vector2 position, Vector2 size)
+{
+    // The player's paddle is the first tall rectangle on the left half
+    if (!core.paddleSeen && size.y > size.x && position.x < (float)core.width / 2.0f) {
+        core.paddle = position;
+        core.paddleSize = size;
+        core.paddleSeen = true;
+    }
+}
+
+void NullObserveCircle(Vector2 center)
+{
+    core.ball = center;
+    core.ballSeen = true;
+}
+
+void NullCountDrawCall(void) { core.drawCalls++; }
+int NullScreenWidth(void) { return core.width; }
+int NullScreenHeight(void) { return core.height; }
+
+// raylib's built-in pixel font is not bundled: the default font is a
+// fixed-pitch face of empty cells, which drawing backends show as boxes
+Font GetFontDefault(void)
+{
+    static GlyphInfo glyphs[NULL_FONT_GLYPHS];
+    static Rectangle recs[NULL_FONT_GLYPHS];
+    const int baseSize = 10, advance = 6;
+    for (int i = 0; i < NULL_FONT_GLYPHS; ++i) {
+        glyphs[i] = (GlyphInfo){ .value = 32 + i, .advanceX = advance };
+        recs[i] = (Rectangle){ (float)(i * advance), 0.0f, (float)advance, (float)baseSize };
+    }
+    Font font = { .baseSize = baseSize, .glyphCount = NULL_FONT_GLYPHS, .glyphPadding = 0,
+                  .texture = { .id = 1, .width = NULL_FONT_GLYPHS * advance,
+                               .height = baseSize, .mipmaps = 1 },
+                  .recs = recs, .glyphs = glyphs };
+    return font;
+}
+
+// TrueType fonts load as raylib's do: LoadFontData (rlnull_font.c) rasterizes
+// the glyphs and GenImageFontAtlas packs them; anything else gets the default font
+Font LoadFontEx(const char *fileName, int fontSize, int *codepoints, int codepointCount)
+{
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(fileName, &dataSize);
+    Font font = LoadFontFromMemory(".ttf", data, dataSize, fontSize, codepoints, codepointCount);
+    UnloadFileData(data);
+    return font;
+}
+
+Font LoadFontFromMemory(const char *fileType, const unsigned char *fileData, int dataSize,
+                        int fontSize, int *codepoints, int codepointCount)
+{
+    (void)fileType;
+    int size = (fontSize > 0) ? fontSize : 32;
+    int count = (codepointCount > 0) ? codepointCount : NULL_FONT_GLYPHS;
+    Font font = { .baseSize = size, .glyphCount = count, .glyphPadding = NULL_FONT_PADDING };
+    font.glyphs = LoadFontData(fileData, dataSize, size, codepoints, count, FONT_DEFAULT);
+    if (font.glyphs == NULL) return GetFontDefault();
+
+    Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, count, size, font.glyphPadding, 0);
+    for (int i = 0; i < count; ++i) {
+        UnloadImage(font.glyphs[i].image);
+        font.glyphs[i].image = (Image){0};
+    }
+    if (atlas.data == NULL) {
+        UnloadFontData(font.glyphs, count);
+        return GetFontDefault();
+    }
+    font.texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    return font;
+}
+
+void UnloadFont(Font font)
+{
+    if (font.glyphs == NULL || font.texture.id <= 1) return;  // Default font is static
+    UnloadTexture(font.texture);
+    UnloadFontData(font.glyphs, font.glyphCount);
+    free(font.recs);
+}
+
+// Memory and files, so fontcache.c bakes and caches the face for real
+void *MemAlloc(unsigned int size) { return calloc(size, 1); }
+void MemFree(void *ptr) { free(ptr); }
+
+// Same "LEVEL: message" lines as raylib's default logger
+void TraceLog(int logLevel, const char *text, ...)
+{
+    static const char *const levels[] = { "", "TRACE", "DEBUG", "INFO", "WARNING", "ERROR", "FATAL" };
+    if (text == NULL || logLevel < LOG_INFO || logLevel > LOG_FATAL) return;
+    va_list args;
+    va_start(args, text);
+    printf("%s: ", levels[logLevel]);
+    vprintf(text, args);
+    printf("\n");
+    va_end(args);
+}
+
+unsigned char *LoadFileData(const char *fileName, int *dataSize)
+{
+    if (dataSize != NULL) *dataSize = 0;
+    if (fileName == NULL) return NULL;
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return NULL;
+
+    unsigned char *data = NULL;
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0) size = ftell(file);
+    if (size > 0 && size <= INT_MAX && fseek(file, 0, SEEK_SET) == 0) {
+        data = malloc((size_t)size);
+        if (data != NULL && fread(data, 1, (size_t)size, file) != (size_t)size) {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(file);
+    if (data != NULL && dataSize != NULL) *dataSize = (int)size;
+    return data;
+}
+
+void UnloadFileData(unsigned char *data) { free(data); }
+
+void UnloadImage(Image image) { free(image.data); }
+
+void UnloadFontData(GlyphInfo *glyphs, int glyphCount)
+{
+    if (glyphs == NULL) return;
+    for (int i = 0; i < glyphCount; ++i) UnloadImage(glyphs[i].image);
+    free(glyphs);
+}
+
+// Packs glyphs left to right on one row. Glyph images are GRAYSCALE, as
+// LoadFontData makes them; the atlas is white with their values as alpha.
+Image GenImageFontAtlas(const GlyphInfo *glyphs, Rectangle **glyphRecs, int glyphCount,
+                        int fontSize, int padding, int packMethod)
+{
+    (void)fontSize;
+    (void)packMethod;
+    Image atlas = {0};
+    if (glyphs == NULL || glyphRecs == NULL || glyphCount <= 0) return atlas;
+
+    int width = padding;
+    int tallest = 0;
+    for (int i = 0; i < glyphCount; ++i) {
+        width += glyphs[i].image.width + padding;
+        if (glyphs[i].image.height > tallest) tallest = glyphs[i].image.height;
+    }
+    int height = tallest + 2 * padding;
+    Rectangle *recs = calloc((size_t)glyphCount, sizeof(Rectangle));
+    unsigned char *pixels = calloc((size_t)width * (size_t)height, 2u);
+    if (recs == NULL || pixels == NULL) {
+        free(recs);
+        free(pixels);
+        return atlas;
+    }
+
+    int x = padding;
+    for (int i = 0; i < glyphCount; ++i) {
+        const Image *image = &glyphs[i].image;
+        const unsigned char *in = (const unsigned char *)image->data;
+        for (int y = 0; in != NULL && y < image->height; ++y) {
+            unsigned char *out = &pixels[((size_t)(y + padding) * (size_t)width + (size_t)x) * 2u];
+            for (int gx = 0; gx < image->width; ++gx) {
+                out[2 * gx] = 255;
+                out[2 * gx + 1] = in[(size_t)y * (size_t)image->width + (size_t)gx];
+            }
+        }
+        recs[i] = (Rectangle){ (float)x, (float)padding, (float)image->width, (float)image->height };
+        x += image->width + padding;
+    }
+    *glyphRecs = recs;
+    atlas = (Image){ .data = pixels, .width = width, .height = height, .mipmaps = 1,
+                     .format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA };
+    return atlas;
+}
+
+int GetCodepointNext(const char *text, int *codepointSize)
+{
+    const unsigned char *p = (const unsigned char *)text;
+    int size = 1;
+    int codepoint = p[0];
+    if (p[0] >= 0xf0) size = 4;
+    else if (p[0] >= 0xe0) size = 3;
+    else if (p[0] >= 0xc0) size = 2;
+    if (size > 1) {
+        // Everything outside ASCII renders as '?'
+        for (int i = 1; i < size; ++i) {
+            if ((p[i] & 0xc0) != 0x80) { size = i; break; }
+        }
+        codepoint = '?';
+    }
+    if (codepointSize != NULL) *codepointSize = size;
+    return codepoint;
+}
+
+int GetGlyphIndex(Font font, int codepoint)
+{
+    for (int i = 0; i < font.glyphCount; ++i) {
+        if (font.glyphs[i].value == codepoint) return i;
+    }
+    return ('?' - 32 < font.glyphCount) ? '?' - 32 : 0;
+}
+
+Vector2 MeasureTextEx(Font font, const char *text, float fontSize, float spacing)
+{
+    Vector2 size = { 0.0f, fontSize };
+    if (text == NULL || font.glyphs == NULL || font.baseSize <= 0) return size;
+
+    float scale = fontSize / (float)font.baseSize;
+    float width = 0.0f;
+    float widest = 0.0f;
+    int count = 0;
+    int widestCount = 0;
+    for (int i = 0; text[i] != '\0';) {
+        int bytes = 0;
+        int codepoint = GetCodepointNext(&text[i], &bytes);
+        i += bytes;
+        if (codepoint == '\n') {
+            if (width > widest) { widest = width; widestCount = count; }
+            width = 0.0f;
+            count = 0;
+            size.y += fontSize;
+            continue;
+        }
+        width += (float)font.glyphs[GetGlyphIndex(font, codepoint)].advanceX;
+        count++;
+    }
+    if (width > widest) { widest = width; widestCount = count; }
+    size.x = widest * scale + (float)((widestCount > 0) ? widestCount - 1 : 0) * spacing;
+    return size;
+}
@@ -0,0 +1,34 @@
+/* =========================================================================
+    Purple - Platform
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: rlnull.h
+    Description: Shared state between the headless raylib core and its
+                 drawing backends (null or software)
+========================================================================= */
+
+#ifndef RLNULL_H
+#define RLNULL_H
+
+#include <raylib/raylib.h>
+
+// Called by a drawing backend's EndDrawing: counts the frame and polls
+// scripted input, like raylib's own EndDrawing does
+void NullPresentFrame(void);
+
+// Scene observations that drive the autopilot input when no script is set
+void NullObserveRectangle(Vector2 position, Vector2 size);
+void NullObserveCircle(Vector2 center);
+
+// Draw call counter reported at CloseWindow
+void NullCountDrawCall(void);
+
+// Called from CloseWindow so the drawing backend can report its own results
+void NullBackendReport(void);
+
+// Window size given to InitWindow
+int NullScreenWidth(void);
+int NullScreenHeight(void);
+
+#endif // RLNULL_H
@@ -0,0 +1,119 @@
+/* =========================================================================
+    Purple - Platform
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: rlnull_draw.c
+    Description: Null drawing backend: every draw call is counted and dropped
+========================================================================= */
+
+#include "rlnull.h"
+#include <raylib/rlgl.h>
+
+static unsigned int nextTextureId = 16;
+
+void NullBackendReport(void) {}
+
+void BeginDrawing(void) {}
+void EndDrawing(void) { NullPresentFrame(); }
+void BeginTextureMode(RenderTexture2D target) { (void)target; }
+void EndTextureMode(void) {}
+void BeginBlendMode(int mode) { (void)mode; }
+void EndBlendMode(void) {}
+
+void rlSetBlendFactorsSeparate(int glSrcRGB, int glDstRGB, int glSrcAlpha, int glDstAlpha,
+                               int glEqRGB, int glEqAlpha)
+{
+    (void)glSrcRGB; (void)glDstRGB; (void)glSrcAlpha;
+    (void)glDstAlpha; (void)glEqRGB; (void)glEqAlpha;
+}
+
+RenderTexture2D LoadRenderTexture(int width, int height)
+{
+    unsigned int id = nextTextureId++;
+    RenderTexture2D target = {
+        .id = id,
+        .texture = { .id = id, .width = width, .height = height, .mipmaps = 1 }
+    };
+    return target;
+}
+
+void UnloadRenderTexture(RenderTexture2D target) { (void)target; }
+
+Texture2D LoadTextureFromImage(Image image)
+{
+    return (Texture2D){ .id = nextTextureId++, .width = image.width, .height = image.height,
+                        .mipmaps = 1, .format = image.format };
+}
+
+void UnloadTexture(Texture2D texture) { (void)texture; }
+void SetTextureFilter(Texture2D texture, int filter) { (void)texture; (void)filter; }
+
+Shader LoadShaderFromMemory(const char *vsCode, const char *fsCode)
+{
+    (void)vsCode;
+    (void)fsCode;
+    return (Shader){ .id = 1 };
+}
+
+void UnloadShader(Shader shader) { (void)shader; }
+void BeginShaderMode(Shader shader) { (void)shader; }
+void EndShaderMode(void) {}
+
+void ClearBackground(Color color)
+{
+    (void)color;
+    NullCountDrawCall();
+}
+
+void DrawLineV(Vector2 startPos, Vector2 endPos, Color color)
+{
+    (void)startPos; (void)endPos; (void)color;
+    NullCountDrawCall();
+}
+
+void DrawCircleV(Vector2 center, float radius, Color color)
+{
+    (void)radius; (void)color;
+    NullObserveCircle(center);
+    NullCountDrawCall();
+}
+
+void DrawRectangle(int posX, int posY, int width, int height, Color color)
+{
+    (void)posX; (void)posY; (void)width; (void)height; (void)color;
+    NullCountDrawCall();
+}
+
+void DrawRectangleV(Vector2 position, Vector2 size, Color color)
+{
+    (void)color;
+    NullObserveRectangle(position, size);
+    NullCountDrawCall();
+}
+
+void DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint)
+{
+    (void)texture; (void)source; (void)position; (void)tint;
+    NullCountDrawCall();
+}
+
+void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin,
+                    float rotation, Color tint)
+{
+    (void)texture; (void)source; (void)dest; (void)origin; (void)rotation; (void)tint;
+    NullCountDrawCall();
+}
+
+void DrawText(const char *text, int posX, int posY, int fontSize, Color color)
+{
+    (void)text; (void)posX; (void)posY; (void)fontSize; (void)color;
+    NullCountDrawCall();
+}
+
+void DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, float spacing,
+                Color tint)
+{
+    (void)font; (void)text; (void)position; (void)fontSize; (void)spacing; (void)tint;
+    NullCountDrawCall();
+}
@@ -0,0 +1,601 @@
+/* =========================================================================
+    Purple - Platform
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: rlnull_font.c
+    Description: Headless LoadFontData: TrueType outlines rasterized into
+                 coverage or signed-distance glyph bitmaps, with the same
+                 metrics raylib gets from stb_truetype
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "rlnull.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Only 'glyf' outlines and format 4 (BMP) character maps are read; that
+// covers the bundled Orbitron face. Variable fonts draw their default
+// instance. Values below mirror raylib's text module.
+#define TTF_DEFAULT_GLYPHS 95         // Printable ASCII when no codepoints are given
+#define TTF_SDF_PADDING 4             // FONT_SDF_CHAR_PADDING
+#define TTF_SDF_ON_EDGE 128           // FONT_SDF_ON_EDGE_VALUE
+#define TTF_SDF_DIST_SCALE 64.0f      // FONT_SDF_PIXEL_DIST_SCALE
+#define TTF_BITMAP_THRESHOLD 80       // FONT_BITMAP_ALPHA_THRESHOLD
+#define TTF_SUBSCANLINES 4            // Coverage samples per pixel row
+#define TTF_CURVE_TOLERANCE 0.05f     // Pixels a flattened curve may stray
+#define TTF_MAX_CURVE_SEGMENTS 32
+#define TTF_MAX_COMPONENT_DEPTH 8
+
+typedef struct {
+    const unsigned char *data;
+    size_t cmap;          // Format 4 subtable, 0 if the face has none
+    size_t cmapEnd;
+    size_t loca;
+    size_t glyf;
+    size_t glyfLength;
+    size_t hmtx;
+    int glyphCount;
+    int metricCount;
+    bool longLoca;
+    int ascent;           // hhea, in font units
+    int descent;
+} TtfFace;
+
+// Affine map from font units to bitmap pixels: x' = a x + c y + e, y' = b x + d y + f
+typedef struct {
+    float a, b, c, d, e, f;
+} TtfTransform;
+
+typedef struct {
+    float x0, y0, x1, y1;  // Bitmap pixels, y down
+} TtfEdge;
+
+typedef struct {
+    TtfEdge *edges;
+    int count;
+    int capacity;
+} TtfEdgeList;
+
+typedef struct {
+    float x;
+    float y;
+    bool onCurve;
+} TtfPoint;
+
+typedef struct {
+    float x;
+    int dir;
+} TtfCrossing;
+
+static uint16_t U16(const unsigned char *p)
+{
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static int16_t I16(const unsigned char *p)
+{
+    return (int16_t)U16(p);
+}
+
+static uint32_t U32(const unsigned char *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static bool FindTable(const unsigned char *data, size_t size, const char *tag, size_t minLength,
+                      size_t *offset, size_t *length)
+{
+    if (size < 12) return false;
+    size_t tables = U16(data + 4);
+    if (12 + 16 * tables > size) return false;
+    for (size_t i = 0; i < tables; ++i) {
+        const unsigned char *record = data + 12 + 16 * i;
+        if (memcmp(record, tag, 4) != 0) continue;
+        size_t start = U32(record + 8), bytes = U32(record + 12);
+        if (start > size || bytes > size - start || bytes < minLength) return false;
+        *offset = start;
+        *length = bytes;
+        return true;
+    }
+    return false;
+}
+
+// Unicode BMP map: Windows (3,1) preferred, then any Unicode platform subtable
+static void FindCharacterMap(TtfFace *face, size_t cmap, size_t length)
+{
+    if (length < 14) return;
+    const unsigned char *table = face->data + cmap;
+    size_t subtables = U16(table + 2);
+    if (4 + 8 * subtables > length) return;
+    for (int pass = 0; pass < 2 && face->cmap == 0; ++pass) {
+        for (size_t i = 0; i < subtables; ++i) {
+            const unsigned char *record = table + 4 + 8 * i;
+            uint16_t platform = U16(record), encoding = U16(record + 2);
+            bool wanted = (pass == 0) ? (platform == 3 && encoding == 1) : (platform == 0);
+            size_t start = U32(record + 4);
+            if (!wanted || start > length - 14 || U16(table + start) != 4) continue;
+            size_t bytes = U16(table + start + 2);
+            size_t segments = U16(table + start + 6) / 2u;
+            if (bytes > length - start || 16 + 8 * segments > bytes) continue;
+            face->cmap = cmap + start;
+            face->cmapEnd = cmap + start + bytes;
+            break;
+        }
+    }
+}
+
+static bool InitFace(TtfFace *face, const unsigned char *data, size_t size)
+{
+    size_t head, hhea, maxp, cmap, loca, hmtx, length;
+    size_t headLength, hheaLength, maxpLength, cmapLength, locaLength, hmtxLength;
+    memset(face, 0, sizeof(*face));
+    face->data = data;
+    if (!FindTable(data, size, "head", 54, &head, &headLength) ||
+        !FindTable(data, size, "hhea", 36, &hhea, &hheaLength) ||
+        !FindTable(data, size, "maxp", 6, &maxp, &maxpLength) ||
+        !FindTable(data, size, "cmap", 4, &cmap, &cmapLength) ||
+        !FindTable(data, size, "loca", 0, &loca, &locaLength) ||
+        !FindTable(data, size, "hmtx", 4, &hmtx, &hmtxLength) ||
+        !FindTable(data, size, "glyf", 0, &face->glyf, &length)) {
+        return false;
+    }
+    face->glyfLength = length;
+    face->loca = loca;
+    face->hmtx = hmtx;
+    face->longLoca = I16(data + head + 50) != 0;
+    face->glyphCount = U16(data + maxp + 4);
+    face->ascent = I16(data + hhea + 4);
+    face->descent = I16(data + hhea + 6);
+    face->metricCount = U16(data + hhea + 34);
+    size_t locaEntry = face->longLoca ? 4u : 2u;
+    if (face->glyphCount == 0 || face->metricCount == 0 || face->ascent <= face->descent ||
+        locaLength < ((size_t)face->glyphCount + 1) * locaEntry ||
+        hmtxLength < (size_t)face->metricCount * 4u) {
+        return false;
+    }
+    FindCharacterMap(face, cmap, cmapLength);
+    return face->cmap != 0;
+}
+
+static int GlyphIndex(const TtfFace *face, int codepoint)
+{
+    if (codepoint < 0 || codepoint > 0xffff) return 0;
+    const unsigned char *table = face->data + face->cmap;
+    size_t segments = U16(table + 6) / 2u;
+    const unsigned char *ends = table + 14;
+    const unsigned char *starts = ends + 2 * segments + 2;
+    const unsigned char *deltas = starts + 2 * segments;
+    const unsigned char *ranges = deltas + 2 * segments;
+    for (size_t i = 0; i < segments; ++i) {
+        if (codepoint > U16(ends + 2 * i)) continue;
+        int start = U16(starts + 2 * i);
+        if (codepoint < start) return 0;
+        int delta = I16(deltas + 2 * i);
+        size_t rangeOffset = U16(ranges + 2 * i);
+        if (rangeOffset == 0) return (codepoint + delta) & 0xffff;
+        size_t at = (size_t)(ranges + 2 * i - face->data) + rangeOffset +
+                    2u * (size_t)(codepoint - start);
+        if (at + 2 > face->cmapEnd) return 0;
+        int glyph = U16(face->data + at);
+        return (glyph == 0) ? 0 : (glyph + delta) & 0xffff;
+    }
+    return 0;
+}
+
+static int AdvanceWidth(const TtfFace *face, int glyph)
+{
+    int metric = (glyph < face->metricCount) ? glyph : face->metricCount - 1;
+    return U16(face->data + face->hmtx + 4 * (size_t)metric);
+}
+
+// Byte range of a glyph inside 'glyf'; empty for glyphs without an outline
+static bool GlyphRange(const TtfFace *face, int glyph, size_t *start, size_t *end)
+{
+    if (glyph < 0 || glyph >= face->glyphCount) return false;
+    const unsigned char *loca = face->data + face->loca;
+    if (face->longLoca) {
+        *start = U32(loca + 4 * (size_t)glyph);
+        *end = U32(loca + 4 * (size_t)glyph + 4);
+    } else {
+        *start = 2u * U16(loca + 2 * (size_t)glyph);
+        *end = 2u * U16(loca + 2 * (size_t)glyph + 2);
+    }
+    return *start <= *end && *end <= face->glyfLength;
+}
+
+static bool AddEdge(TtfEdgeList *list, float x0, float y0, float x1, float y1)
+{
+    if (list->count == list->capacity) {
+        int capacity = (list->capacity > 0) ? list->capacity * 2 : 64;
+        TtfEdge *edges = realloc(list->edges, (size_t)capacity * sizeof(TtfEdge));
+        if (edges == NULL) return false;
+        list->edges = edges;
+        list->capacity = capacity;
+    }
+    list->edges[list->count++] = (TtfEdge){ x0, y0, x1, y1 };
+    return true;
+}
+
+static bool AddCurve(TtfEdgeList *list, TtfPoint p0, TtfPoint p1, TtfPoint p2)
+{
+    // A quadratic strays at most |p0 - 2 p1 + p2| / 4 from its chord, and
+    // n segments cut that by n squared
+    float bendX = p0.x - 2.0f * p1.x + p2.x, bendY = p0.y - 2.0f * p1.y + p2.y;
+    float bend = sqrtf(bendX * bendX + bendY * bendY);
+    int segments = (int)ceilf(sqrtf(bend / (4.0f * TTF_CURVE_TOLERANCE)));
+    if (segments < 1) segments = 1;
+    if (segments > TTF_MAX_CURVE_SEGMENTS) segments = TTF_MAX_CURVE_SEGMENTS;
+    float x = p0.x, y = p0.y;
+    for (int i = 1; i <= segments; ++i) {
+        float t = (float)i / (float)segments, u = 1.0f - t;
+        float nx = u * u * p0.x + 2.0f * u * t * p1.x + t * t * p2.x;
+        float ny = u * u * p0.y + 2.0f * u * t * p1.y + t * t * p2.y;
+        if (!AddEdge(list, x, y, nx, ny)) return false;
+        x = nx;
+        y = ny;
+    }
+    return true;
+}
+
+// One closed contour; off-curve neighbours imply an on-curve point between them
+static bool AddContour(TtfEdgeList *list, const TtfPoint *points, int count, TtfPoint *scratch)
+{
+    if (count < 2) return true;
+    int expanded = 0;
+    for (int i = 0; i < count; ++i) {
+        TtfPoint p = points[i], next = points[(i + 1) % count];
+        scratch[expanded++] = p;
+        if (!p.onCurve && !next.onCurve) {
+            scratch[expanded++] = (TtfPoint){ (p.x + next.x) / 2.0f, (p.y + next.y) / 2.0f, true };
+        }
+    }
+    int first = 0;
+    while (first < expanded && !scratch[first].onCurve) ++first;
+    if (first == expanded) return true;
+
+    TtfPoint pen = scratch[first];
+    for (int step = 1; step <= expanded; ++step) {
+        TtfPoint p = scratch[(first + step) % expanded];
+        if (p.onCurve) {
+            if (!AddEdge(list, pen.x, pen.y, p.x, p.y)) return false;
+            pen = p;
+        } else {
+            TtfPoint end = scratch[(first + step + 1) % expanded];
+            if (!AddCurve(list, pen, p, end)) return false;
+            pen = end;
+            ++step;
+        }
+    }
+    return true;
+}
+
+static bool AddSimpleGlyph(TtfEdgeList *list, const unsigned char *glyph, const unsigned char *end,
+                           int contours, const TtfTransform *transform)
+{
+    const unsigned char *p = glyph + 10;
+    if (p + 2 * (size_t)contours + 2 > end) return false;
+    const unsigned char *endPoints = p;
+    int count = U16(endPoints + 2 * (size_t)(contours - 1)) + 1;
+    p += 2 * (size_t)contours;
+    size_t instructions = U16(p);
+    p += 2;
+    if ((size_t)(end - p) < instructions) return false;
+    p += instructions;
+
+    TtfPoint *points = malloc((size_t)count * 3u * sizeof(TtfPoint));
+    unsigned char *flags = malloc((size_t)count);
+    bool ok = points != NULL && flags != NULL;
+    for (int i = 0; ok && i < count;) {
+        ok = p < end;
+        if (!ok) break;
+        unsigned char flag = *p++;
+        int repeat = 0;
+        if (flag & 8) {
+            ok = p < end;
+            if (ok) repeat = *p++;
+        }
+        for (int r = 0; r <= repeat && i < count; ++r) flags[i++] = flag;
+    }
+    // Coordinates are deltas: short ones carry a sign flag, long ones may be omitted
+    for (int axis = 0; ok && axis < 2; ++axis) {
+        unsigned char shortBit = (axis == 0) ? 2 : 4, sameBit = (axis == 0) ? 16 : 32;
+        int value = 0;
+        for (int i = 0; i < count; ++i) {
+            if (flags[i] & shortBit) {
+                if (p >= end) { ok = false; break; }
+                value += (flags[i] & sameBit) ? *p : -*p;
+                p += 1;
+            } else if (!(flags[i] & sameBit)) {
+                if (p + 2 > end) { ok = false; break; }
+                value += I16(p);
+                p += 2;
+            }
+            if (axis == 0) points[i].x = (float)value;
+            else points[i].y = (float)value;
+        }
+    }
+    for (int i = 0; ok && i < count; ++i) {
+        float fx = points[i].x, fy = points[i].y;
+        points[i] = (TtfPoint){ transform->a * fx + transform->c * fy + transform->e,
+                                transform->b * fx + transform->d * fy + transform->f,
+                                (flags[i] & 1) != 0 };
+    }
+
+    int start = 0;
+    for (int c = 0; ok && c < contours; ++c) {
+        int last = U16(endPoints + 2 * (size_t)c);
+        ok = last >= start && last < count;
+        if (ok) ok = AddContour(list, &points[start], last - start + 1, &points[count]);
+        start = last + 1;
+    }
+    free(points);
+    free(flags);
+    return ok;
+}
+
+static bool AddGlyph(TtfEdgeList *list, const TtfFace *face, int glyph,
+                     const TtfTransform *transform, int depth);
+
+// Composite glyphs place transformed copies of other glyphs
+static bool AddCompositeGlyph(TtfEdgeList *list, const TtfFace *face, const unsigned char *p,
+                              const unsigned char *end, const TtfTransform *parent, int depth)
+{
+    bool more = true;
+    while (more) {
+        if (p + 4 > end) return false;
+        uint16_t flags = U16(p), component = U16(p + 2);
+        p += 4;
+        TtfTransform m = { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f };
+        if (flags & 1) {
+            if (p + 4 > end) return false;
+            if (flags & 2) {
+                m.e = (float)I16(p);
+                m.f = (float)I16(p + 2);
+            }
+            p += 4;
+        } else {
+            if (p + 2 > end) return false;
+            if (flags & 2) {
+                m.e = (float)(int8_t)p[0];
+                m.f = (float)(int8_t)p[1];
+            }
+            p += 2;
+        }
+        // Scales are F2Dot14
+        if (flags & 8) {
+            if (p + 2 > end) return false;
+            m.a = m.d = (float)I16(p) / 16384.0f;
+            p += 2;
+        } else if (flags & 0x40) {
+            if (p + 4 > end) return false;
+            m.a = (float)I16(p) / 16384.0f;
+            m.d = (float)I16(p + 2) / 16384.0f;
+            p += 4;
+        } else if (flags & 0x80) {
+            if (p + 8 > end) return false;
+            m.a = (float)I16(p) / 16384.0f;
+            m.b = (float)I16(p + 2) / 16384.0f;
+            m.c = (float)I16(p + 4) / 16384.0f;
+            m.d = (float)I16(p + 6) / 16384.0f;
+            p += 8;
+        }
+        TtfTransform child = {
+            parent->a * m.a + parent->c * m.b, parent->b * m.a + parent->d * m.b,
+            parent->a * m.c + parent->c * m.d, parent->b * m.c + parent->d * m.d,
+            parent->a * m.e + parent->c * m.f + parent->e,
+            parent->b * m.e + parent->d * m.f + parent->f
+        };
+        if (!AddGlyph(list, face, component, &child, depth + 1)) return false;
+        more = (flags & 0x20) != 0;
+    }
+    return true;
+}
+
+static bool AddGlyph(TtfEdgeList *list, const TtfFace *face, int glyph,
+                     const TtfTransform *transform, int depth)
+{
+    size_t start, end;
+    if (depth > TTF_MAX_COMPONENT_DEPTH || !GlyphRange(face, glyph, &start, &end)) return false;
+    if (end - start < 10) return true;  // No outline
+    const unsigned char *base = face->data + face->glyf;
+    int contours = I16(base + start);
+    if (contours > 0) {
+        return AddSimpleGlyph(list, base + start, base + end, contours, transform);
+    }
+    if (contours < 0) {
+        return AddCompositeGlyph(list, face, base + start + 10, base + end, transform, depth);
+    }
+    return true;
+}
+
+static void AddSpan(float *row, int width, float from, float to, float weight)
+{
+    if (from < 0.0f) from = 0.0f;
+    if (to > (float)width) to = (float)width;
+    if (to <= from) return;
+    int first = (int)from, last = (int)to;
+    if (first == last) {
+        row[first] += (to - from) * weight;
+        return;
+    }
+    row[first] += ((float)(first + 1) - from) * weight;
+    for (int x = first + 1; x < last; ++x) row[x] += weight;
+    if (last < width) row[last] += (to - (float)last) * weight;
+}
+
+// Edges crossing the horizontal line at y, sorted left to right
+static int FindCrossings(const TtfEdgeList *list, float y, TtfCrossing *crossings)
+{
+    int count = 0;
+    for (int i = 0; i < list->count; ++i) {
+        const TtfEdge *edge = &list->edges[i];
+        if (edge->y0 == edge->y1) continue;
+        float low = fminf(edge->y0, edge->y1), high = fmaxf(edge->y0, edge->y1);
+        if (y < low || y >= high) continue;
+        float x = edge->x0 + (y - edge->y0) * (edge->x1 - edge->x0) / (edge->y1 - edge->y0);
+        int dir = (edge->y1 > edge->y0) ? 1 : -1;
+        int at = count++;
+        while (at > 0 && crossings[at - 1].x > x) {
+            crossings[at] = crossings[at - 1];
+            --at;
+        }
+        crossings[at] = (TtfCrossing){ x, dir };
+    }
+    return count;
+}
+
+// Area coverage under the nonzero rule: exact across a row, sampled down it
+static bool RasterizeCoverage(const TtfEdgeList *list, int width, int height, unsigned char *out)
+{
+    float *row = malloc(((size_t)width + 1) * sizeof(float));
+    TtfCrossing *crossings = malloc(((size_t)list->count + 1) * sizeof(TtfCrossing));
+    if (row == NULL || crossings == NULL) {
+        free(row);
+        free(crossings);
+        return false;
+    }
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x <= width; ++x) row[x] = 0.0f;
+        for (int s = 0; s < TTF_SUBSCANLINES; ++s) {
+            float sy = (float)y + ((float)s + 0.5f) / (float)TTF_SUBSCANLINES;
+            int count = FindCrossings(list, sy, crossings);
+            int winding = 0;
+            float from = 0.0f;
+            for (int i = 0; i < count; ++i) {
+                int before = winding;
+                winding += crossings[i].dir;
+                if (before == 0 && winding != 0) from = crossings[i].x;
+                if (before != 0 && winding == 0) {
+                    AddSpan(row, width, from, crossings[i].x, 1.0f / (float)TTF_SUBSCANLINES);
+                }
+            }
+        }
+        for (int x = 0; x < width; ++x) {
+            float value = row[x] * 255.0f + 0.5f;
+            out[(size_t)y * (size_t)width + (size_t)x] =
+                (unsigned char)((value > 255.0f) ? 255.0f : value);
+        }
+    }
+    free(row);
+    free(crossings);
+    return true;
+}
+
+// Distance to the outline at each pixel centre, positive inside, as stb_truetype encodes it
+static void RasterizeDistance(const TtfEdgeList *list, int width, int height, unsigned char *out)
+{
+    for (int y = 0; y < height; ++y) {
+        float py = (float)y + 0.5f;
+        for (int x = 0; x < width; ++x) {
+            float px = (float)x + 0.5f;
+            float nearest = INFINITY;
+            int winding = 0;
+            for (int i = 0; i < list->count; ++i) {
+                const TtfEdge *edge = &list->edges[i];
+                float dx = edge->x1 - edge->x0, dy = edge->y1 - edge->y0;
+                float length = dx * dx + dy * dy;
+                float t = (length > 0.0f) ? ((px - edge->x0) * dx + (py - edge->y0) * dy) / length
+                                          : 0.0f;
+                t = fminf(fmaxf(t, 0.0f), 1.0f);
+                float ex = edge->x0 + t * dx - px, ey = edge->y0 + t * dy - py;
+                nearest = fminf(nearest, ex * ex + ey * ey);
+                if (dy != 0.0f && py >= fminf(edge->y0, edge->y1) &&
+                    py < fmaxf(edge->y0, edge->y1) &&
+                    edge->x0 + (py - edge->y0) * dx / dy > px) {
+                    winding += (dy > 0.0f) ? 1 : -1;
+                }
+            }
+            float distance = sqrtf(nearest);
+            if (winding == 0) distance = -distance;
+            float value = (float)TTF_SDF_ON_EDGE + TTF_SDF_DIST_SCALE * distance;
+            out[(size_t)y * (size_t)width + (size_t)x] =
+                (unsigned char)fminf(fmaxf(value, 0.0f), 255.0f);
+        }
+    }
+}
+
+// Glyph bitmap and offsets; the box is the glyph's bounds rounded outwards
+static bool RasterizeGlyph(const TtfFace *face, int glyph, float scale, int type,
+                           GlyphInfo *info)
+{
+    size_t start, end;
+    if (!GlyphRange(face, glyph, &start, &end)) return false;
+    if (end - start < 10) return true;
+    const unsigned char *header = face->data + face->glyf + start;
+    int padding = (type == FONT_SDF) ? TTF_SDF_PADDING : 0;
+    int x0 = (int)floorf((float)I16(header + 2) * scale) - padding;
+    int y0 = (int)floorf(-(float)I16(header + 8) * scale) - padding;
+    int x1 = (int)ceilf((float)I16(header + 6) * scale) + padding;
+    int y1 = (int)ceilf(-(float)I16(header + 4) * scale) + padding;
+    if (x1 <= x0 || y1 <= y0) return true;
+
+    TtfEdgeList list = {0};
+    TtfTransform transform = { scale, 0.0f, 0.0f, -scale, (float)-x0, (float)-y0 };
+    int width = x1 - x0, height = y1 - y0;
+    unsigned char *pixels = calloc((size_t)width * (size_t)height, 1);
+    bool ok = pixels != NULL && AddGlyph(&list, face, glyph, &transform, 0);
+    if (ok && type == FONT_SDF) {
+        RasterizeDistance(&list, width, height, pixels);
+    } else if (ok) {
+        ok = RasterizeCoverage(&list, width, height, pixels);
+    }
+    if (ok && type == FONT_BITMAP) {
+        size_t count = (size_t)width * (size_t)height;
+        for (size_t i = 0; i < count; ++i) {
+            pixels[i] = (pixels[i] < TTF_BITMAP_THRESHOLD) ? 0 : 255;
+        }
+    }
+    free(list.edges);
+    if (!ok) {
+        free(pixels);
+        return false;
+    }
+    info->offsetX = x0;
+    info->offsetY = y0;
+    info->image = (Image){ .data = pixels, .width = width, .height = height, .mipmaps = 1,
+                           .format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE };
+    return true;
+}
+
+GlyphInfo *LoadFontData(const unsigned char *fileData, int dataSize, int fontSize,
+                        int *codepoints, int codepointCount, int type)
+{
+    TtfFace face;
+    if (fileData == NULL || dataSize <= 0 || fontSize <= 0 ||
+        !InitFace(&face, fileData, (size_t)dataSize)) {
+        return NULL;
+    }
+    int count = (codepointCount > 0) ? codepointCount : TTF_DEFAULT_GLYPHS;
+    GlyphInfo *glyphs = calloc((size_t)count, sizeof(GlyphInfo));
+    if (glyphs == NULL) return NULL;
+
+    // Pixel height spans ascender to descender, as stbtt_ScaleForPixelHeight
+    float scale = (float)fontSize / (float)(face.ascent - face.descent);
+    for (int i = 0; i < count; ++i) {
+        int codepoint = (codepoints != NULL) ? codepoints[i] : 32 + i;
+        int glyph = GlyphIndex(&face, codepoint);
+        GlyphInfo *info = &glyphs[i];
+        info->value = codepoint;
+        info->advanceX = (int)((float)AdvanceWidth(&face, glyph) * scale);
+        bool ok = true;
+        if (codepoint == ' ') {
+            // raylib gives the space an empty cell for atlas packing
+            unsigned char *pixels = calloc((size_t)info->advanceX * (size_t)fontSize, 1);
+            ok = pixels != NULL;
+            info->image = (Image){ .data = pixels, .width = info->advanceX, .height = fontSize,
+                                   .mipmaps = 1, .format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE };
+        } else {
+            ok = RasterizeGlyph(&face, glyph, scale, type, info);
+        }
+        if (!ok) {
+            UnloadFontData(glyphs, i + 1);
+            return NULL;
+        }
+        info->offsetY += (int)((float)face.ascent * scale);
+    }
+    return glyphs;
+}
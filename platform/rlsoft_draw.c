@@ -0,0 +1,530 @@
+/* =========================================================================
+    Purple - Platform
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: rlsoft_draw.c
+    Description: Software rasterizer backend: draws the primitives the game
+                 uses into a CPU framebuffer for headless frame capture
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "rlnull.h"
+#include <raylib/rlgl.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Environment:
+//   PURPLE_SOFT_CAPTURE        Directory to write frame_NNNNNN.ppm captures to
+//   PURPLE_SOFT_CAPTURE_EVERY  Capture every Nth presented frame (default 60)
+//
+// Pixels are RGBA8 packed little-endian into uint32_t. Span loops are kept
+// branch-free over plain integer arithmetic so the compiler vectorizes them
+// (build with -O3); there are no hand-written intrinsics.
+#define SOFT_MAX_TEXTURES 16
+#define SOFT_DEFAULT_CAPTURE_EVERY 60
+#define SOFT_GLYPH_BOX_ALPHA 2  // Glyph boxes drawn at 1/N of the tint alpha
+#define SOFT_SDF_EDGE 128       // Distance-field alpha on the glyph outline
+#define SOFT_SDF_RAMP 4         // Edge sharpness standing in for the shader's smoothstep
+
+typedef struct {
+    unsigned int id;
+    int width;
+    int height;
+    uint32_t *pixels;
+    bool opaque;        // Every pixel has alpha 255 (enables row copies)
+} SoftSurface;
+
+static SoftSurface screen;
+static SoftSurface textures[SOFT_MAX_TEXTURES];
+static SoftSurface *target = NULL;   // Current render target
+static bool alphaOver = false;       // Separate "over" blending for alpha
+static bool customFactorsOver = false;
+static bool sdfShader = false;       // Any shader is taken to be the SDF text one
+static unsigned int nextTextureId = 16;
+static const char *captureDir = NULL;
+static unsigned long long captureEvery = SOFT_DEFAULT_CAPTURE_EVERY;
+static unsigned long long presented = 0;
+
+static inline uint32_t PackColor(Color c)
+{
+    return (uint32_t)c.r | ((uint32_t)c.g << 8) | ((uint32_t)c.b << 16) | ((uint32_t)c.a << 24);
+}
+
+// x / 255 rounded, exact for 0 <= x <= 255 * 255
+static inline uint32_t Div255(uint32_t x)
+{
+    x += 128u;
+    return (x + (x >> 8)) >> 8;
+}
+
+static SoftSurface *Target(void)
+{
+    if (screen.pixels == NULL) {
+        screen.width = NullScreenWidth();
+        screen.height = NullScreenHeight();
+        screen.pixels = calloc((size_t)screen.width * (size_t)screen.height, sizeof(uint32_t));
+        if (screen.pixels == NULL) {
+            screen.width = screen.height = 0;
+        }
+        const char *dir = getenv("PURPLE_SOFT_CAPTURE");
+        if (dir != NULL && *dir != '\0') captureDir = dir;
+        const char *every = getenv("PURPLE_SOFT_CAPTURE_EVERY");
+        if (every != NULL && strtoull(every, NULL, 10) > 0) {
+            captureEvery = strtoull(every, NULL, 10);
+        }
+    }
+    return (target != NULL) ? target : &screen;
+}
+
+// Render textures keep OpenGL's bottom-up row order, so drawing them with a
+// negative source height (as raylib code does) comes out the right way up
+static inline uint32_t *Row(SoftSurface *surface, int y)
+{
+    int stored = (surface == &screen) ? y : surface->height - 1 - y;
+    return &surface->pixels[(size_t)stored * (size_t)surface->width];
+}
+
+// Blend a constant colour over a span of pixels
+static void BlendSpan(uint32_t *restrict row, int count, Color c)
+{
+    if (c.a == 255) {
+        uint32_t packed = PackColor(c);
+        for (int i = 0; i < count; ++i) row[i] = packed;
+        return;
+    }
+    if (c.a == 0) return;
+
+    uint32_t a = c.a;
+    uint32_t ia = 255u - a;
+    uint32_t sr = c.r * a, sg = c.g * a, sb = c.b * a;
+    // GL_SRC_ALPHA for alpha too, unless the separate "over" factors are active
+    uint32_t sa = alphaOver ? a * 255u : a * a;
+    for (int i = 0; i < count; ++i) {
+        uint32_t d = row[i];
+        uint32_t r = Div255(sr + (d & 0xffu) * ia);
+        uint32_t g = Div255(sg + ((d >> 8) & 0xffu) * ia);
+        uint32_t b = Div255(sb + ((d >> 16) & 0xffu) * ia);
+        uint32_t al = Div255(sa + (d >> 24) * ia);
+        row[i] = r | (g << 8) | (b << 16) | (al << 24);
+    }
+}
+
+// Blend one source pixel (already tinted) over the destination
+static inline uint32_t BlendPixel(uint32_t d, uint32_t s)
+{
+    uint32_t a = s >> 24;
+    uint32_t ia = 255u - a;
+    uint32_t r = Div255((s & 0xffu) * a + (d & 0xffu) * ia);
+    uint32_t g = Div255(((s >> 8) & 0xffu) * a + ((d >> 8) & 0xffu) * ia);
+    uint32_t b = Div255(((s >> 16) & 0xffu) * a + ((d >> 16) & 0xffu) * ia);
+    uint32_t al = Div255((alphaOver ? 255u : a) * a + (d >> 24) * ia);
+    return r | (g << 8) | (b << 16) | (al << 24);
+}
+
+static inline int RoundPixel(float v)
+{
+    return (int)floorf(v + 0.5f);
+}
+
+static void FillRect(float x, float y, float width, float height, Color c)
+{
+    SoftSurface *dst = Target();
+    int x0 = RoundPixel(x), x1 = RoundPixel(x + width);
+    int y0 = RoundPixel(y), y1 = RoundPixel(y + height);
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > dst->width) x1 = dst->width;
+    if (y1 > dst->height) y1 = dst->height;
+    for (int row = y0; row < y1 && x0 < x1; ++row) {
+        BlendSpan(Row(dst, row) + x0, x1 - x0, c);
+    }
+}
+
+static SoftSurface *FindTexture(unsigned int id)
+{
+    for (int i = 0; i < SOFT_MAX_TEXTURES; ++i) {
+        if (textures[i].pixels != NULL && textures[i].id == id) return &textures[i];
+    }
+    return NULL;
+}
+
+static void WriteCapture(const SoftSurface *surface)
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s/frame_%06llu.ppm", captureDir, presented);
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return;
+
+    fprintf(file, "P6\n%d %d\n255\n", surface->width, surface->height);
+    unsigned char *line = malloc((size_t)surface->width * 3u);
+    if (line != NULL) {
+        for (int y = 0; y < surface->height; ++y) {
+            const uint32_t *row = &surface->pixels[(size_t)y * (size_t)surface->width];
+            for (int x = 0; x < surface->width; ++x) {
+                line[x * 3 + 0] = (unsigned char)(row[x] & 0xffu);
+                line[x * 3 + 1] = (unsigned char)((row[x] >> 8) & 0xffu);
+                line[x * 3 + 2] = (unsigned char)((row[x] >> 16) & 0xffu);
+            }
+            fwrite(line, 3u, (size_t)surface->width, file);
+        }
+        free(line);
+    }
+    fclose(file);
+}
+
+void NullBackendReport(void)
+{
+    SoftSurface *surface = Target();
+    // FNV-1a of the last presented frame, for golden-image comparisons
+    uint32_t hash = 2166136261u;
+    size_t count = (size_t)surface->width * (size_t)surface->height;
+    for (size_t i = 0; i < count; ++i) {
+        hash ^= surface->pixels[i];
+        hash *= 16777619u;
+    }
+    printf("rlsoft: %dx%d framebuffer, last frame hash %08x\n",
+           surface->width, surface->height, (unsigned int)hash);
+
+    for (int i = 0; i < SOFT_MAX_TEXTURES; ++i) {
+        free(textures[i].pixels);
+        textures[i].pixels = NULL;
+    }
+    free(screen.pixels);
+    screen.pixels = NULL;
+}
+
+// Copy of the screen framebuffer, top row first, as raylib returns it
+Image LoadImageFromScreen(void)
+{
+    Target();  // Allocates the screen on first use
+    const SoftSurface *surface = &screen;
+    size_t bytes = (size_t)surface->width * (size_t)surface->height * sizeof(uint32_t);
+    Image image = { .data = malloc(bytes), .width = surface->width, .height = surface->height,
+                    .mipmaps = 1, .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    if (image.data == NULL) return (Image){0};
+    memcpy(image.data, surface->pixels, bytes);
+    return image;
+}
+
+void BeginDrawing(void)
+{
+    target = NULL;
+    Target();
+}
+
+void EndDrawing(void)
+{
+    presented++;
+    if (captureDir != NULL && presented % captureEvery == 0) WriteCapture(&screen);
+    NullPresentFrame();
+}
+
+void BeginTextureMode(RenderTexture2D renderTarget)
+{
+    SoftSurface *surface = FindTexture(renderTarget.texture.id);
+    target = surface;
+    Target();
+}
+
+void EndTextureMode(void)
+{
+    if (target != NULL) {
+        // Cache whether the layer can be copied instead of blended
+        uint32_t alphaAnd = 0xff000000u;
+        size_t count = (size_t)target->width * (size_t)target->height;
+        for (size_t i = 0; i < count; ++i) alphaAnd &= target->pixels[i];
+        target->opaque = (alphaAnd == 0xff000000u);
+    }
+    target = NULL;
+}
+
+void BeginBlendMode(int mode)
+{
+    alphaOver = (mode == BLEND_CUSTOM_SEPARATE) && customFactorsOver;
+}
+
+void EndBlendMode(void)
+{
+    alphaOver = false;
+}
+
+void rlSetBlendFactorsSeparate(int glSrcRGB, int glDstRGB, int glSrcAlpha, int glDstAlpha,
+                               int glEqRGB, int glEqAlpha)
+{
+    // Only the "over" configuration the game uses for its layers is modelled
+    customFactorsOver = glSrcRGB == RL_SRC_ALPHA && glDstRGB == RL_ONE_MINUS_SRC_ALPHA &&
+                        glSrcAlpha == RL_ONE && glDstAlpha == RL_ONE_MINUS_SRC_ALPHA &&
+                        glEqRGB == RL_FUNC_ADD && glEqAlpha == RL_FUNC_ADD;
+}
+
+static SoftSurface *AllocTexture(int width, int height)
+{
+    for (int i = 0; i < SOFT_MAX_TEXTURES; ++i) {
+        if (textures[i].pixels != NULL) continue;
+        textures[i].pixels = calloc((size_t)width * (size_t)height, sizeof(uint32_t));
+        if (textures[i].pixels == NULL) return NULL;
+        textures[i].id = nextTextureId++;
+        textures[i].width = width;
+        textures[i].height = height;
+        textures[i].opaque = false;
+        return &textures[i];
+    }
+    return NULL;
+}
+
+static void FreeTexture(unsigned int id)
+{
+    SoftSurface *surface = FindTexture(id);
+    if (surface == NULL) return;
+    if (target == surface) target = NULL;
+    free(surface->pixels);
+    surface->pixels = NULL;
+}
+
+RenderTexture2D LoadRenderTexture(int width, int height)
+{
+    RenderTexture2D result = {0};
+    SoftSurface *surface = AllocTexture(width, height);
+    if (surface == NULL) return result;
+    result.id = surface->id;
+    result.texture = (Texture2D){ .id = surface->id, .width = width, .height = height,
+                                  .mipmaps = 1, .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    return result;
+}
+
+void UnloadRenderTexture(RenderTexture2D renderTarget) { FreeTexture(renderTarget.texture.id); }
+
+// Images are stored top-down, as uploaded; only font atlases need GRAY_ALPHA
+Texture2D LoadTextureFromImage(Image image)
+{
+    Texture2D result = {0};
+    if (image.data == NULL || image.width <= 0 || image.height <= 0) return result;
+    if (image.format != PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA &&
+        image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+        return result;
+    }
+    SoftSurface *surface = AllocTexture(image.width, image.height);
+    if (surface == NULL) return result;
+
+    const unsigned char *in = (const unsigned char *)image.data;
+    size_t count = (size_t)image.width * (size_t)image.height;
+    for (size_t i = 0; i < count; ++i) {
+        if (image.format == PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA) {
+            uint32_t g = in[2 * i];
+            surface->pixels[i] = g | (g << 8) | (g << 16) | ((uint32_t)in[2 * i + 1] << 24);
+        } else {
+            memcpy(&surface->pixels[i], &in[4 * i], sizeof(uint32_t));
+        }
+    }
+    result = (Texture2D){ .id = surface->id, .width = image.width, .height = image.height,
+                          .mipmaps = 1, .format = image.format };
+    return result;
+}
+
+void UnloadTexture(Texture2D texture) { FreeTexture(texture.id); }
+void SetTextureFilter(Texture2D texture, int filter) { (void)texture; (void)filter; }
+
+Shader LoadShaderFromMemory(const char *vsCode, const char *fsCode)
+{
+    (void)vsCode;
+    (void)fsCode;
+    return (Shader){ .id = 1 };
+}
+
+void UnloadShader(Shader shader) { (void)shader; }
+void BeginShaderMode(Shader shader) { sdfShader = shader.id != 0; }
+void EndShaderMode(void) { sdfShader = false; }
+
+void ClearBackground(Color color)
+{
+    NullCountDrawCall();
+    SoftSurface *dst = Target();
+    uint32_t packed = PackColor(color);
+    size_t count = (size_t)dst->width * (size_t)dst->height;
+    uint32_t *restrict pixels = dst->pixels;
+    for (size_t i = 0; i < count; ++i) pixels[i] = packed;
+}
+
+void DrawRectangle(int posX, int posY, int width, int height, Color color)
+{
+    NullCountDrawCall();
+    FillRect((float)posX, (float)posY, (float)width, (float)height, color);
+}
+
+void DrawRectangleV(Vector2 position, Vector2 size, Color color)
+{
+    NullObserveRectangle(position, size);
+    NullCountDrawCall();
+    FillRect(position.x, position.y, size.x, size.y, color);
+}
+
+void DrawCircleV(Vector2 center, float radius, Color color)
+{
+    NullObserveCircle(center);
+    NullCountDrawCall();
+    SoftSurface *dst = Target();
+
+    // One span per scanline through pixel centres
+    int y0 = RoundPixel(center.y - radius);
+    int y1 = RoundPixel(center.y + radius);
+    if (y0 < 0) y0 = 0;
+    if (y1 > dst->height) y1 = dst->height;
+    float r2 = radius * radius;
+    for (int y = y0; y < y1; ++y) {
+        float dy = (float)y + 0.5f - center.y;
+        if (dy * dy > r2) continue;
+        float half = sqrtf(r2 - dy * dy);
+        int x0 = RoundPixel(center.x - half);
+        int x1 = RoundPixel(center.x + half);
+        if (x0 < 0) x0 = 0;
+        if (x1 > dst->width) x1 = dst->width;
+        if (x0 < x1) {
+            BlendSpan(Row(dst, y) + x0, x1 - x0, color);
+        }
+    }
+}
+
+void DrawLineV(Vector2 startPos, Vector2 endPos, Color color)
+{
+    NullCountDrawCall();
+    SoftSurface *dst = Target();
+    float dx = endPos.x - startPos.x;
+    float dy = endPos.y - startPos.y;
+    int steps = (int)ceilf(fmaxf(fabsf(dx), fabsf(dy)));
+    if (steps == 0) steps = 1;
+
+    // One-pixel DDA through pixel centres, like a GL_LINES rasterization
+    for (int i = 0; i < steps; ++i) {
+        float t = ((float)i + 0.5f) / (float)steps;
+        int x = (int)floorf(startPos.x + dx * t);
+        int y = (int)floorf(startPos.y + dy * t);
+        if (x < 0 || y < 0 || x >= dst->width || y >= dst->height) continue;
+        BlendSpan(Row(dst, y) + x, 1, color);
+    }
+}
+
+// Stand-in for the SDF fragment shader: a linear ramp across the outline
+static inline uint32_t SdfPixel(uint32_t s)
+{
+    int a = ((int)(s >> 24) - SOFT_SDF_EDGE) * SOFT_SDF_RAMP + SOFT_SDF_EDGE;
+    uint32_t alpha = (a < 0) ? 0u : (a > 255) ? 255u : (uint32_t)a;
+    return (s & 0x00ffffffu) | (alpha << 24);
+}
+
+static inline uint32_t TintPixel(uint32_t s, Color tint)
+{
+    uint32_t r = Div255((s & 0xffu) * tint.r);
+    uint32_t g = Div255(((s >> 8) & 0xffu) * tint.g);
+    uint32_t b = Div255(((s >> 16) & 0xffu) * tint.b);
+    uint32_t a = Div255((s >> 24) * tint.a);
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin,
+                    float rotation, Color tint)
+{
+    (void)rotation;  // The game never rotates textures
+    NullCountDrawCall();
+    dest.x -= origin.x;
+    dest.y -= origin.y;
+
+    SoftSurface *src = FindTexture(texture.id);
+    if (src == NULL) {
+        // Font atlases without pixels (the default font): draw glyphs as boxes
+        Color box = tint;
+        box.a = (unsigned char)(tint.a / SOFT_GLYPH_BOX_ALPHA);
+        FillRect(dest.x, dest.y, dest.width, dest.height, box);
+        return;
+    }
+
+    SoftSurface *dst = Target();
+    bool flipY = source.height < 0.0f;
+    float srcH = fabsf(source.height);
+    int x0 = RoundPixel(dest.x), x1 = RoundPixel(dest.x + dest.width);
+    int y0 = RoundPixel(dest.y), y1 = RoundPixel(dest.y + dest.height);
+    if (x1 <= x0 || y1 <= y0 || source.width <= 0.0f || srcH <= 0.0f) return;
+    float stepX = source.width / (float)(x1 - x0);
+    float stepY = srcH / (float)(y1 - y0);
+    int cx0 = (x0 < 0) ? 0 : x0, cx1 = (x1 > dst->width) ? dst->width : x1;
+    int cy0 = (y0 < 0) ? 0 : y0, cy1 = (y1 > dst->height) ? dst->height : y1;
+    bool white = tint.r == 255 && tint.g == 255 && tint.b == 255 && tint.a == 255;
+    bool unscaled = stepX == 1.0f && stepY == 1.0f;
+
+    for (int y = cy0; y < cy1; ++y) {
+        int sy = (int)(source.y + ((float)(y - y0) + 0.5f) * stepY);
+        if (flipY) sy = (int)(source.y + srcH) - 1 - (sy - (int)source.y);
+        if (sy < 0 || sy >= src->height) continue;
+        uint32_t *restrict out = Row(dst, y);
+        const uint32_t *in = &src->pixels[(size_t)sy * (size_t)src->width];
+
+        if (unscaled && white && src->opaque && !sdfShader) {
+            // Opaque layer at 1:1: a straight row copy
+            int sx0 = (int)source.x + (cx0 - x0);
+            int n = cx1 - cx0;
+            if (sx0 < 0 || sx0 + n > src->width) continue;
+            memcpy(&out[cx0], &in[sx0], (size_t)n * sizeof(uint32_t));
+            continue;
+        }
+        for (int x = cx0; x < cx1; ++x) {
+            int sx = (int)(source.x + ((float)(x - x0) + 0.5f) * stepX);
+            if (sx < 0 || sx >= src->width) continue;
+            uint32_t s = sdfShader ? SdfPixel(in[sx]) : in[sx];
+            if (!white) s = TintPixel(s, tint);
+            out[x] = BlendPixel(out[x], s);
+        }
+    }
+}
+
+void DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint)
+{
+    Rectangle dest = { position.x, position.y, fabsf(source.width), fabsf(source.height) };
+    DrawTexturePro(texture, source, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, tint);
+}
+
+// Same glyph placement as raylib's DrawTextEx
+void DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, float spacing,
+                Color tint)
+{
+    if (text == NULL) return;
+    if (font.texture.id == 0) font = GetFontDefault();
+    if (font.glyphs == NULL || font.recs == NULL || font.baseSize <= 0) return;
+
+    float scale = fontSize / (float)font.baseSize;
+    float padding = (float)font.glyphPadding;
+    float penX = 0.0f;
+    float penY = 0.0f;
+    for (int i = 0; text[i] != '\0';) {
+        int bytes = 0;
+        int codepoint = GetCodepointNext(&text[i], &bytes);
+        i += (bytes > 0) ? bytes : 1;
+        if (codepoint == '\n') {
+            penX = 0.0f;
+            penY += fontSize;
+            continue;
+        }
+        int index = GetGlyphIndex(font, codepoint);
+        const GlyphInfo *glyph = &font.glyphs[index];
+        const Rectangle *rec = &font.recs[index];
+        if (codepoint != ' ' && codepoint != '\t') {
+            Rectangle source = { rec->x - padding, rec->y - padding,
+                                 rec->width + 2.0f * padding, rec->height + 2.0f * padding };
+            Rectangle dest = { position.x + penX + ((float)glyph->offsetX - padding) * scale,
+                               position.y + penY + ((float)glyph->offsetY - padding) * scale,
+                               source.width * scale, source.height * scale };
+            DrawTexturePro(font.texture, source, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, tint);
+        }
+        penX += ((glyph->advanceX == 0) ? rec->width : (float)glyph->advanceX) * scale + spacing;
+    }
+}
+
+void DrawText(const char *text, int posX, int posY, int fontSize, Color color)
+{
+    Font font = GetFontDefault();
+    float size = (float)((fontSize < 10) ? 10 : fontSize);
+    DrawTextEx(font, text, (Vector2){ (float)posX, (float)posY }, size, size / 10.0f, color);
+}
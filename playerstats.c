@@ -0,0 +1,258 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: playerstats.c
+    Description: Per-player win/loss statistics in an open-addressing hash table
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "playerstats.h"
+#include "binfile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Binary layout (little-endian):
+//   header  magic[8] "PRPLSTAT", u32 version, u32 record size, u32 count, u32 reserved
+//   records count x { char initials[4], u32 wins, u32 losses, u32 streak,
+//                     u32 best streak, f32 best seconds, f64 total seconds }
+//   footer  u32 FNV-1a of everything before it
+#define STATS_MAGIC "PRPLSTAT"
+#define STATS_MAGIC_SIZE 8
+#define STATS_VERSION 1u
+#define STATS_HEADER_SIZE (STATS_MAGIC_SIZE + 4 * 4)
+#define STATS_RECORD_SIZE 32
+#define STATS_CHECKSUM_SIZE 4
+#define STATS_MAX_RECORDS (1u << 20)  // Far more than 3-letter initials allow
+#define STATS_MIN_CAPACITY 64
+
+// Same normalisation as leaderboard entries: uppercase, padded to three
+static bool NormalizeInitials(char *dst, const char *src)
+{
+    if (!src || src[0] == '\0') return false;
+    size_t i = 0;
+    for (; i < 3 && src[i]; ++i) {
+        char c = src[i];
+        if (c >= 'a' && c <= 'z') c = (char)(c - 'a' + 'A');
+        dst[i] = c;
+    }
+    for (; i < 3; ++i) dst[i] = ' ';
+    dst[3] = '\0';
+    return true;
+}
+
+// Slot index in a table of capacity (a power of two) slots
+static size_t HashInitials(const char *initials, size_t capacity)
+{
+    uint32_t key = (uint32_t)(unsigned char)initials[0] |
+                   (uint32_t)(unsigned char)initials[1] << 8 |
+                   (uint32_t)(unsigned char)initials[2] << 16;
+    // Fibonacci hashing: the top log2(capacity) bits of the product are the well mixed ones
+    unsigned int shift = 32;
+    for (size_t c = capacity; c > 1 && shift > 0; c >>= 1) --shift;
+    return (size_t)((uint64_t)(key * 2654435769u) >> shift);
+}
+
+// Slot holding initials, or the empty slot where they would go
+static size_t ProbeSlot(const PlayerStatsStore *store, const char *initials)
+{
+    size_t mask = store->capacity - 1;
+    size_t slot = HashInitials(initials, store->capacity) & mask;
+    while (store->slots[slot].initials[0] != '\0' &&
+           memcmp(store->slots[slot].initials, initials, 3) != 0) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+static bool GrowStore(PlayerStatsStore *store)
+{
+    size_t capacity = (store->capacity > 0) ? store->capacity * 2 : STATS_MIN_CAPACITY;
+    PlayerStats *slots = calloc(capacity, sizeof(PlayerStats));
+    if (!slots) return false;
+
+    PlayerStatsStore grown = { slots, capacity, store->count, store->revision };
+    for (size_t i = 0; i < store->capacity; ++i) {
+        const PlayerStats *stats = &store->slots[i];
+        if (stats->initials[0] != '\0') grown.slots[ProbeSlot(&grown, stats->initials)] = *stats;
+    }
+    free(store->slots);
+    *store = grown;
+    return true;
+}
+
+// Find or create the record for normalised initials
+static PlayerStats *UpsertStats(PlayerStatsStore *store, const char *initials)
+{
+    if ((store->count + 1) * 10 > store->capacity * 7 && !GrowStore(store)) return NULL;
+    PlayerStats *stats = &store->slots[ProbeSlot(store, initials)];
+    if (stats->initials[0] == '\0') {
+        memcpy(stats->initials, initials, 4);
+        store->count++;
+    }
+    return stats;
+}
+
+void FreePlayerStatsStore(PlayerStatsStore *store)
+{
+    if (!store) return;
+    free(store->slots);
+    store->slots = NULL;
+    store->capacity = 0;
+    store->count = 0;
+}
+
+const PlayerStats *FindPlayerStats(const PlayerStatsStore *store, const char *initials)
+{
+    char key[4];
+    if (!store || store->capacity == 0 || !NormalizeInitials(key, initials)) return NULL;
+    const PlayerStats *stats = &store->slots[ProbeSlot(store, key)];
+    return (stats->initials[0] != '\0') ? stats : NULL;
+}
+
+bool RecordMatchResult(PlayerStatsStore *store, const char *winner, const char *loser,
+                       float seconds)
+{
+    if (!store) return false;
+    char key[4];
+    bool ok = true;
+    if (NormalizeInitials(key, winner)) {
+        PlayerStats *stats = UpsertStats(store, key);
+        if (stats) {
+            if (stats->wins == 0 || seconds < stats->bestSeconds) stats->bestSeconds = seconds;
+            stats->wins++;
+            stats->totalSeconds += (double)seconds;
+            stats->streak++;
+            if (stats->streak > stats->bestStreak) stats->bestStreak = stats->streak;
+        }
+        ok = stats != NULL;
+    }
+    if (NormalizeInitials(key, loser)) {
+        PlayerStats *stats = UpsertStats(store, key);
+        if (stats) {
+            stats->losses++;
+            stats->streak = 0;
+        }
+        ok = ok && stats != NULL;
+    }
+    store->revision++;
+    return ok;
+}
+
+float PlayerMeanSeconds(const PlayerStats *stats)
+{
+    if (!stats || stats->wins == 0) return 0.0f;
+    return (float)(stats->totalSeconds / (double)stats->wins);
+}
+
+bool LoadPlayerStats(PlayerStatsStore *store, const char *path)
+{
+    if (!store || !path) return false;
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return false;
+    unsigned char header[STATS_HEADER_SIZE];
+    bool ok = fread(header, 1, sizeof(header), fp) == sizeof(header);
+    uint32_t version = 0, recordSize = 0, count = 0, reserved = 0;
+    const unsigned char *p = GetU32(header + STATS_MAGIC_SIZE, &version);
+    p = GetU32(p, &recordSize);
+    p = GetU32(p, &count);
+    GetU32(p, &reserved);
+    ok = ok && memcmp(header, STATS_MAGIC, STATS_MAGIC_SIZE) == 0 &&
+         version == STATS_VERSION && recordSize == STATS_RECORD_SIZE && count <= STATS_MAX_RECORDS;
+
+    size_t bodySize = (size_t)count * STATS_RECORD_SIZE + STATS_CHECKSUM_SIZE;
+    unsigned char *body = ok ? malloc(bodySize) : NULL;
+    ok = body && fread(body, 1, bodySize, fp) == bodySize && fgetc(fp) == EOF;
+    fclose(fp);
+    if (ok) {
+        uint32_t checksum = 0;
+        GetU32(body + bodySize - STATS_CHECKSUM_SIZE, &checksum);
+        uint32_t hash = Fnv1a(Fnv1a(FNV1A_SEED, header, sizeof(header)), body,
+                                 bodySize - STATS_CHECKSUM_SIZE);
+        ok = checksum == hash;
+    }
+
+    // Decode into a fresh table so a bad file leaves the store untouched
+    PlayerStatsStore loaded = {0};
+    for (uint32_t i = 0; ok && i < count; ++i) {
+        p = body + (size_t)i * STATS_RECORD_SIZE;
+        char key[4];
+        memcpy(key, p, 3);
+        key[3] = '\0';
+        PlayerStats *stats = NormalizeInitials(key, key) ? UpsertStats(&loaded, key) : NULL;
+        if (!stats) {
+            ok = false;
+            break;
+        }
+        uint32_t bits = 0;
+        uint64_t total = 0;
+        p = GetU32(p + 4, &stats->wins);
+        p = GetU32(p, &stats->losses);
+        p = GetU32(p, &stats->streak);
+        p = GetU32(p, &stats->bestStreak);
+        p = GetU32(p, &bits);
+        memcpy(&stats->bestSeconds, &bits, sizeof(bits));
+        GetU64(p, &total);
+        memcpy(&stats->totalSeconds, &total, sizeof(total));
+    }
+    free(body);
+    if (!ok) {
+        FreePlayerStatsStore(&loaded);
+        return false;
+    }
+    loaded.revision = store->revision + 1;
+    FreePlayerStatsStore(store);
+    *store = loaded;
+    return true;
+}
+
+typedef struct {
+    const PlayerStatsStore *store;
+    const unsigned char *header;
+} StatsContents;
+
+static bool WriteStatsContents(FILE *fp, void *context)
+{
+    const StatsContents *contents = (const StatsContents *)context;
+    const PlayerStatsStore *store = contents->store;
+    uint32_t hash = Fnv1a(FNV1A_SEED, contents->header, STATS_HEADER_SIZE);
+    bool ok = fwrite(contents->header, 1, STATS_HEADER_SIZE, fp) == STATS_HEADER_SIZE;
+    for (size_t i = 0; i < store->capacity; ++i) {
+        const PlayerStats *stats = &store->slots[i];
+        if (stats->initials[0] == '\0') continue;
+        unsigned char record[STATS_RECORD_SIZE];
+        uint32_t bits;
+        uint64_t total;
+        memcpy(&bits, &stats->bestSeconds, sizeof(bits));
+        memcpy(&total, &stats->totalSeconds, sizeof(total));
+        memcpy(record, stats->initials, 4);
+        unsigned char *p = PutU32(record + 4, stats->wins);
+        p = PutU32(p, stats->losses);
+        p = PutU32(p, stats->streak);
+        p = PutU32(p, stats->bestStreak);
+        p = PutU32(p, bits);
+        PutU64(p, total);
+        hash = Fnv1a(hash, record, sizeof(record));
+        ok = ok && fwrite(record, 1, sizeof(record), fp) == sizeof(record);
+    }
+    unsigned char footer[STATS_CHECKSUM_SIZE];
+    PutU32(footer, hash);
+    return (fwrite(footer, 1, sizeof(footer), fp) == sizeof(footer)) && ok;
+}
+
+bool SavePlayerStats(const PlayerStatsStore *store, const char *path)
+{
+    if (!store || !path || store->count > STATS_MAX_RECORDS) return false;
+    unsigned char header[STATS_HEADER_SIZE];
+    memcpy(header, STATS_MAGIC, STATS_MAGIC_SIZE);
+    unsigned char *p = PutU32(header + STATS_MAGIC_SIZE, STATS_VERSION);
+    p = PutU32(p, STATS_RECORD_SIZE);
+    p = PutU32(p, (uint32_t)store->count);
+    PutU32(p, 0);
+
+    StatsContents contents = { store, header };
+    return WriteFileAtomic(path, WriteStatsContents, &contents);
+}
@@ -0,0 +1,57 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: playerstats.h
+    Description: Per-player win/loss statistics in an open-addressing hash table
+========================================================================= */
+
+#ifndef PLAYERSTATS_H
+#define PLAYERSTATS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PLAYER_STATS_NAME "players.bin"
+
+// Running totals for one set of initials, updated as each match ends
+typedef struct {
+    char initials[4];      // Uppercase, space padded (same as LeaderboardEntry)
+    uint32_t wins;
+    uint32_t losses;
+    uint32_t streak;       // Current run of wins
+    uint32_t bestStreak;
+    float bestSeconds;     // Fastest win; 0 until the first win
+    double totalSeconds;   // Sum of winning times, for the mean
+} PlayerStats;
+
+// Linear-probing table keyed on the packed initials. A zeroed store is
+// empty and valid; it grows (doubling) before it passes 70% full.
+typedef struct {
+    PlayerStats *slots;    // Empty slots have initials[0] == '\0'
+    size_t capacity;       // Power of two, or 0 before the first insert
+    size_t count;
+    unsigned int revision; // Bumped on every update (for render caching)
+} PlayerStatsStore;
+
+void FreePlayerStatsStore(PlayerStatsStore *store);
+
+// O(1) expected; NULL if the initials have no record
+const PlayerStats *FindPlayerStats(const PlayerStatsStore *store, const char *initials);
+
+// Credit a win (and its time) to winner and a loss to loser. Either may be
+// NULL or empty when unknown. Returns false if the table could not grow.
+bool RecordMatchResult(PlayerStatsStore *store, const char *winner, const char *loser,
+                       float seconds);
+
+// Mean winning time in seconds, 0 without wins
+float PlayerMeanSeconds(const PlayerStats *stats);
+
+// Binary file with header and checksum (temp file + fsync + rename on save).
+// Load leaves the store untouched and returns false for a missing or bad file.
+bool LoadPlayerStats(PlayerStatsStore *store, const char *path);
+bool SavePlayerStats(const PlayerStatsStore *store, const char *path);
+
+#endif // PLAYERSTATS_H
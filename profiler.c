@@ -0,0 +1,118 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: profiler.c
+    Description: Per-phase frame timing with rolling percentiles and histogram
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "profiler.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+uint64_t ProfilerNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+void BeginFrameProfile(FrameProfiler *profiler)
+{
+    if (!profiler) return;
+    profiler->frameStart = ProfilerNow();
+    profiler->mark = profiler->frameStart;
+    memset(profiler->current, 0, sizeof(profiler->current));
+}
+
+void MarkFramePhase(FrameProfiler *profiler, FramePhase phase)
+{
+    if (!profiler || phase >= FRAME_PHASE_TOTAL) return;
+    uint64_t now = ProfilerNow();
+    profiler->current[phase] += (float)(now - profiler->mark) / 1.0e6f;
+    profiler->mark = now;
+}
+
+void RecordInputLatency(FrameProfiler *profiler, uint64_t sampledAt)
+{
+    if (!profiler) return;
+    uint64_t now = ProfilerNow();
+    profiler->current[FRAME_INPUT_LATENCY] =
+        (now > sampledAt) ? (float)(now - sampledAt) / 1.0e6f : 0.0f;
+}
+
+void RecordPacingError(FrameProfiler *profiler, int64_t errorNs)
+{
+    if (!profiler) return;
+    profiler->current[FRAME_PACING_ERROR] = (float)errorNs / 1.0e6f;
+}
+
+void EndFrameProfile(FrameProfiler *profiler)
+{
+    if (!profiler) return;
+    profiler->current[FRAME_PHASE_TOTAL] =
+        (float)(ProfilerNow() - profiler->frameStart) / 1.0e6f;
+
+    for (int phase = 0; phase < FRAME_PHASE_COUNT; ++phase) {
+        profiler->history[phase][profiler->head] = profiler->current[phase];
+    }
+    profiler->head = (profiler->head + 1) & (PROFILER_HISTORY - 1);
+    if (profiler->count < PROFILER_HISTORY) profiler->count++;
+}
+
+size_t GetFramePhaseSamples(const FrameProfiler *profiler, FramePhase phase,
+                            float *out, size_t capacity)
+{
+    if (!profiler || !out || phase >= FRAME_PHASE_COUNT) return 0;
+    size_t count = (profiler->count < capacity) ? profiler->count : capacity;
+    size_t first = (profiler->head + PROFILER_HISTORY - count) & (PROFILER_HISTORY - 1);
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = profiler->history[phase][(first + i) & (PROFILER_HISTORY - 1)];
+    }
+    return count;
+}
+
+static int CompareFloat(const void *a, const void *b)
+{
+    float fa = *(const float *)a;
+    float fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+void ComputeFrameStats(float *scratch, size_t count, FrameStats *stats)
+{
+    if (!stats) return;
+    stats->p50 = stats->p99 = stats->max = 0.0f;
+    if (!scratch || count == 0) return;
+
+    qsort(scratch, count, sizeof(float), CompareFloat);
+    // Nearest rank: the ceil(p * n)-th smallest sample
+    size_t rank50 = (count * 50 + 99) / 100;
+    size_t rank99 = (count * 99 + 99) / 100;
+    stats->p50 = scratch[rank50 - 1];
+    stats->p99 = scratch[rank99 - 1];
+    stats->max = scratch[count - 1];
+}
+
+void BuildFrameHistogram(const float *samples, size_t count,
+                         unsigned int buckets[PROFILER_HISTOGRAM_BUCKETS])
+{
+    if (!buckets) return;
+    memset(buckets, 0, sizeof(unsigned int) * PROFILER_HISTOGRAM_BUCKETS);
+    if (!samples) return;
+
+    for (size_t i = 0; i < count; ++i) {
+        float bin = samples[i] / PROFILER_BUCKET_MS;
+        int index = 0;  // Negative and NaN samples land in the first bucket
+        if (bin >= (float)PROFILER_HISTOGRAM_BUCKETS) {
+            index = PROFILER_HISTOGRAM_BUCKETS - 1;
+        } else if (bin > 0.0f) {
+            index = (int)bin;
+        }
+        buckets[index]++;
+    }
+}
@@ -0,0 +1,75 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: profiler.h
+    Description: Per-phase frame timing with rolling percentiles and histogram
+========================================================================= */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PROFILER_HISTORY 256        // Frames kept per phase (power of two)
+#define PROFILER_HISTOGRAM_BUCKETS 32
+#define PROFILER_BUCKET_MS 1.0f     // Last bucket also holds anything slower
+
+typedef enum {
+    FRAME_PHASE_INPUT,
+    FRAME_PHASE_PHYSICS,
+    FRAME_PHASE_DRAW,
+    FRAME_PHASE_PRESENT,   // EndDrawing: buffer swap, frame pacing wait, event poll
+    FRAME_PHASE_TOTAL,
+    FRAME_INPUT_LATENCY,   // Not a phase: latest input sample to frame submit
+    FRAME_PACING_ERROR,    // Not a phase: frame pacer wake time minus its target
+    FRAME_PHASE_COUNT
+} FramePhase;
+
+typedef struct {
+    float p50;
+    float p99;
+    float max;
+} FrameStats;
+
+typedef struct {
+    float history[FRAME_PHASE_COUNT][PROFILER_HISTORY];  // Milliseconds
+    size_t head;              // Next slot to write
+    size_t count;             // Valid samples (saturates at PROFILER_HISTORY)
+    uint64_t frameStart;      // Nanoseconds
+    uint64_t mark;            // End of the last marked phase
+    float current[FRAME_PHASE_COUNT];
+    bool visible;             // Overlay toggle; timing runs either way
+} FrameProfiler;
+
+// Monotonic clock in nanoseconds
+uint64_t ProfilerNow(void);
+
+// Start a frame, attribute the time since the previous mark to a phase
+// (phases may be marked more than once), and close the frame into history.
+// Each call is one clock read, so this costs well under a microsecond a frame.
+void BeginFrameProfile(FrameProfiler *profiler);
+void MarkFramePhase(FrameProfiler *profiler, FramePhase phase);
+void EndFrameProfile(FrameProfiler *profiler);
+
+// Record how long ago (in ProfilerNow() time) the input driving this frame was sampled
+void RecordInputLatency(FrameProfiler *profiler, uint64_t sampledAt);
+
+// Record the frame pacer's deadline error for this frame
+void RecordPacingError(FrameProfiler *profiler, int64_t errorNs);
+
+// Copy the recorded samples of one phase, oldest first. Returns the count.
+size_t GetFramePhaseSamples(const FrameProfiler *profiler, FramePhase phase,
+                            float *out, size_t capacity);
+
+// Nearest-rank p50/p99 and max of a sample set (sorts scratch in place)
+void ComputeFrameStats(float *scratch, size_t count, FrameStats *stats);
+
+// Bucket samples into PROFILER_BUCKET_MS wide bins; the last bin is open-ended
+void BuildFrameHistogram(const float *samples, size_t count,
+                         unsigned int buckets[PROFILER_HISTOGRAM_BUCKETS]);
+
+#endif // PROFILER_H
@@ -9,9 +9,56 @@
 
 #include "resource.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <sys/stat.h>
 
 #define MAX_PATH_LENGTH 512
+#define FONT_SUBPATH "orbitron/Orbitron-VariableFont_wght.ttf"
+
+// Assets built into the executable with -DPURPLE_EMBED_ASSETS. The assembler
+// resolves .incbin paths from the directory the compiler runs in.
+#ifdef PURPLE_EMBED_ASSETS
+#ifndef PURPLE_ASSET_ROOT
+#define PURPLE_ASSET_ROOT "resources"
+#endif
+
+#if defined(__APPLE__)
+#define ASSET_SECTION ".const_data\n"
+#define ASSET_SYMBOL(name) "_" #name
+#define ASSET_SECTION_END ""
+#else
+#define ASSET_SECTION ".section .rodata\n"
+#define ASSET_SYMBOL(name) #name
+#define ASSET_SECTION_END ".previous\n"
+#endif
+
+// Defines name[] and name##End[] around the file's bytes
+#define EMBED_ASSET(name, file)                          \
+    __asm__(ASSET_SECTION                                \
+            ".balign 16\n"                               \
+            ".globl " ASSET_SYMBOL(name) "\n"            \
+            ASSET_SYMBOL(name) ":\n"                     \
+            ".incbin \"" PURPLE_ASSET_ROOT "/" file "\"\n" \
+            ".globl " ASSET_SYMBOL(name##End) "\n"       \
+            ASSET_SYMBOL(name##End) ":\n"                \
+            ".byte 0\n"                                  \
+            ASSET_SECTION_END);                          \
+    extern const unsigned char name[];                   \
+    extern const unsigned char name##End[]
+
+EMBED_ASSET(purpleOrbitronTtf, FONT_SUBPATH);
+
+typedef struct {
+    const char *subpath;
+    const unsigned char *data;
+    const unsigned char *end;
+} EmbeddedAsset;
+
+static const EmbeddedAsset embeddedAssets[] = {
+    { FONT_SUBPATH, purpleOrbitronTtf, purpleOrbitronTtfEnd },
+};
+#endif
 
 // Check if a directory exists
 static int LocalDirectoryExists(const char *path)
@@ -20,10 +67,18 @@ static int LocalDirectoryExists(const char *path)
     return (stat(path, &st) == 0) && S_ISDIR(st.st_mode);
 }
 
+// On-disk override of both the search and any embedded assets
+static const char *ResourceOverride(void)
+{
+    const char *dir = getenv(RESOURCE_DIR_ENV);
+    return (dir != NULL && dir[0] != '\0') ? dir : NULL;
+}
+
 // Find resources directory by searching parent directories
 const char* FindResourceDirectory(void)
 {
     static char resourcePath[MAX_PATH_LENGTH];
+    static int probed = 0;
     const char *basePaths[] = {
         "./resources",
         "resources",
@@ -32,6 +87,16 @@ const char* FindResourceDirectory(void)
         "../../../resources",
     };
 
+    const char *override = ResourceOverride();
+    if (override != NULL) {
+        snprintf(resourcePath, sizeof(resourcePath), "%s", override);
+        probed = 0;  // Re-probe if the override goes away
+        return resourcePath;
+    }
+
+    // The working directory does not change while we run; probe once
+    if (probed) return resourcePath;
+    probed = 1;
     for (size_t i = 0; i < sizeof(basePaths) / sizeof(basePaths[0]); i++) {
         if (LocalDirectoryExists(basePaths[i])) {
             snprintf(resourcePath, sizeof(resourcePath), "%s", basePaths[i]);
@@ -40,7 +105,8 @@ const char* FindResourceDirectory(void)
     }
 
     // Default fallback
-    return "./resources";
+    snprintf(resourcePath, sizeof(resourcePath), "%s", "./resources");
+    return resourcePath;
 }
 
 // Find a resource file within the resources directory
@@ -52,8 +118,30 @@ const char* FindResourceFile(const char *resourceSubpath)
     return fullPath;
 }
 
+// Find an asset compiled into the executable
+const unsigned char* FindResourceData(const char *resourceSubpath, size_t *size)
+{
+    if (size != NULL) *size = 0;
+    if (resourceSubpath == NULL || ResourceOverride() != NULL) return NULL;
+#ifdef PURPLE_EMBED_ASSETS
+    for (size_t i = 0; i < sizeof(embeddedAssets) / sizeof(embeddedAssets[0]); i++) {
+        if (strcmp(embeddedAssets[i].subpath, resourceSubpath) == 0) {
+            if (size != NULL) *size = (size_t)(embeddedAssets[i].end - embeddedAssets[i].data);
+            return embeddedAssets[i].data;
+        }
+    }
+#endif
+    return NULL;
+}
+
 // Find font file using generic resource lookup
 const char* FindFontPath(void)
 {
-    return FindResourceFile("orbitron/Orbitron-VariableFont_wght.ttf");
+    return FindResourceFile(FONT_SUBPATH);
+}
+
+// Embedded font bytes, if built in and not overridden
+const unsigned char* FindFontData(size_t *size)
+{
+    return FindResourceData(FONT_SUBPATH, size);
 }
@@ -10,16 +10,31 @@
 #ifndef RESOURCE_H
 #define RESOURCE_H
 
+#include <stddef.h>
+
+// Environment variable naming a resources directory on disk. When set it
+// replaces both the directory search and any embedded assets.
+#define RESOURCE_DIR_ENV "PURPLE_RESOURCES"
+
 // Find a resource file within the resources directory
 // Searches multiple possible locations for the resources folder
 // Returns a path to the resource file (caller should not free)
 const char* FindResourceFile(const char *resourceSubpath);
 
+// Find a resource compiled into the executable (-DPURPLE_EMBED_ASSETS)
+// Returns read-only bytes and sets size, or NULL when the asset is not
+// embedded or the on-disk override is set; callers then use FindResourceFile
+const unsigned char* FindResourceData(const char *resourceSubpath, size_t *size);
+
 // Find the font file specifically
 // Returns a path to the Orbitron font (caller should not free)
 const char* FindFontPath(void);
 
+// Embedded Orbitron font bytes, or NULL (see FindResourceData)
+const unsigned char* FindFontData(size_t *size);
+
 // Find the resources directory by searching parent directories
+// The search runs once; later calls return the cached result
 // Returns a path to the resources directory (caller should not free)
 const char* FindResourceDirectory(void);
 
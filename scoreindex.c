@@ -0,0 +1,377 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: scoreindex.c
+    Description: Ordered index of every leaderboard result (skip list)
+========================================================================= */
+
+#include "scoreindex.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCORE_ARENA_BLOCK (1u << 20)  // Bytes per node arena block
+#define SCORE_LEVEL_SHIFT 2           // P(level + 1) = 1/4
+
+struct ScoreNode;
+
+// Forward pointer plus how many level-0 steps it skips, so a search can
+// count positions as it descends
+typedef struct {
+    struct ScoreNode *next;
+    size_t span;
+} ScoreLink;
+
+typedef struct ScoreNode {
+    LeaderboardEntry entry;
+    uint64_t sequence;          // Arrival order, breaks ties between equal times
+    int level;
+    struct ScoreNode *prev;     // Level 0 only, for O(1) access to the slowest
+    ScoreLink link[];           // One forward link per level
+} ScoreNode;
+
+typedef struct ArenaBlock {
+    struct ArenaBlock *nextBlock;
+    size_t used;
+    size_t size;
+    unsigned char *data;
+} ArenaBlock;
+
+struct ScoreIndex {
+    size_t capacity;
+    size_t count;
+    int level;                  // Highest level in use
+    uint64_t nextSequence;
+    uint64_t rng;
+    ScoreNode *head;            // Sentinel with SCORE_INDEX_MAX_LEVEL pointers
+    ScoreNode *tail;            // Slowest result
+    ScoreNode *freeNodes[SCORE_INDEX_MAX_LEVEL + 1];  // Recycled nodes by level
+    ArenaBlock *blocks;
+};
+
+static size_t NodeSize(int level)
+{
+    return sizeof(ScoreNode) + (size_t)level * sizeof(ScoreLink);
+}
+
+// NaN sorts after every real time so it can never take a top spot
+static float SortKey(float seconds)
+{
+    return isnan(seconds) ? INFINITY : seconds;
+}
+
+// Strict "a before b"
+static bool Precedes(float aSeconds, uint64_t aSequence, const ScoreNode *b)
+{
+    float a = SortKey(aSeconds);
+    float other = SortKey(b->entry.seconds);
+    if (a != other) return a < other;
+    return aSequence < b->sequence;
+}
+
+static int RandomLevel(ScoreIndex *index)
+{
+    // xorshift64; two bits per level gives p = 1/4
+    uint64_t x = index->rng;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    index->rng = x;
+
+    int level = 1;
+    while (level < SCORE_INDEX_MAX_LEVEL && (x & ((1u << SCORE_LEVEL_SHIFT) - 1u)) == 0) {
+        level++;
+        x >>= SCORE_LEVEL_SHIFT;
+    }
+    return level;
+}
+
+// Nodes come from large blocks instead of one malloc each; millions of
+// results would otherwise pay allocator overhead per entry
+static ScoreNode *AllocNode(ScoreIndex *index, int level)
+{
+    ScoreNode *node = index->freeNodes[level];
+    if (node != NULL) {
+        index->freeNodes[level] = node->link[0].next;
+        return node;
+    }
+
+    size_t size = (NodeSize(level) + 15u) & ~(size_t)15u;
+    ArenaBlock *block = index->blocks;
+    if (block == NULL || block->size - block->used < size) {
+        size_t blockSize = (size > SCORE_ARENA_BLOCK) ? size : SCORE_ARENA_BLOCK;
+        block = malloc(sizeof(ArenaBlock));
+        unsigned char *data = malloc(blockSize);
+        if (block == NULL || data == NULL) {
+            free(block);
+            free(data);
+            return NULL;
+        }
+        block->data = data;
+        block->size = blockSize;
+        block->used = 0;
+        block->nextBlock = index->blocks;
+        index->blocks = block;
+    }
+    node = (ScoreNode *)(void *)(block->data + block->used);
+    block->used += size;
+    return node;
+}
+
+static void FreeNode(ScoreIndex *index, ScoreNode *node)
+{
+    node->link[0].next = index->freeNodes[node->level];
+    index->freeNodes[node->level] = node;
+}
+
+ScoreIndex *CreateScoreIndex(size_t capacity)
+{
+    ScoreIndex *index = calloc(1, sizeof(ScoreIndex));
+    if (index == NULL) return NULL;
+    index->head = calloc(1, NodeSize(SCORE_INDEX_MAX_LEVEL));
+    if (index->head == NULL) {
+        free(index);
+        return NULL;
+    }
+    index->head->level = SCORE_INDEX_MAX_LEVEL;
+    index->capacity = capacity;
+    index->level = 1;
+    index->rng = 0x9e3779b97f4a7c15u;
+    return index;
+}
+
+void DestroyScoreIndex(ScoreIndex *index)
+{
+    if (index == NULL) return;
+    ArenaBlock *block = index->blocks;
+    while (block != NULL) {
+        ArenaBlock *nextBlock = block->nextBlock;
+        free(block->data);
+        free(block);
+        block = nextBlock;
+    }
+    free(index->head);
+    free(index);
+}
+
+void ClearScoreIndex(ScoreIndex *index)
+{
+    if (index == NULL) return;
+    ScoreNode *node = index->head->link[0].next;
+    while (node != NULL) {
+        ScoreNode *nextNode = node->link[0].next;
+        FreeNode(index, node);
+        node = nextNode;
+    }
+    memset(index->head->link, 0, (size_t)SCORE_INDEX_MAX_LEVEL * sizeof(ScoreLink));
+    index->count = 0;
+    index->level = 1;
+    index->tail = NULL;
+}
+
+size_t ScoreIndexCount(const ScoreIndex *index)
+{
+    return (index != NULL) ? index->count : 0;
+}
+
+size_t ScoreIndexCapacity(const ScoreIndex *index)
+{
+    return (index != NULL) ? index->capacity : 0;
+}
+
+// Unlink victim given its predecessor on every level in use
+static void UnlinkNode(ScoreIndex *index, ScoreNode **update, ScoreNode *victim)
+{
+    for (int i = 0; i < index->level; ++i) {
+        if (update[i]->link[i].next == victim) {
+            update[i]->link[i].next = victim->link[i].next;
+            update[i]->link[i].span += victim->link[i].span - 1u;
+        } else {
+            update[i]->link[i].span--;
+        }
+    }
+    while (index->level > 1 && index->head->link[index->level - 1].next == NULL) {
+        index->level--;
+    }
+    if (victim->link[0].next != NULL) {
+        victim->link[0].next->prev = victim->prev;
+    } else {
+        index->tail = (victim->prev != index->head) ? victim->prev : NULL;
+    }
+    index->count--;
+    FreeNode(index, victim);
+}
+
+// Unlink the slowest result (the tail); O(log n) to find its predecessors
+static void RemoveLast(ScoreIndex *index)
+{
+    ScoreNode *victim = index->tail;
+    if (victim == NULL) return;
+
+    ScoreNode *update[SCORE_INDEX_MAX_LEVEL];
+    ScoreNode *node = index->head;
+    for (int i = index->level - 1; i >= 0; --i) {
+        while (node->link[i].next != NULL && node->link[i].next != victim) {
+            node = node->link[i].next;
+        }
+        update[i] = node;
+    }
+    UnlinkNode(index, update, victim);
+}
+
+bool RemoveScore(ScoreIndex *index, float seconds, uint64_t id)
+{
+    if (index == NULL) return false;
+
+    // Sequences are unique, so every other node either precedes the
+    // target or follows it
+    ScoreNode *update[SCORE_INDEX_MAX_LEVEL];
+    ScoreNode *node = index->head;
+    for (int i = index->level - 1; i >= 0; --i) {
+        while (node->link[i].next != NULL && node->link[i].next->sequence != id &&
+               !Precedes(seconds, id, node->link[i].next)) {
+            node = node->link[i].next;
+        }
+        update[i] = node;
+    }
+    ScoreNode *victim = update[0]->link[0].next;
+    if (victim == NULL || victim->sequence != id ||
+        SortKey(victim->entry.seconds) != SortKey(seconds)) {
+        return false;
+    }
+    UnlinkNode(index, update, victim);
+    return true;
+}
+
+bool InsertScore(ScoreIndex *index, const LeaderboardEntry *entry)
+{
+    return InsertScoreId(index, entry, NULL);
+}
+
+bool InsertScoreId(ScoreIndex *index, const LeaderboardEntry *entry, uint64_t *id)
+{
+    if (index == NULL || entry == NULL) return false;
+
+    uint64_t sequence = index->nextSequence;
+    if (index->capacity != SCORE_INDEX_UNBOUNDED && index->count >= index->capacity) {
+        // Full: only a result faster than the slowest one gets in
+        // (a tie loses: the newer sequence sorts after the tail)
+        if (index->tail == NULL || !Precedes(entry->seconds, sequence, index->tail)) return false;
+    }
+
+    // update[i] is the last node before the new one on level i and rank[i]
+    // its position (head = 0)
+    ScoreNode *update[SCORE_INDEX_MAX_LEVEL];
+    size_t rank[SCORE_INDEX_MAX_LEVEL];
+    ScoreNode *node = index->head;
+    for (int i = index->level - 1; i >= 0; --i) {
+        rank[i] = (i == index->level - 1) ? 0 : rank[i + 1];
+        while (node->link[i].next != NULL &&
+               !Precedes(entry->seconds, sequence, node->link[i].next)) {
+            rank[i] += node->link[i].span;
+            node = node->link[i].next;
+        }
+        update[i] = node;
+    }
+
+    int level = RandomLevel(index);
+    ScoreNode *inserted = AllocNode(index, level);
+    if (inserted == NULL) return false;
+    if (level > index->level) {
+        for (int i = index->level; i < level; ++i) {
+            rank[i] = 0;
+            update[i] = index->head;
+            update[i]->link[i].span = index->count;
+        }
+        index->level = level;
+    }
+
+    inserted->entry = *entry;
+    inserted->sequence = sequence;
+    inserted->level = level;
+    for (int i = 0; i < level; ++i) {
+        inserted->link[i].next = update[i]->link[i].next;
+        update[i]->link[i].next = inserted;
+        inserted->link[i].span = update[i]->link[i].span - (rank[0] - rank[i]);
+        update[i]->link[i].span = rank[0] - rank[i] + 1u;
+    }
+    // Links above the new node's height now skip one more position
+    for (int i = level; i < index->level; ++i) update[i]->link[i].span++;
+    inserted->prev = update[0];
+    if (inserted->link[0].next != NULL) {
+        inserted->link[0].next->prev = inserted;
+    } else {
+        index->tail = inserted;
+    }
+    if (id != NULL) *id = sequence;
+    index->nextSequence++;
+    index->count++;
+
+    if (index->capacity != SCORE_INDEX_UNBOUNDED && index->count > index->capacity) {
+        RemoveLast(index);
+    }
+    return true;
+}
+
+const LeaderboardEntry *FirstScore(const ScoreIndex *index, ScoreCursor *cursor)
+{
+    if (index == NULL || cursor == NULL) return NULL;
+    cursor->node = index->head->link[0].next;
+    return (cursor->node != NULL) ? &((const ScoreNode *)cursor->node)->entry : NULL;
+}
+
+const LeaderboardEntry *NextScore(ScoreCursor *cursor)
+{
+    if (cursor == NULL || cursor->node == NULL) return NULL;
+    cursor->node = ((const ScoreNode *)cursor->node)->link[0].next;
+    return (cursor->node != NULL) ? &((const ScoreNode *)cursor->node)->entry : NULL;
+}
+
+size_t ScoreRank(const ScoreIndex *index, float seconds)
+{
+    if (index == NULL) return 1;
+    float key = SortKey(seconds);
+    size_t faster = 0;
+    const ScoreNode *node = index->head;
+    for (int i = index->level - 1; i >= 0; --i) {
+        while (node->link[i].next != NULL && SortKey(node->link[i].next->entry.seconds) < key) {
+            faster += node->link[i].span;
+            node = node->link[i].next;
+        }
+    }
+    return faster + 1u;
+}
+
+const LeaderboardEntry *ScoreAtRank(const ScoreIndex *index, size_t rank)
+{
+    if (index == NULL || rank == 0 || rank > index->count) return NULL;
+    size_t traversed = 0;
+    const ScoreNode *node = index->head;
+    for (int i = index->level - 1; i >= 0; --i) {
+        while (node->link[i].next != NULL && traversed + node->link[i].span <= rank) {
+            traversed += node->link[i].span;
+            node = node->link[i].next;
+        }
+        if (traversed == rank) return &node->entry;
+    }
+    return NULL;
+}
+
+const LeaderboardEntry *LastScore(const ScoreIndex *index)
+{
+    return (index != NULL && index->tail != NULL) ? &index->tail->entry : NULL;
+}
+
+size_t CopyTopScores(const ScoreIndex *index, LeaderboardEntry *out, size_t k)
+{
+    if (out == NULL) return 0;
+    size_t copied = 0;
+    ScoreCursor cursor;
+    for (const LeaderboardEntry *e = FirstScore(index, &cursor); e != NULL && copied < k;
+         e = NextScore(&cursor)) {
+        out[copied++] = *e;
+    }
+    return copied;
+}
@@ -0,0 +1,71 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: scoreindex.h
+    Description: Ordered index of every leaderboard result (skip list)
+========================================================================= */
+
+#ifndef SCOREINDEX_H
+#define SCOREINDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "leaderboard.h"
+
+#define SCORE_INDEX_MAX_LEVEL 32
+#define SCORE_INDEX_UNBOUNDED 0
+
+// Results ordered by time, fastest first; equal times keep arrival order.
+// Insert and rank queries are O(log n) expected (each link records how many
+// results it skips); iteration from the fastest is O(1) per step.
+// With a capacity, inserting into a full index evicts the slowest result.
+typedef struct ScoreIndex ScoreIndex;
+
+// Position in an index for walking it in order
+typedef struct {
+    const void *node;
+} ScoreCursor;
+
+ScoreIndex *CreateScoreIndex(size_t capacity);
+void DestroyScoreIndex(ScoreIndex *index);
+
+// Remove every result but keep the allocated node memory for reuse
+void ClearScoreIndex(ScoreIndex *index);
+
+size_t ScoreIndexCount(const ScoreIndex *index);
+size_t ScoreIndexCapacity(const ScoreIndex *index);
+
+// Returns false if the index is full and the entry is not faster than the
+// slowest kept result (or memory runs out)
+bool InsertScore(ScoreIndex *index, const LeaderboardEntry *entry);
+
+// As InsertScore, also returning the result's id (its arrival sequence) for
+// RemoveScore. An id stays valid until the result is removed, evicted by a
+// capacity insert or the index is cleared.
+bool InsertScoreId(ScoreIndex *index, const LeaderboardEntry *entry, uint64_t *id);
+
+// Remove the result with the given time and id in O(log n) expected;
+// returns false if it is not held
+bool RemoveScore(ScoreIndex *index, float seconds, uint64_t id);
+
+// In-order walk from the fastest result; NULL at the end
+const LeaderboardEntry *FirstScore(const ScoreIndex *index, ScoreCursor *cursor);
+const LeaderboardEntry *NextScore(ScoreCursor *cursor);
+
+// 1-based place a time takes: one more than the results strictly faster,
+// so equal times share a place. Works for times not in the index.
+size_t ScoreRank(const ScoreIndex *index, float seconds);
+
+// Result at a 1-based position (ties in arrival order), or NULL if out of range
+const LeaderboardEntry *ScoreAtRank(const ScoreIndex *index, size_t rank);
+
+// Slowest kept result, or NULL when empty
+const LeaderboardEntry *LastScore(const ScoreIndex *index);
+
+// Copy up to k fastest results; returns how many were copied
+size_t CopyTopScores(const ScoreIndex *index, LeaderboardEntry *out, size_t k);
+
+#endif // SCOREINDEX_H
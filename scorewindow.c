@@ -0,0 +1,151 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: scorewindow.c
+    Description: Rolling time window of leaderboard results
+========================================================================= */
+
+#include "scorewindow.h"
+#include <stdlib.h>
+
+#define WINDOW_HEAP_MIN 64
+
+// What expiry needs to find a result in the index again
+typedef struct {
+    int64_t timestamp;
+    float seconds;
+    uint64_t id;
+} WindowItem;
+
+struct ScoreWindow {
+    ScoreIndex *index;
+    int64_t span;
+    int64_t latest;     // Newest time seen; the window ends here
+    WindowItem *heap;   // Min-heap on timestamp: heap[0] is the oldest result
+    size_t count;
+    size_t capacity;
+};
+
+static bool Older(const WindowItem *a, const WindowItem *b)
+{
+    return a->timestamp < b->timestamp;
+}
+
+static void SiftUp(WindowItem *heap, size_t i)
+{
+    WindowItem item = heap[i];
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!Older(&item, &heap[parent])) break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = item;
+}
+
+static void SiftDown(WindowItem *heap, size_t count, size_t i)
+{
+    WindowItem item = heap[i];
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= count) break;
+        if (child + 1 < count && Older(&heap[child + 1], &heap[child])) child++;
+        if (!Older(&heap[child], &item)) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = item;
+}
+
+static bool OutsideWindow(const ScoreWindow *window, int64_t timestamp)
+{
+    return timestamp <= window->latest - window->span;
+}
+
+ScoreWindow *CreateScoreWindow(int64_t spanSeconds)
+{
+    if (spanSeconds <= 0) return NULL;
+    ScoreWindow *window = calloc(1, sizeof(ScoreWindow));
+    if (window == NULL) return NULL;
+    window->index = CreateScoreIndex(SCORE_INDEX_UNBOUNDED);
+    if (window->index == NULL) {
+        free(window);
+        return NULL;
+    }
+    window->span = spanSeconds;
+    return window;
+}
+
+void DestroyScoreWindow(ScoreWindow *window)
+{
+    if (window == NULL) return;
+    DestroyScoreIndex(window->index);
+    free(window->heap);
+    free(window);
+}
+
+void ClearScoreWindow(ScoreWindow *window)
+{
+    if (window == NULL) return;
+    ClearScoreIndex(window->index);
+    window->count = 0;
+    window->latest = 0;
+}
+
+bool InsertWindowScore(ScoreWindow *window, const LeaderboardEntry *entry)
+{
+    if (window == NULL || entry == NULL || entry->timestamp == 0 ||
+        OutsideWindow(window, entry->timestamp)) {
+        return false;
+    }
+    if (window->count == window->capacity) {
+        size_t capacity = (window->capacity > 0) ? window->capacity * 2 : WINDOW_HEAP_MIN;
+        WindowItem *heap = realloc(window->heap, capacity * sizeof(WindowItem));
+        if (heap == NULL) return false;
+        window->heap = heap;
+        window->capacity = capacity;
+    }
+
+    WindowItem item = { entry->timestamp, entry->seconds, 0 };
+    if (!InsertScoreId(window->index, entry, &item.id)) return false;
+    window->heap[window->count] = item;
+    SiftUp(window->heap, window->count++);
+    if (entry->timestamp > window->latest) ExpireScoreWindow(window, entry->timestamp);
+    return true;
+}
+
+size_t ExpireScoreWindow(ScoreWindow *window, int64_t now)
+{
+    if (window == NULL) return 0;
+    if (now > window->latest) window->latest = now;
+    size_t expired = 0;
+    while (window->count > 0 && OutsideWindow(window, window->heap[0].timestamp)) {
+        RemoveScore(window->index, window->heap[0].seconds, window->heap[0].id);
+        window->heap[0] = window->heap[--window->count];
+        if (window->count > 0) SiftDown(window->heap, window->count, 0);
+        expired++;
+    }
+    return expired;
+}
+
+size_t ScoreWindowCount(const ScoreWindow *window)
+{
+    return (window != NULL) ? window->count : 0;
+}
+
+int64_t ScoreWindowSpan(const ScoreWindow *window)
+{
+    return (window != NULL) ? window->span : 0;
+}
+
+const ScoreIndex *ScoreWindowIndex(const ScoreWindow *window)
+{
+    return (window != NULL) ? window->index : NULL;
+}
+
+size_t CopyWindowTopScores(const ScoreWindow *window, LeaderboardEntry *out, size_t k)
+{
+    return (window != NULL) ? CopyTopScores(window->index, out, k) : 0;
+}
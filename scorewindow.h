@@ -0,0 +1,49 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: scorewindow.h
+    Description: Rolling time window of leaderboard results
+========================================================================= */
+
+#ifndef SCOREWINDOW_H
+#define SCOREWINDOW_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "leaderboard.h"
+#include "scoreindex.h"
+
+// Results stamped within the last span seconds, ordered by time like the
+// all-time index. A min-heap on timestamps beside the index gives the
+// oldest result in O(1), so expiry removes exactly the results that left
+// the window (O(log n) each) instead of rebuilding the board, and results
+// that arrive out of order are still evicted in time order.
+// A result stamped t is held while t > now - span, where now is the latest
+// time the window has seen (from an insert or an expiry).
+typedef struct ScoreWindow ScoreWindow;
+
+ScoreWindow *CreateScoreWindow(int64_t spanSeconds);
+void DestroyScoreWindow(ScoreWindow *window);
+void ClearScoreWindow(ScoreWindow *window);
+
+// Add a result and expire against its timestamp if that is the newest
+// seen. Results without a timestamp (0) or already outside the window are
+// not held; returns false for those (and when memory runs out).
+bool InsertWindowScore(ScoreWindow *window, const LeaderboardEntry *entry);
+
+// Evict every result stamped at or before now - span; returns how many left
+size_t ExpireScoreWindow(ScoreWindow *window, int64_t now);
+
+size_t ScoreWindowCount(const ScoreWindow *window);
+int64_t ScoreWindowSpan(const ScoreWindow *window);
+
+// The held results, for rank queries and in-order walks
+const ScoreIndex *ScoreWindowIndex(const ScoreWindow *window);
+
+// Copy up to k fastest results in the window; O(k)
+size_t CopyWindowTopScores(const ScoreWindow *window, LeaderboardEntry *out, size_t k);
+
+#endif // SCOREWINDOW_H
@@ -0,0 +1,259 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: sharedboard.c
+    Description: Leaderboard feed shared between game instances on one host
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE  // flock()
+
+#include "sharedboard.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Mapped layout (native byte order; the file never leaves the host):
+//   header  64 bytes, below
+//   ring    SHARED_BOARD_RING x 6 words { initials[3] + winner, seconds bits,
+//                                         loser[3], publishing instance,
+//                                         timestamp low, timestamp high }
+// Result n lives in slot n % SHARED_BOARD_RING.
+#define SHARED_MAGIC "PRPLSHRD"
+#define SHARED_MAGIC_SIZE 8
+#define SHARED_VERSION 2u
+#define SHARED_SLOT_WORDS 6
+#define SHARED_RING_MASK ((uint64_t)SHARED_BOARD_RING - 1u)
+
+typedef struct {
+    char magic[SHARED_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t ringSize;
+    uint32_t sequence;   // Odd while a writer is publishing
+    uint32_t reserved0;
+    uint64_t published;  // Results ever published
+    unsigned char reserved[32];
+} SharedHeader;
+
+typedef uint32_t SharedSlot[SHARED_SLOT_WORDS];
+
+#define SHARED_FILE_SIZE (sizeof(SharedHeader) + SHARED_BOARD_RING * sizeof(SharedSlot))
+
+static SharedHeader *Header(const SharedBoard *board)
+{
+    return (SharedHeader *)board->mapping;
+}
+
+static SharedSlot *Slots(const SharedBoard *board)
+{
+    return (SharedSlot *)(void *)((unsigned char *)board->mapping + sizeof(SharedHeader));
+}
+
+static uint32_t PackInitials(const char *initials, char fourth)
+{
+    return (uint32_t)(unsigned char)initials[0] | (uint32_t)(unsigned char)initials[1] << 8 |
+           (uint32_t)(unsigned char)initials[2] << 16 | (uint32_t)(unsigned char)fourth << 24;
+}
+
+static void UnpackInitials(char *initials, uint32_t word)
+{
+    for (int i = 0; i < 3; ++i) initials[i] = (char)(word >> (8 * i));
+    initials[3] = '\0';
+}
+
+static void EncodeSlot(uint32_t *words, const BoardResult *result, uint32_t instance)
+{
+    const LeaderboardEntry *e = &result->entry;
+    uint32_t bits;
+    memcpy(&bits, &e->seconds, sizeof(bits));
+    words[0] = PackInitials(e->initials, e->winner);
+    words[1] = bits;
+    words[2] = (result->loser[0] != '\0') ? PackInitials(result->loser, '\0') : 0u;
+    words[3] = instance;
+    words[4] = (uint32_t)(uint64_t)e->timestamp;
+    words[5] = (uint32_t)((uint64_t)e->timestamp >> 32);
+}
+
+static void DecodeSlot(BoardResult *result, const uint32_t *words)
+{
+    LeaderboardEntry *e = &result->entry;
+    UnpackInitials(e->initials, words[0]);
+    e->winner = ((char)(words[0] >> 24) == 'A') ? 'A' : 'P';
+    memcpy(&e->seconds, &words[1], sizeof(e->seconds));
+    e->timestamp = (int64_t)((uint64_t)words[5] << 32 | words[4]);
+    UnpackInitials(result->loser, words[2]);
+    result->hasMatch = false;
+}
+
+bool OpenSharedBoard(SharedBoard *board, const char *path)
+{
+    if (!board) return false;
+    memset(board, 0, sizeof(*board));
+    board->fd = -1;
+    char defaultPath[512];
+    if (!path) {
+        if (!GetLeaderboardSavePath(SHARED_BOARD_NAME, defaultPath, sizeof(defaultPath))) return false;
+        path = defaultPath;
+    }
+    board->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (board->fd < 0) return false;
+
+    // Create or repair the file under the lock so two instances starting
+    // together agree on one layout
+    void *mapping = MAP_FAILED;
+    if (LockSharedBoard(board)) {
+        struct stat st;
+        bool ok = fstat(board->fd, &st) == 0;
+        bool fresh = ok && st.st_size != (off_t)SHARED_FILE_SIZE;
+        if (fresh) {
+            ok = ftruncate(board->fd, 0) == 0 && ftruncate(board->fd, (off_t)SHARED_FILE_SIZE) == 0;
+        }
+        if (ok) {
+            mapping = mmap(NULL, SHARED_FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, board->fd, 0);
+        }
+        if (mapping != MAP_FAILED) {
+            SharedHeader *header = (SharedHeader *)mapping;
+            if (fresh || memcmp(header->magic, SHARED_MAGIC, SHARED_MAGIC_SIZE) != 0 ||
+                header->version != SHARED_VERSION || header->ringSize != SHARED_BOARD_RING) {
+                memset(mapping, 0, SHARED_FILE_SIZE);
+                memcpy(header->magic, SHARED_MAGIC, SHARED_MAGIC_SIZE);
+                header->version = SHARED_VERSION;
+                header->ringSize = SHARED_BOARD_RING;
+            }
+        }
+        UnlockSharedBoard(board);
+    }
+    if (mapping == MAP_FAILED) {
+        close(board->fd);
+        board->fd = -1;
+        return false;
+    }
+    board->mapping = mapping;
+    board->size = SHARED_FILE_SIZE;
+    board->instance = (uint32_t)getpid();
+    board->seen = SharedBoardPublished(board);
+    return true;
+}
+
+void CloseSharedBoard(SharedBoard *board)
+{
+    if (!board) return;
+    if (board->mapping) munmap(board->mapping, board->size);
+    if (board->fd >= 0) close(board->fd);
+    board->mapping = NULL;
+    board->fd = -1;
+}
+
+bool LockSharedBoard(SharedBoard *board)
+{
+    if (!board || board->fd < 0) return true;
+    while (flock(board->fd, LOCK_EX) != 0) {
+        if (errno != EINTR) return false;
+    }
+    return true;
+}
+
+void UnlockSharedBoard(SharedBoard *board)
+{
+    if (!board || board->fd < 0) return;
+    (void)flock(board->fd, LOCK_UN);
+}
+
+uint64_t SharedBoardPublished(const SharedBoard *board)
+{
+    if (!board || !board->mapping) return 0;
+    return __atomic_load_n(&Header(board)->published, __ATOMIC_ACQUIRE);
+}
+
+void PublishSharedResults(SharedBoard *board, const BoardResult *results, size_t count)
+{
+    if (!board || !board->mapping || !results || count == 0) return;
+    SharedHeader *header = Header(board);
+    SharedSlot *slots = Slots(board);
+    uint64_t published = __atomic_load_n(&header->published, __ATOMIC_RELAXED);
+    // Only the newest ring's worth can be read back
+    if (count > SHARED_BOARD_RING) {
+        published += count - SHARED_BOARD_RING;
+        results += count - SHARED_BOARD_RING;
+        count = SHARED_BOARD_RING;
+    }
+
+    // Forcing the low bit (rather than adding one) also recovers from a
+    // writer that died mid-publish and left the counter odd.
+    //
+    // The fence orders the odd counter before every store that follows, so
+    // a reader whose copy saw any new slot or count (and fences before its
+    // re-check) also sees the counter change
+    uint32_t sequence = __atomic_load_n(&header->sequence, __ATOMIC_RELAXED) | 1u;
+    __atomic_store_n(&header->sequence, sequence, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t words[SHARED_SLOT_WORDS];
+        EncodeSlot(words, &results[i], board->instance);
+        uint32_t *slot = slots[(published + i) & SHARED_RING_MASK];
+        for (int w = 0; w < SHARED_SLOT_WORDS; ++w) {
+            __atomic_store_n(&slot[w], words[w], __ATOMIC_RELEASE);
+        }
+    }
+    // A reader that sees the new count also sees the slots written for it
+    __atomic_store_n(&header->published, published + count, __ATOMIC_RELEASE);
+    __atomic_store_n(&header->sequence, sequence + 1u, __ATOMIC_RELEASE);
+}
+
+size_t PollSharedBoard(SharedBoard *board, BoardResult *out, size_t max)
+{
+    if (!board || !board->mapping || !out) return 0;
+    if (max > SHARED_BOARD_POLL_MAX) max = SHARED_BOARD_POLL_MAX;
+    const SharedHeader *header = Header(board);
+    SharedSlot *slots = Slots(board);
+
+    for (int attempt = 0; attempt < SHARED_BOARD_READ_ATTEMPTS; ++attempt) {
+        uint32_t begin = __atomic_load_n(&header->sequence, __ATOMIC_ACQUIRE);
+        uint64_t published = __atomic_load_n(&header->published, __ATOMIC_ACQUIRE);
+        if (published == board->seen) return 0;  // The common case, every frame
+        if (begin & 1u) {
+            board->retries++;
+            continue;
+        }
+        if (published < board->seen) {
+            // The file was reset under us; start over from its count
+            board->seen = published;
+            return 0;
+        }
+        uint64_t from = board->seen;
+        if (published - from > SHARED_BOARD_RING) from = published - SHARED_BOARD_RING;
+        size_t n = (published - from < max) ? (size_t)(published - from) : max;
+
+        uint32_t words[SHARED_BOARD_POLL_MAX][SHARED_SLOT_WORDS];
+        for (size_t i = 0; i < n; ++i) {
+            const uint32_t *slot = slots[(from + i) & SHARED_RING_MASK];
+            for (int w = 0; w < SHARED_SLOT_WORDS; ++w) {
+                words[i][w] = __atomic_load_n(&slot[w], __ATOMIC_ACQUIRE);
+            }
+        }
+        // Slots may have been overwritten while we copied: only keep the
+        // copy if no publish started or finished in the meantime. The fence
+        // keeps the re-check from being satisfied before the copy is done.
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&header->sequence, __ATOMIC_RELAXED) != begin) {
+            board->retries++;
+            continue;
+        }
+
+        board->missed += from - board->seen;
+        board->seen = from + n;
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (words[i][3] == board->instance) continue;  // Already on our board
+            DecodeSlot(&out[count++], words[i]);
+        }
+        return count;
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: sharedboard.h
+    Description: Leaderboard feed shared between game instances on one host
+========================================================================= */
+
+#ifndef SHAREDBOARD_H
+#define SHAREDBOARD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "leaderboard.h"
+#include "matchhistory.h"
+
+#define SHARED_BOARD_NAME "leaderboard.shared"
+#define SHARED_BOARD_RING 1024     // Recent results kept for readers; power of two
+#define SHARED_BOARD_POLL_MAX 64   // Results taken per poll; the rest wait a frame
+#define SHARED_BOARD_READ_ATTEMPTS 4
+
+// A finished match: the leaderboard entry plus who lost it, for player stats,
+// and the full record for the match history
+typedef struct {
+    LeaderboardEntry entry;
+    char loser[4];       // Empty when unknown
+    bool hasMatch;       // Local results only; the ring carries entry and loser
+    MatchRecord match;
+} BoardResult;
+
+// One process's handle on the shared file. Every instance maps the same
+// ring of recent results. Writers (each instance's board writer thread)
+// serialise on flock() and publish under a sequence counter; readers copy
+// the new slots and re-check the counter, so polling never takes a lock
+// and costs two loads when nothing changed.
+typedef struct {
+    int fd;
+    void *mapping;
+    size_t size;
+    uint32_t instance;  // Tags published results so an instance skips its own
+    uint64_t seen;      // Results consumed by this reader (one thread only)
+    uint64_t missed;    // Results that left the ring before this reader got to them
+    uint64_t retries;   // Reads repeated because a writer was mid-publish
+} SharedBoard;
+
+// Map (creating or resetting if needed) the shared file; NULL path means
+// ~/.purple/leaderboard.shared. On failure fd is -1 and every call below
+// is a no-op, leaving the instance on its own.
+bool OpenSharedBoard(SharedBoard *board, const char *path);
+void CloseSharedBoard(SharedBoard *board);
+
+// Exclusive lock across processes for the whole read-modify-write of the
+// board files. True (and nothing done) when the board is not open.
+bool LockSharedBoard(SharedBoard *board);
+void UnlockSharedBoard(SharedBoard *board);
+
+// Results published so far; load the board under the lock and start
+// polling from here, so nothing is seen twice or skipped
+uint64_t SharedBoardPublished(const SharedBoard *board);
+
+// Publish results already written to disk; call with the lock held
+void PublishSharedResults(SharedBoard *board, const BoardResult *results, size_t count);
+
+// Copy up to max (at most SHARED_BOARD_POLL_MAX) results published by other
+// instances since the last poll. Lock-free; returns the number copied.
+size_t PollSharedBoard(SharedBoard *board, BoardResult *out, size_t max);
+
+#endif // SHAREDBOARD_H
@@ -0,0 +1,203 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: simulation.c
+    Description: Deterministic headless AI-vs-AI match simulation
+========================================================================= */
+
+#include "simulation.h"
+#include <stddef.h>
+
+// Playfield and rules mirror main.c so simulated matches match real ones
+#define SIM_FIELD_WIDTH 1200
+#define SIM_FIELD_HEIGHT 600
+#define SIM_PADDLE_WIDTH 15.0f
+#define SIM_PADDLE_HEIGHT 100.0f
+#define SIM_PADDLE_OFFSET 20.0f
+#define SIM_BALL_RADIUS 8.0f
+#define SIM_BALL_SPEED_X 4.0f
+#define SIM_BALL_SPEED_Y 2.0f
+#define SIM_POINTS_TO_WIN 5
+#define SIM_SPEED_INCREMENT 0.02f
+#define SIM_MAX_MATCH_FRAMES (60u * 60u * 10u)  // Ten minutes at 60 FPS
+
+void InitSimConfig(SimConfig *config)
+{
+    if (config == NULL) return;
+    config->pointsToWin = SIM_POINTS_TO_WIN;
+    config->speedIncrement = SIM_SPEED_INCREMENT;
+    config->maxMatchFrames = SIM_MAX_MATCH_FRAMES;
+}
+
+void SeedSimRng(SimRng *rng, uint64_t seed)
+{
+    if (rng == NULL) return;
+
+    // SplitMix64 finalizer spreads nearby seeds (lane 0, 1, 2...) apart
+    uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+
+    // xorshift must never hold an all-zero state
+    rng->state = (z != 0) ? z : 0x9E3779B97F4A7C15ull;
+}
+
+uint32_t SimRngNext(SimRng *rng)
+{
+    if (rng == NULL) return 0;
+    uint64_t x = rng->state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    rng->state = x;
+    return (uint32_t)((x * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+static void ResetSimBall(SimLane *lane)
+{
+    lane->ball.position.x = (float)SIM_FIELD_WIDTH / 2.0f;
+    lane->ball.position.y = (float)SIM_FIELD_HEIGHT / 2.0f;
+
+    float directionX = (SimRngNext(&lane->rng) & 1u) ? 1.0f : -1.0f;
+    float directionY = (SimRngNext(&lane->rng) & 1u) ? 1.0f : -1.0f;
+    lane->ball.velocity.x = SIM_BALL_SPEED_X * lane->speedMultiplier * directionX;
+    lane->ball.velocity.y = SIM_BALL_SPEED_Y * lane->speedMultiplier * directionY;
+    lane->rally = 0;
+}
+
+static void ResetSimPaddle(Paddle *paddle, float x)
+{
+    paddle->position.x = x;
+    paddle->position.y = (float)(SIM_FIELD_HEIGHT - SIM_PADDLE_HEIGHT) / 2.0f;
+    paddle->width = SIM_PADDLE_WIDTH;
+    paddle->height = SIM_PADDLE_HEIGHT;
+    paddle->velocity = 0.0f;
+    paddle->score = 0;
+}
+
+static void StartSimMatch(SimLane *lane)
+{
+    ResetSimPaddle(&lane->left, SIM_PADDLE_OFFSET);
+    ResetSimPaddle(&lane->right, (float)SIM_FIELD_WIDTH - SIM_PADDLE_WIDTH - SIM_PADDLE_OFFSET);
+    lane->ball.radius = SIM_BALL_RADIUS;
+    lane->speedMultiplier = 1.0f;
+    lane->matchFrames = 0;
+    ResetSimBall(lane);
+}
+
+void InitSimLane(SimLane *lane, const SimConfig *config, uint64_t seed, uint64_t matches)
+{
+    if (lane == NULL || config == NULL) return;
+
+    SimStats empty = {0};
+    SeedSimRng(&lane->rng, seed);
+    lane->matchesRemaining = matches;
+    lane->stats = empty;
+    StartSimMatch(lane);
+}
+
+bool IsSimLaneDone(const SimLane *lane)
+{
+    return (lane == NULL) || (lane->matchesRemaining == 0);
+}
+
+static void FinishSimMatch(SimLane *lane, int winner)
+{
+    lane->stats.matches++;
+    if (winner < 0) {
+        lane->stats.leftWins++;
+    } else if (winner > 0) {
+        lane->stats.rightWins++;
+    } else {
+        lane->stats.abandoned++;
+    }
+    lane->matchesRemaining--;
+    if (lane->matchesRemaining > 0) {
+        StartSimMatch(lane);
+    }
+}
+
+static void CountRally(SimLane *lane, float velocityBefore)
+{
+    // HandlePaddleCollision always flips the horizontal direction on a hit
+    if ((velocityBefore < 0.0f) != (lane->ball.velocity.x < 0.0f)) {
+        lane->rally++;
+        lane->stats.rallies++;
+        if (lane->rally > lane->stats.longestRally) {
+            lane->stats.longestRally = lane->rally;
+        }
+    }
+}
+
+static void ScoreSimPoint(SimLane *lane, const SimConfig *config, Paddle *scorer, int winner)
+{
+    scorer->score++;
+    lane->speedMultiplier = 1.0f +
+        (float)(lane->left.score + lane->right.score) * config->speedIncrement;
+    if (scorer->score >= config->pointsToWin) {
+        FinishSimMatch(lane, winner);
+    } else {
+        ResetSimBall(lane);
+    }
+}
+
+// Same update order as the PLAYING state in main.c, with both paddles on AI
+static void StepSimFrame(SimLane *lane, const SimConfig *config)
+{
+    Ball *ball = &lane->ball;
+
+    UpdateAIPaddle(&lane->left, ball->position, ball->radius, SIM_FIELD_HEIGHT);
+    UpdateAIPaddle(&lane->right, ball->position, ball->radius, SIM_FIELD_HEIGHT);
+    UpdateBallPosition(ball);
+
+    float velocityBefore = ball->velocity.x;
+    HandlePaddleCollision(ball, lane->left.position, SIM_PADDLE_WIDTH, SIM_PADDLE_HEIGHT);
+    CountRally(lane, velocityBefore);
+    velocityBefore = ball->velocity.x;
+    HandlePaddleCollision(ball, lane->right.position, SIM_PADDLE_WIDTH, SIM_PADDLE_HEIGHT);
+    CountRally(lane, velocityBefore);
+
+    if (IsCollidingVertical(ball, SIM_FIELD_HEIGHT)) {
+        ball->velocity.y *= -1.0f;
+    }
+
+    lane->matchFrames++;
+    lane->stats.frames++;
+
+    if (ball->position.x < 0.0f) {
+        ScoreSimPoint(lane, config, &lane->right, 1);
+    } else if (ball->position.x > (float)SIM_FIELD_WIDTH) {
+        ScoreSimPoint(lane, config, &lane->left, -1);
+    } else if (lane->matchFrames >= config->maxMatchFrames) {
+        FinishSimMatch(lane, 0);
+    }
+}
+
+uint64_t StepSimLane(SimLane *lane, const SimConfig *config, uint64_t maxFrames)
+{
+    if (lane == NULL || config == NULL) return 0;
+
+    uint64_t stepped = 0;
+    while (stepped < maxFrames && lane->matchesRemaining > 0) {
+        StepSimFrame(lane, config);
+        stepped++;
+    }
+    return stepped;
+}
+
+void AccumulateSimStats(SimStats *total, const SimStats *stats)
+{
+    if (total == NULL || stats == NULL) return;
+    total->matches += stats->matches;
+    total->leftWins += stats->leftWins;
+    total->rightWins += stats->rightWins;
+    total->abandoned += stats->abandoned;
+    total->frames += stats->frames;
+    total->rallies += stats->rallies;
+    if (stats->longestRally > total->longestRally) {
+        total->longestRally = stats->longestRally;
+    }
+}
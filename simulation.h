@@ -0,0 +1,73 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: simulation.h
+    Description: Deterministic headless AI-vs-AI match simulation
+========================================================================= */
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ball.h"
+#include "paddle.h"
+
+// Small deterministic PRNG (xorshift64*) so lane state can be checkpointed
+typedef struct {
+    uint64_t state;
+} SimRng;
+
+typedef struct {
+    int pointsToWin;
+    float speedIncrement;     // Ball speed increase per point scored
+    uint32_t maxMatchFrames;  // Abandon a match after this many frames
+} SimConfig;
+
+typedef struct {
+    uint64_t matches;
+    uint64_t leftWins;
+    uint64_t rightWins;
+    uint64_t abandoned;
+    uint64_t frames;
+    uint64_t rallies;         // Total paddle hits
+    uint32_t longestRally;
+} SimStats;
+
+// One independent stream of back-to-back matches
+typedef struct {
+    SimRng rng;
+    Ball ball;
+    Paddle left;
+    Paddle right;
+    float speedMultiplier;
+    uint32_t matchFrames;
+    uint32_t rally;
+    uint64_t matchesRemaining;
+    SimStats stats;
+} SimLane;
+
+// Fill config with the same rules main.c plays by
+void InitSimConfig(SimConfig *config);
+
+// Seed the PRNG (any seed, including 0, is valid)
+void SeedSimRng(SimRng *rng, uint64_t seed);
+
+// Next 32-bit value from the PRNG
+uint32_t SimRngNext(SimRng *rng);
+
+// Prepare a lane to play the given number of matches
+void InitSimLane(SimLane *lane, const SimConfig *config, uint64_t seed, uint64_t matches);
+
+// Advance a lane by up to maxFrames frames; returns the frames actually stepped
+uint64_t StepSimLane(SimLane *lane, const SimConfig *config, uint64_t maxFrames);
+
+// Check whether a lane has played all of its matches
+bool IsSimLaneDone(const SimLane *lane);
+
+// Add one lane's statistics into a running total
+void AccumulateSimStats(SimStats *total, const SimStats *stats);
+
+#endif // SIMULATION_H
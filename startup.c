@@ -0,0 +1,135 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: startup.c
+    Description: Font and leaderboard loading on worker threads at startup
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "startup.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "profiler.h"
+#include "scoreindex.h"
+
+static void *FontWorker(void *arg)
+{
+    StartupLoader *loader = (StartupLoader *)arg;
+    uint64_t start = ProfilerNow();
+    if (loader->fontData != NULL) {
+        loader->atlasLoaded = LoadFontAtlasFromMemory(loader->fontData, loader->fontDataSize,
+                                                      loader->fontSize, loader->fontType,
+                                                      &loader->atlas);
+    } else {
+        loader->atlasLoaded = LoadFontAtlas(loader->fontPath, loader->fontSize,
+                                            loader->fontType, &loader->atlas);
+    }
+    loader->fontBakedNs = ProfilerNow() - start;
+    return NULL;
+}
+
+static void *LeaderboardWorker(void *arg)
+{
+    StartupLoader *loader = (StartupLoader *)arg;
+    uint64_t start = ProfilerNow();
+    // Other instances publish under the same lock, so the files read here
+    // hold exactly the results published before our read position
+    LockSharedBoard(loader->shared);
+    LoadLeaderboard(&loader->leaderboard);
+    ExpireLeaderboardWindows(&loader->leaderboard, (int64_t)time(NULL));
+    char path[STARTUP_MAX_PATH];
+    if (GetLeaderboardSavePath(PLAYER_STATS_NAME, path, sizeof(path))) {
+        LoadPlayerStats(&loader->players, path);
+    }
+    if (GetLeaderboardSavePath(MATCH_HISTORY_NAME, path, sizeof(path))) {
+        LoadMatchHistory(&loader->history, path);
+    }
+    if (loader->shared != NULL) loader->shared->seen = SharedBoardPublished(loader->shared);
+    UnlockSharedBoard(loader->shared);
+    loader->leaderboardLoadNs = ProfilerNow() - start;
+    return NULL;
+}
+
+void StartStartupLoader(StartupLoader *loader, const unsigned char *fontData, int fontDataSize,
+                        const char *fontPath, int fontSize, int fontType,
+                        size_t leaderboardCapacity, SharedBoard *shared)
+{
+    if (loader == NULL) return;
+    memset(loader, 0, sizeof(*loader));
+    loader->beganAt = ProfilerNow();
+    loader->fontData = fontData;
+    loader->fontDataSize = fontDataSize;
+    snprintf(loader->fontPath, sizeof(loader->fontPath), "%s", (fontPath != NULL) ? fontPath : "");
+    loader->fontSize = fontSize;
+    loader->fontType = fontType;
+    loader->shared = shared;
+    // Without an index (out of memory) the board still keeps its top entries
+    loader->leaderboard.index = CreateScoreIndex(leaderboardCapacity);
+    CreateLeaderboardWindows(&loader->leaderboard);
+
+    loader->fontThreaded = pthread_create(&loader->fontThread, NULL, FontWorker, loader) == 0;
+    if (!loader->fontThreaded) FontWorker(loader);
+    loader->leaderboardThreaded =
+        pthread_create(&loader->leaderboardThread, NULL, LeaderboardWorker, loader) == 0;
+    if (!loader->leaderboardThreaded) LeaderboardWorker(loader);
+}
+
+Font JoinStartupFont(StartupLoader *loader)
+{
+    Font font = {0};
+    if (loader == NULL || loader->fontJoined) return font;
+    loader->fontJoined = true;
+    if (loader->fontThreaded) {
+        uint64_t start = ProfilerNow();
+        pthread_join(loader->fontThread, NULL);
+        loader->waitedNs += ProfilerNow() - start;
+    }
+
+    if (loader->atlasLoaded) {
+        font = UploadFontAtlas(&loader->atlas);
+        if (font.texture.id != 0) return font;
+        // Upload failed: the glyphs moved into font; hand them back to raylib
+        UnloadFont(font);
+    }
+    if (loader->fontData != NULL) {
+        return LoadFontFromMemory(".ttf", loader->fontData, loader->fontDataSize,
+                                  loader->fontSize, NULL, 0);
+    }
+    return LoadFontEx(loader->fontPath, loader->fontSize, NULL, 0);
+}
+
+void JoinStartupLeaderboard(StartupLoader *loader, Leaderboard *lb, PlayerStatsStore *players,
+                            MatchHistory *history)
+{
+    if (loader == NULL || lb == NULL || loader->leaderboardJoined) return;
+    loader->leaderboardJoined = true;
+    if (loader->leaderboardThreaded) {
+        uint64_t start = ProfilerNow();
+        pthread_join(loader->leaderboardThread, NULL);
+        loader->waitedNs += ProfilerNow() - start;
+    }
+    *lb = loader->leaderboard;
+    if (players != NULL) {
+        *players = loader->players;
+    } else {
+        FreePlayerStatsStore(&loader->players);
+    }
+    if (history != NULL) {
+        *history = loader->history;
+    } else {
+        FreeMatchHistory(&loader->history);
+    }
+}
+
+void ReportStartup(const StartupLoader *loader, uint64_t firstFrameAt)
+{
+    if (loader == NULL) return;
+    TraceLog(LOG_INFO, "STARTUP: First frame after %.2f ms (font %.2f ms, leaderboard %.2f ms "
+             "on workers; main thread waited %.2f ms)",
+             (double)(firstFrameAt - loader->beganAt) / 1e6, (double)loader->fontBakedNs / 1e6,
+             (double)loader->leaderboardLoadNs / 1e6, (double)loader->waitedNs / 1e6);
+}
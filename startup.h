@@ -0,0 +1,78 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: startup.h
+    Description: Font and leaderboard loading on worker threads at startup
+========================================================================= */
+
+#ifndef STARTUP_H
+#define STARTUP_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <raylib/raylib.h>
+#include "fontcache.h"
+#include "leaderboard.h"
+#include "matchhistory.h"
+#include "playerstats.h"
+#include "sharedboard.h"
+
+#define STARTUP_MAX_PATH 512
+
+// Work started before InitWindow and joined where the result is first used.
+// Workers only touch CPU-side data; the atlas upload happens on the GL thread.
+typedef struct {
+    pthread_t fontThread;
+    pthread_t leaderboardThread;
+    bool fontThreaded;
+    bool leaderboardThreaded;
+    bool fontJoined;
+    bool leaderboardJoined;
+
+    // Font input, resolved on the calling thread (resource lookups use statics)
+    const unsigned char *fontData;
+    int fontDataSize;
+    char fontPath[STARTUP_MAX_PATH];
+    int fontSize;
+    int fontType;
+
+    // Worker results
+    FontAtlas atlas;
+    bool atlasLoaded;
+    Leaderboard leaderboard;
+    PlayerStatsStore players;
+    MatchHistory history;
+    SharedBoard *shared;  // Locked while loading; its read position is set to match
+
+    // Timing (ProfilerNow nanoseconds)
+    uint64_t beganAt;
+    uint64_t fontBakedNs;        // Worker time reading/baking or mapping the atlas
+    uint64_t leaderboardLoadNs;  // Worker time parsing the leaderboard, player stats and history
+    uint64_t waitedNs;           // Main thread time blocked in joins
+} StartupLoader;
+
+// Kick off both workers; falls back to doing the work inline if a thread
+// cannot be created. fontData may be NULL to read fontPath instead. The
+// leaderboard gets a score index of the given capacity (0 = unbounded) and
+// its rolling windows; the caller owns them after JoinStartupLeaderboard. shared (may be NULL) must not
+// be polled until then.
+void StartStartupLoader(StartupLoader *loader, const unsigned char *fontData, int fontDataSize,
+                        const char *fontPath, int fontSize, int fontType,
+                        size_t leaderboardCapacity, SharedBoard *shared);
+
+// Join the font worker and upload its atlas (needs the window / GL context)
+Font JoinStartupFont(StartupLoader *loader);
+
+// Join the leaderboard worker and copy its results; players and history
+// may be NULL (the caller owns them otherwise)
+void JoinStartupLeaderboard(StartupLoader *loader, Leaderboard *lb, PlayerStatsStore *players,
+                            MatchHistory *history);
+
+// Log time to first frame with the worker and wait breakdown
+void ReportStartup(const StartupLoader *loader, uint64_t firstFrameAt);
+
+#endif // STARTUP_H
@@ -4,7 +4,7 @@
     Copyright (c) 2026 Jacob Doherty
     SPDX-License-Identifier: MIT
     File: test.c
-    Description: Unit tests for ball, paddle, leaderboard, and resource modules
+    Description: Unit tests for ball, paddle, leaderboard, resource, simulation, and text modules
 ========================================================================= */
 
 #define _DEFAULT_SOURCE
@@ -13,7 +13,24 @@
 #include "../ball.h"
 #include "../paddle.h"
 #include "../leaderboard.h"
+#include "../binfile.h"
 #include "../resource.h"
+#include "../simulation.h"
+#include "../checkpoint.h"
+#include "../textcache.h"
+#include "../hud.h"
+#include "../profiler.h"
+#include "../input.h"
+#include "../pacer.h"
+#include "../fontcache.h"
+#include "../startup.h"
+#include "../scoreindex.h"
+#include "../scorewindow.h"
+#include "../boardwriter.h"
+#include "../playerstats.h"
+#include "../sharedboard.h"
+#include "../matchhistory.h"
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -767,6 +784,24 @@ void test_FindResourceDirectory_IsConsistent(void) {
     TEST_ASSERT_EQUAL_PTR(dir1, dir2);
 }
 
+void test_ResourceOverride_ReplacesSearchAndEmbeddedData(void) {
+    const char *before = FindResourceDirectory();
+    char saved[512];
+    snprintf(saved, sizeof(saved), "%s", before);
+
+    setenv(RESOURCE_DIR_ENV, "/tmp/purple-resources", 1);
+    TEST_ASSERT_EQUAL_STRING("/tmp/purple-resources", FindResourceDirectory());
+    TEST_ASSERT_EQUAL_STRING("/tmp/purple-resources/orbitron/Orbitron-VariableFont_wght.ttf",
+                             FindFontPath());
+    size_t size = 1;
+    TEST_ASSERT_NULL(FindFontData(&size));
+    TEST_ASSERT_EQUAL_UINT(0, size);
+
+    // Without the override the search result comes back
+    unsetenv(RESOURCE_DIR_ENV);
+    TEST_ASSERT_EQUAL_STRING(saved, FindResourceDirectory());
+}
+
 // ==================== Font File Tests ====================
 
 void test_FontFile_ExistsAndValid(void) {
@@ -960,6 +995,1049 @@ void test_SaveAndLoadLeaderboard_PersistsSorted(void) {
     if (oldHome) setenv("HOME", oldHome, 1);
 }
 
+void test_LeaderboardFile_RejectsCorruptRecord(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/purpleboardXXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        TEST_IGNORE_MESSAGE("Failed to create temp file");
+    }
+    close(fd);
+
+    Leaderboard lb = {0};
+    AddLeaderboardEntry(&lb, "AAA", 'P', 11.0f);
+    AddLeaderboardEntry(&lb, "BBB", 'A', 7.25f);
+    TEST_ASSERT_TRUE(SaveLeaderboardFile(&lb, path));
+
+    Leaderboard loaded = {0};
+    TEST_ASSERT_TRUE(LoadLeaderboardFile(&loaded, path));
+    TEST_ASSERT_EQUAL_UINT32(2, loaded.count);
+    TEST_ASSERT_EQUAL_FLOAT(7.25f, loaded.entries[0].seconds);
+    TEST_ASSERT_EQUAL_CHAR('A', loaded.entries[0].winner);
+    TEST_ASSERT_EQUAL_STRING("BBB", loaded.entries[0].initials);
+
+    // Flip a byte inside the first record's time; the checksum must catch it
+    FILE *fp = fopen(path, "r+b");
+    TEST_ASSERT_NOT_NULL(fp);
+    fseek(fp, 24 + 8, SEEK_SET);
+    int c = fgetc(fp);
+    fseek(fp, 24 + 8, SEEK_SET);
+    fputc(c ^ 0x40, fp);
+    fclose(fp);
+
+    Leaderboard rejected = {0};
+    rejected.count = 5;
+    TEST_ASSERT_FALSE(LoadLeaderboardFile(&rejected, path));
+    TEST_ASSERT_EQUAL_UINT32(5, rejected.count);  // Left untouched
+    remove(path);
+}
+
+void test_LeaderboardText_ExportImportRoundTrip(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/purpleboardXXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        TEST_IGNORE_MESSAGE("Failed to create temp file");
+    }
+    close(fd);
+
+    Leaderboard lb = {0};
+    AddLeaderboardEntry(&lb, "XYZ", 'P', 3.5f);
+    AddLeaderboardEntry(&lb, "QRS", 'A', 1.25f);
+    TEST_ASSERT_TRUE(ExportLeaderboardText(&lb, path));
+
+    Leaderboard imported = {0};
+    TEST_ASSERT_TRUE(ImportLeaderboardText(&imported, path, NULL));
+    TEST_ASSERT_EQUAL_UINT32(2, imported.count);
+    TEST_ASSERT_EQUAL_STRING("QRS", imported.entries[0].initials);
+    TEST_ASSERT_EQUAL_FLOAT(3.5f, imported.entries[1].seconds);
+    remove(path);
+}
+
+static void CountParsedEntry(void *context, const LeaderboardEntry *e)
+{
+    Leaderboard *lb = (Leaderboard *)context;
+    if (lb->count < LEADERBOARD_MAX_ENTRIES) lb->entries[lb->count++] = *e;
+}
+
+void test_LeaderboardText_ParsesAndReportsMalformedLines(void) {
+    // No terminating NUL or newline at the end, CRLF on one line
+    static const char text[] =
+        "12.345;P;ABC\n"
+        "\n"
+        "  7;A;ai\r\n"
+        "1.5e1;P;LONGNAME\n"
+        "oops;P;XYZ\n"
+        "3.25;Q;XYZ\n"
+        "4,5;P;DEF\n"
+        "-inf;P;NEG\n"
+        "0.0000000000000000000000000000000000000000001234;P;TNY\n"
+        "2.5;P;GHI extra\n"
+        "9.999;A;Z";
+    Leaderboard lb = {0};
+    LeaderboardTextStats stats;
+    ParseLeaderboardText(text, sizeof(text) - 1, CountParsedEntry, &lb, &stats);
+    TEST_ASSERT_EQUAL_UINT32(10, stats.lines);
+    TEST_ASSERT_EQUAL_UINT32(6, stats.imported);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.malformed);
+    TEST_ASSERT_EQUAL_UINT32(5, stats.firstMalformed);
+    TEST_ASSERT_EQUAL_UINT32(6, lb.count);
+    TEST_ASSERT_EQUAL_FLOAT(12.345f, lb.entries[0].seconds);
+    TEST_ASSERT_EQUAL_STRING("ai", lb.entries[1].initials);
+    TEST_ASSERT_EQUAL_INT('A', lb.entries[1].winner);
+    TEST_ASSERT_EQUAL_FLOAT(15.0f, lb.entries[2].seconds);
+    TEST_ASSERT_EQUAL_STRING("LON", lb.entries[2].initials);
+    TEST_ASSERT_TRUE(isinf(lb.entries[3].seconds) && lb.entries[3].seconds < 0.0f);
+    TEST_ASSERT_TRUE(lb.entries[4].seconds > 0.0f && lb.entries[4].seconds < 1e-42f);
+    TEST_ASSERT_EQUAL_STRING("Z", lb.entries[5].initials);
+
+    // Export writes what printf's "%0.3f" would, ties rounding to even
+    char line[LEADERBOARD_TEXT_LINE_MAX + 1];
+    LeaderboardEntry e = { "AB", 'A', 1.0625f, 0 };
+    size_t length = FormatLeaderboardLine(line, &e);
+    line[length] = '\0';
+    TEST_ASSERT_EQUAL_STRING("1.062;A;AB\n", line);
+    e.seconds = -0.0004f;
+    line[FormatLeaderboardLine(line, &e)] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-0.000;A;AB\n", line);
+    e.seconds = 123456.789f;
+    line[FormatLeaderboardLine(line, &e)] = '\0';
+    TEST_ASSERT_EQUAL_STRING("123456.789;A;AB\n", line);
+}
+
+void test_ScoreIndex_OrdersTiesAndEvictsSlowest(void) {
+    ScoreIndex *index = CreateScoreIndex(4);
+    TEST_ASSERT_NOT_NULL(index);
+
+    LeaderboardEntry a = { "AAA", 'P', 5.0f, 0 };
+    LeaderboardEntry b = { "BBB", 'P', 2.0f, 0 };
+    LeaderboardEntry c = { "CCC", 'A', 5.0f, 0 };
+    LeaderboardEntry d = { "DDD", 'P', 9.0f, 0 };
+    LeaderboardEntry e = { "EEE", 'A', 9.0f, 0 };
+    LeaderboardEntry f = { "FFF", 'P', 1.0f, 0 };
+    TEST_ASSERT_TRUE(InsertScore(index, &a));
+    TEST_ASSERT_TRUE(InsertScore(index, &b));
+    TEST_ASSERT_TRUE(InsertScore(index, &c));
+    TEST_ASSERT_TRUE(InsertScore(index, &d));
+    TEST_ASSERT_FALSE(InsertScore(index, &e));  // Full, and a tie with the slowest loses
+    TEST_ASSERT_TRUE(InsertScore(index, &f));   // Evicts DDD
+    TEST_ASSERT_EQUAL_UINT32(4, ScoreIndexCount(index));
+
+    const char *expected[] = { "FFF", "BBB", "AAA", "CCC" };
+    ScoreCursor cursor;
+    size_t seen = 0;
+    for (const LeaderboardEntry *entry = FirstScore(index, &cursor); entry != NULL;
+         entry = NextScore(&cursor)) {
+        TEST_ASSERT_EQUAL_STRING(expected[seen], entry->initials);
+        seen++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(4, seen);
+    TEST_ASSERT_EQUAL_STRING("CCC", LastScore(index)->initials);
+
+    LeaderboardEntry top[2];
+    TEST_ASSERT_EQUAL_UINT32(2, CopyTopScores(index, top, 2));
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, top[1].seconds);
+    DestroyScoreIndex(index);
+}
+
+void test_ScoreIndex_RankQueriesMatchOrder(void) {
+    ScoreIndex *index = CreateScoreIndex(300);
+    TEST_ASSERT_NOT_NULL(index);
+
+    // Coarse times force plenty of ties; the capacity forces evictions
+    unsigned int state = 12345u;
+    for (int i = 0; i < 1000; ++i) {
+        state = state * 1103515245u + 12345u;
+        LeaderboardEntry e = { "RNK", 'P', (float)((state >> 16) % 200u), 0 };
+        InsertScore(index, &e);
+    }
+    TEST_ASSERT_EQUAL_UINT32(300, ScoreIndexCount(index));
+
+    ScoreCursor cursor;
+    size_t position = 1;
+    float previous = -1.0f;
+    size_t firstOfTime = 1;
+    for (const LeaderboardEntry *e = FirstScore(index, &cursor); e != NULL;
+         e = NextScore(&cursor), ++position) {
+        TEST_ASSERT_EQUAL_PTR(e, ScoreAtRank(index, position));
+        if (e->seconds != previous) firstOfTime = position;
+        TEST_ASSERT_EQUAL_UINT32(firstOfTime, ScoreRank(index, e->seconds));
+        previous = e->seconds;
+    }
+    TEST_ASSERT_NULL(ScoreAtRank(index, 0));
+    TEST_ASSERT_NULL(ScoreAtRank(index, 301));
+    TEST_ASSERT_EQUAL_UINT32(1, ScoreRank(index, -1.0f));
+    TEST_ASSERT_EQUAL_UINT32(301, ScoreRank(index, NAN));
+
+    // Leaderboard wrappers agree with and without an index
+    Leaderboard lb = {0};
+    AddLeaderboardEntry(&lb, "AAA", 'P', 4.0f);
+    AddLeaderboardEntry(&lb, "BBB", 'P', 2.0f);
+    LeaderboardEntry out;
+    TEST_ASSERT_EQUAL_UINT32(2, LeaderboardRank(&lb, 3.0f));
+    TEST_ASSERT_TRUE(LeaderboardEntryAtRank(&lb, 2, &out));
+    TEST_ASSERT_EQUAL_STRING("AAA", out.initials);
+    TEST_ASSERT_FALSE(LeaderboardEntryAtRank(&lb, 3, &out));
+    lb.index = index;
+    TEST_ASSERT_EQUAL_UINT32(ScoreRank(index, 50.5f), LeaderboardRank(&lb, 50.5f));
+    DestroyScoreIndex(index);
+}
+
+void test_ScoreWindow_ExpiresInTimeOrder(void) {
+    // Removal by id picks the right one of several equal times
+    ScoreIndex *index = CreateScoreIndex(SCORE_INDEX_UNBOUNDED);
+    TEST_ASSERT_NOT_NULL(index);
+    LeaderboardEntry tie = { "T1", 'P', 4.0f, 0 };
+    uint64_t ids[3];
+    for (int i = 0; i < 3; ++i) {
+        tie.initials[1] = (char)('1' + i);
+        TEST_ASSERT_TRUE(InsertScoreId(index, &tie, &ids[i]));
+    }
+    TEST_ASSERT_TRUE(RemoveScore(index, 4.0f, ids[1]));
+    TEST_ASSERT_FALSE(RemoveScore(index, 4.0f, ids[1]));
+    TEST_ASSERT_FALSE(RemoveScore(index, 5.0f, ids[0]));
+    TEST_ASSERT_EQUAL_UINT32(2, ScoreIndexCount(index));
+    TEST_ASSERT_EQUAL_STRING("T1", ScoreAtRank(index, 1)->initials);
+    TEST_ASSERT_EQUAL_STRING("T3", ScoreAtRank(index, 2)->initials);
+    TEST_ASSERT_TRUE(RemoveScore(index, 4.0f, ids[2]));
+    TEST_ASSERT_EQUAL_STRING("T1", LastScore(index)->initials);
+    DestroyScoreIndex(index);
+
+    ScoreWindow *window = CreateScoreWindow(100);
+    TEST_ASSERT_NOT_NULL(window);
+    LeaderboardEntry a = { "A", 'P', 5.0f, 1000 };
+    LeaderboardEntry b = { "B", 'P', 3.0f, 1050 };
+    LeaderboardEntry c = { "C", 'A', 4.0f, 1020 };   // Arrives out of order
+    LeaderboardEntry unstamped = { "U", 'P', 1.0f, 0 };
+    LeaderboardEntry stale = { "S", 'P', 2.0f, 950 };  // Already out at 1050
+    TEST_ASSERT_TRUE(InsertWindowScore(window, &a));
+    TEST_ASSERT_TRUE(InsertWindowScore(window, &b));
+    TEST_ASSERT_TRUE(InsertWindowScore(window, &c));
+    TEST_ASSERT_FALSE(InsertWindowScore(window, &unstamped));
+    TEST_ASSERT_FALSE(InsertWindowScore(window, &stale));
+
+    LeaderboardEntry top[4];
+    TEST_ASSERT_EQUAL_UINT32(3, CopyWindowTopScores(window, top, 4));
+    TEST_ASSERT_EQUAL_STRING("B", top[0].initials);
+    TEST_ASSERT_EQUAL_STRING("C", top[1].initials);
+    TEST_ASSERT_EQUAL_STRING("A", top[2].initials);
+
+    TEST_ASSERT_EQUAL_UINT32(0, ExpireScoreWindow(window, 1099));  // 1000 is still in
+    TEST_ASSERT_EQUAL_UINT32(1, ExpireScoreWindow(window, 1100));
+    TEST_ASSERT_EQUAL_UINT32(2, CopyWindowTopScores(window, top, 4));
+    TEST_ASSERT_EQUAL_STRING("C", top[1].initials);
+    // An insert moves the window forward too
+    LeaderboardEntry late = { "L", 'P', 9.0f, 1140 };
+    TEST_ASSERT_TRUE(InsertWindowScore(window, &late));
+    TEST_ASSERT_EQUAL_UINT32(2, ScoreWindowCount(window));
+    TEST_ASSERT_EQUAL_STRING("B", ScoreAtRank(ScoreWindowIndex(window), 1)->initials);
+    TEST_ASSERT_EQUAL_UINT32(2, ExpireScoreWindow(window, 100000));
+    TEST_ASSERT_EQUAL_UINT32(0, CopyWindowTopScores(window, top, 4));
+    DestroyScoreWindow(window);
+}
+
+void test_LeaderboardWindows_UpdateWithEveryResultAndPersist(void) {
+    char path[] = "/tmp/purple_windows_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        TEST_IGNORE_MESSAGE("Failed to create temp file");
+    }
+    close(fd);
+
+    const int64_t now = 1767225600;  // 2026-01-01
+    Leaderboard lb = {0};
+    lb.index = CreateScoreIndex(SCORE_INDEX_UNBOUNDED);
+    CreateLeaderboardWindows(&lb);
+    AddLeaderboardEntryAt(&lb, "OLD", 'P', 1.0f, now - 30 * LEADERBOARD_DAY_SECONDS);
+    AddLeaderboardEntryAt(&lb, "WEK", 'P', 2.0f, now - 3 * LEADERBOARD_DAY_SECONDS);
+    AddLeaderboardEntryAt(&lb, "DAY", 'A', 4.0f, now - 3600);
+    AddLeaderboardEntryAt(&lb, "NOW", 'P', 3.0f, now);
+    AddLeaderboardEntryAt(&lb, "UNK", 'P', 0.5f, 0);  // All time only
+    TEST_ASSERT_EQUAL_UINT32(5, lb.count);
+
+    LeaderboardEntry top[LEADERBOARD_MAX_ENTRIES];
+    TEST_ASSERT_EQUAL_UINT32(2, CopyLeaderboardWindow(&lb, LEADERBOARD_TODAY, top, 10));
+    TEST_ASSERT_EQUAL_STRING("NOW", top[0].initials);
+    TEST_ASSERT_EQUAL_STRING("DAY", top[1].initials);
+    TEST_ASSERT_EQUAL_UINT32(3, CopyLeaderboardWindow(&lb, LEADERBOARD_THIS_WEEK, top, 10));
+    TEST_ASSERT_EQUAL_STRING("WEK", top[0].initials);
+
+    unsigned int revision = lb.revision;
+    TEST_ASSERT_FALSE(ExpireLeaderboardWindows(&lb, now + 60));
+    TEST_ASSERT_EQUAL_UINT(revision, lb.revision);
+    TEST_ASSERT_TRUE(ExpireLeaderboardWindows(&lb, now + LEADERBOARD_DAY_SECONDS - 1800));
+    TEST_ASSERT_TRUE(lb.revision != revision);
+    TEST_ASSERT_EQUAL_UINT32(1, CopyLeaderboardWindow(&lb, LEADERBOARD_TODAY, top, 10));
+    TEST_ASSERT_EQUAL_UINT32(5, lb.count);  // All time keeps everything
+
+    // Timestamps survive the binary file and rebuild the windows on load
+    TEST_ASSERT_TRUE(SaveLeaderboardFile(&lb, path));
+    Leaderboard loaded = {0};
+    CreateLeaderboardWindows(&loaded);
+    TEST_ASSERT_TRUE(LoadLeaderboardFile(&loaded, path));
+    TEST_ASSERT_EQUAL_UINT32(5, loaded.count);
+    TEST_ASSERT_TRUE(loaded.entries[0].timestamp == 0);
+    TEST_ASSERT_TRUE(loaded.entries[1].timestamp == now - 30 * LEADERBOARD_DAY_SECONDS);
+    ExpireLeaderboardWindows(&loaded, now + 60);
+    TEST_ASSERT_EQUAL_UINT32(2, CopyLeaderboardWindow(&loaded, LEADERBOARD_TODAY, top, 10));
+    TEST_ASSERT_EQUAL_UINT32(3, CopyLeaderboardWindow(&loaded, LEADERBOARD_THIS_WEEK, top, 10));
+
+    // A version 1 file (12-byte records, no timestamps) still loads
+    unsigned char v1[8 + 16 + 12 + 4] = "PRPLLDBD";
+    const uint32_t header[4] = { 1u, 12u, 1u, 7u };
+    for (int w = 0; w < 4; ++w) {
+        for (int i = 0; i < 4; ++i) v1[8 + 4 * w + i] = (unsigned char)(header[w] >> (8 * i));
+    }
+    memcpy(v1 + 24, "OLD", 3);
+    v1[28] = 'A';
+    const float seconds = 7.5f;
+    uint32_t bits;
+    memcpy(&bits, &seconds, sizeof(bits));
+    for (int i = 0; i < 4; ++i) v1[32 + i] = (unsigned char)(bits >> (8 * i));
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < 36; ++i) hash = (hash ^ v1[i]) * 16777619u;
+    for (int i = 0; i < 4; ++i) v1[36 + i] = (unsigned char)(hash >> (8 * i));
+    FILE *fp = fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(fp);
+    fwrite(v1, 1, sizeof(v1), fp);
+    fclose(fp);
+    TEST_ASSERT_TRUE(LoadLeaderboardFile(&loaded, path));
+    TEST_ASSERT_EQUAL_UINT32(1, loaded.count);
+    TEST_ASSERT_EQUAL_STRING("OLD", loaded.entries[0].initials);
+    TEST_ASSERT_EQUAL_FLOAT(7.5f, loaded.entries[0].seconds);
+    TEST_ASSERT_TRUE(loaded.entries[0].timestamp == 0);
+    TEST_ASSERT_EQUAL_UINT32(0, CopyLeaderboardWindow(&loaded, LEADERBOARD_TODAY, top, 10));
+
+    // Text lines carry the stamp as an optional fourth field
+    char line[LEADERBOARD_TEXT_LINE_MAX + 1];
+    line[FormatLeaderboardLine(line, &lb.entries[4])] = '\0';
+    TEST_ASSERT_EQUAL_STRING("4.000;A;DAY;1767222000\n", line);
+    LeaderboardTextStats stats;
+    ParseLeaderboardText(line, strlen(line), NULL, NULL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.imported);
+    const char *bad = "1.0;P;ABC;\n1.0;P;ABC;-5\n1.0;P;ABC;99999999999999999999\n";
+    ParseLeaderboardText(bad, strlen(bad), NULL, NULL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.malformed);
+
+    DestroyScoreIndex(lb.index);
+    DestroyLeaderboardWindows(&lb);
+    DestroyLeaderboardWindows(&loaded);
+    remove(path);
+}
+
+static int CompareUint32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile over plain records, for checking the history's
+static float PlainMatchPercentile(const MatchRecord *matches, size_t count,
+                                  const MatchFilter *filter, double percentile) {
+    uint32_t *millis = malloc(count * sizeof(uint32_t));
+    size_t n = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const MatchRecord *m = &matches[i];
+        if (m->timestamp >= filter->from && m->timestamp < filter->to &&
+            (filter->winner == 0 || filter->winner == m->winner)) {
+            millis[n++] = (uint32_t)llrint((double)m->seconds * 1000.0);
+        }
+    }
+    qsort(millis, n, sizeof(uint32_t), CompareUint32);
+    size_t rank = (size_t)ceil(percentile * (double)n);
+    float seconds = (n > 0) ? (float)millis[(rank > 0) ? rank - 1 : 0] / 1000.0f : -1.0f;
+    free(millis);
+    return seconds;
+}
+
+void test_MatchHistory_SkipsBlocksAndMatchesPlainPercentiles(void) {
+    // Two sealed blocks and part of a third; the first all player wins
+    size_t count = 2 * MATCH_HISTORY_BLOCK + 100;
+    MatchRecord *matches = malloc(count * sizeof(MatchRecord));
+    MatchRecord *copied = malloc(count * sizeof(MatchRecord));
+    TEST_ASSERT_NOT_NULL(matches);
+    TEST_ASSERT_NOT_NULL(copied);
+    MatchHistory history = {0};
+    for (size_t i = 0; i < count; ++i) {
+        MatchRecord *m = &matches[i];
+        // Some arrive a little out of order; seeds jump back once
+        m->timestamp = 1700000000 + (int64_t)i * 60 - ((i % 3 == 1) ? 90 : 0);
+        m->seconds = 10.0f + (float)((i * 7919u) % 50000u) / 1000.0f;
+        m->winner = (i < MATCH_HISTORY_BLOCK || i % 3 != 0) ? 'P' : 'A';
+        m->playerScore = (m->winner == 'P') ? 5 : (uint8_t)(i % 5);
+        m->aiScore = (m->winner == 'A') ? 5 : (uint8_t)(i % 5);
+        m->rallies = (uint32_t)(i % 200) + ((i == 5) ? 100000u : 0u);
+        m->seed = (i == 10) ? 7u : 12345u + (uint32_t)i;
+        TEST_ASSERT_TRUE(AppendMatchHistory(&history, m));
+    }
+    TEST_ASSERT_EQUAL_UINT32(count, MatchHistoryCount(&history));
+    TEST_ASSERT_EQUAL_UINT32(2, history.blockCount);
+    TEST_ASSERT_EQUAL_UINT32(0, history.blocks[0].summary.count - history.blocks[0].summary.playerWins);
+
+    // Everything reads back exactly, across block boundaries
+    TEST_ASSERT_EQUAL_UINT32(count, CopyMatchHistory(&history, 0, copied, count));
+    for (size_t i = 0; i < count; ++i) {
+        TEST_ASSERT_TRUE(copied[i].timestamp == matches[i].timestamp);
+        TEST_ASSERT_EQUAL_FLOAT(matches[i].seconds, copied[i].seconds);
+        TEST_ASSERT_EQUAL_INT(matches[i].winner, copied[i].winner);
+        TEST_ASSERT_EQUAL_UINT32(matches[i].playerScore, copied[i].playerScore);
+        TEST_ASSERT_EQUAL_UINT32(matches[i].aiScore, copied[i].aiScore);
+        TEST_ASSERT_EQUAL_UINT32(matches[i].rallies, copied[i].rallies);
+        TEST_ASSERT_EQUAL_UINT32(matches[i].seed, copied[i].seed);
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, CopyMatchHistory(&history, MATCH_HISTORY_BLOCK - 1, copied, 3));
+    TEST_ASSERT_EQUAL_UINT32(matches[MATCH_HISTORY_BLOCK + 1].seed, copied[2].seed);
+    // A few bytes a match, not the 24 of the records
+    TEST_ASSERT_TRUE(history.blocks[1].size < 10u * MATCH_HISTORY_BLOCK);
+
+    MatchQueryStats stats;
+    float seconds = 0.0f;
+    MatchFilter all = { INT64_MIN, INT64_MAX, 0 };
+    const double percentiles[] = { 0.0, 0.1, 0.5, 0.9, 1.0 };
+    for (size_t p = 0; p < sizeof(percentiles) / sizeof(percentiles[0]); ++p) {
+        TEST_ASSERT_TRUE(MatchHistoryPercentile(&history, &all, percentiles[p], &seconds, &stats));
+        TEST_ASSERT_EQUAL_FLOAT(PlainMatchPercentile(matches, count, &all, percentiles[p]), seconds);
+    }
+    TEST_ASSERT_EQUAL_UINT32(count, stats.matches);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.blocksRead);
+
+    // AI wins: the first block's summary rules it out
+    MatchFilter aiWins = { INT64_MIN, INT64_MAX, 'A' };
+    TEST_ASSERT_TRUE(MatchHistoryPercentile(&history, &aiWins, 0.5, &seconds, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(PlainMatchPercentile(matches, count, &aiWins, 0.5), seconds);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.blocksSkipped);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.blocksRead);
+
+    // A range starting inside the second block
+    MatchFilter recent = { matches[count - 150].timestamp, INT64_MAX, 'P' };
+    TEST_ASSERT_TRUE(MatchHistoryPercentile(&history, &recent, 0.5, &seconds, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(PlainMatchPercentile(matches, count, &recent, 0.5), seconds);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.blocksSkipped);
+    TEST_ASSERT_TRUE(stats.matches > 90 && stats.matches < 150);
+
+    MatchFilter before = { 0, 1000, 0 };
+    TEST_ASSERT_FALSE(MatchHistoryPercentile(&history, &before, 0.5, &seconds, &stats));
+    TEST_ASSERT_EQUAL_UINT32(2, stats.blocksSkipped);
+    FreeMatchHistory(&history);
+    TEST_ASSERT_EQUAL_UINT32(0, MatchHistoryCount(&history));
+
+    // Appends store what reads back: milliseconds, scores to 15, 'P' or 'A'
+    MatchRecord odd = { .timestamp = 5, .seconds = 1.23456f, .winner = 'x', .playerScore = 20,
+                        .aiScore = 3, .rallies = 1, .seed = 1 };
+    TEST_ASSERT_TRUE(AppendMatchHistory(&history, &odd));
+    TEST_ASSERT_EQUAL_UINT32(1, CopyMatchHistory(&history, 0, copied, 1));
+    TEST_ASSERT_EQUAL_FLOAT(1.235f, copied[0].seconds);
+    TEST_ASSERT_EQUAL_INT('P', copied[0].winner);
+    TEST_ASSERT_EQUAL_UINT32(15, copied[0].playerScore);
+    FreeMatchHistory(&history);
+    free(matches);
+    free(copied);
+}
+
+static size_t ReadWholeFile(const char *path, unsigned char *out, size_t max) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return 0;
+    size_t size = fread(out, 1, max, file);
+    fclose(file);
+    return size;
+}
+
+static void AppendBytes(const char *path, const void *data, size_t size) {
+    FILE *file = fopen(path, "ab");
+    if (file) {
+        fwrite(data, 1, size, file);
+        fclose(file);
+    }
+}
+
+void test_MatchHistoryLog_SealsBlocksAndRecoversTornWrites(void) {
+    char path[] = "/tmp/purple_history_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        TEST_IGNORE_MESSAGE("Failed to create temp file");
+    }
+    close(fd);
+    remove(path);
+    char tailPath[64];
+    snprintf(tailPath, sizeof(tailPath), "%s.tail", path);
+
+    size_t count = 2 * MATCH_HISTORY_BLOCK;
+    MatchRecord *records = malloc(count * sizeof(MatchRecord));
+    TEST_ASSERT_NOT_NULL(records);
+    for (size_t i = 0; i < count; ++i) {
+        MatchRecord m = { .timestamp = 1700000000 + (int64_t)i,
+                          .seconds = 20.5f + (float)(i % 10), .winner = (i % 2) ? 'A' : 'P',
+                          .playerScore = 1, .aiScore = 5, .rallies = (uint32_t)i,
+                          .seed = (uint32_t)i };
+        records[i] = m;
+    }
+
+    // Past one block in two appends: the block is sealed, the rest in the tail
+    MatchHistoryLog log;
+    TEST_ASSERT_TRUE(OpenMatchHistoryLog(&log, path));
+    TEST_ASSERT_TRUE(AppendMatchHistoryLog(&log, path, records, MATCH_HISTORY_BLOCK - 5));
+    TEST_ASSERT_TRUE(AppendMatchHistoryLog(&log, path, records + MATCH_HISTORY_BLOCK - 5, 15));
+    TEST_ASSERT_TRUE(log.sealed == MATCH_HISTORY_BLOCK);
+    TEST_ASSERT_EQUAL_UINT32(10, log.tailCount);
+    TEST_ASSERT_TRUE(SyncMatchHistoryLog(&log));
+    CloseMatchHistoryLog(&log);
+
+    // Torn writes at the end of both files are dropped
+    const unsigned char junk[40] = { 1, 2, 3 };
+    AppendBytes(tailPath, junk, 11);
+    AppendBytes(path, junk, sizeof(junk));
+    MatchHistory history = {0};
+    TEST_ASSERT_TRUE(LoadMatchHistory(&history, path));
+    TEST_ASSERT_EQUAL_UINT32(MATCH_HISTORY_BLOCK + 10, MatchHistoryCount(&history));
+    TEST_ASSERT_EQUAL_UINT32(1, history.blockCount);
+    MatchRecord last;
+    TEST_ASSERT_EQUAL_UINT32(1, CopyMatchHistory(&history, MATCH_HISTORY_BLOCK + 9, &last, 1));
+    TEST_ASSERT_EQUAL_UINT32(MATCH_HISTORY_BLOCK + 9, last.seed);
+    TEST_ASSERT_EQUAL_FLOAT(records[MATCH_HISTORY_BLOCK + 9].seconds, last.seconds);
+
+    // Reopening trims them; a second writer catches up on refresh
+    MatchHistoryLog other;
+    TEST_ASSERT_TRUE(OpenMatchHistoryLog(&log, path));
+    TEST_ASSERT_TRUE(OpenMatchHistoryLog(&other, path));
+    TEST_ASSERT_EQUAL_UINT32(10, log.tailCount);
+    TEST_ASSERT_TRUE(AppendMatchHistoryLog(&log, path, records + MATCH_HISTORY_BLOCK + 10, 1));
+    TEST_ASSERT_TRUE(RefreshMatchHistoryLog(&other, path));
+    TEST_ASSERT_EQUAL_UINT32(11, other.tailCount);
+
+    // A tail the blocks already hold (a crash between sealing the block and
+    // restarting the tail) adds nothing
+    unsigned char *stale = malloc(64 * 1024);
+    TEST_ASSERT_NOT_NULL(stale);
+    size_t staleSize = ReadWholeFile(tailPath, stale, 64 * 1024);
+    TEST_ASSERT_TRUE(staleSize > 0);
+    TEST_ASSERT_TRUE(AppendMatchHistoryLog(&log, path, records + MATCH_HISTORY_BLOCK + 11,
+                                           MATCH_HISTORY_BLOCK - 11));
+    TEST_ASSERT_TRUE(log.sealed == count);
+    TEST_ASSERT_EQUAL_UINT32(0, log.tailCount);
+    // The other writer picks up the new block without rescanning the first
+    TEST_ASSERT_TRUE(RefreshMatchHistoryLog(&other, path));
+    TEST_ASSERT_TRUE(other.sealed == count);
+    TEST_ASSERT_TRUE(other.blocksSize == log.blocksSize);
+    TEST_ASSERT_EQUAL_UINT32(0, other.tailCount);
+    CloseMatchHistoryLog(&other);
+    CloseMatchHistoryLog(&log);
+    remove(tailPath);
+    AppendBytes(tailPath, stale, staleSize);
+    TEST_ASSERT_TRUE(LoadMatchHistory(&history, path));
+    TEST_ASSERT_EQUAL_UINT32(count, MatchHistoryCount(&history));
+    TEST_ASSERT_EQUAL_UINT32(2, history.blockCount);
+    TEST_ASSERT_TRUE(OpenMatchHistoryLog(&log, path));
+    TEST_ASSERT_EQUAL_UINT32(0, log.tailCount);
+    CloseMatchHistoryLog(&log);
+
+    FreeMatchHistory(&history);
+    free(stale);
+    free(records);
+    remove(path);
+    remove(tailPath);
+}
+
+void test_LeaderboardFile_KeepsFullIndexedHistory(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/purpleboardXXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        TEST_IGNORE_MESSAGE("Failed to create temp file");
+    }
+    close(fd);
+
+    Leaderboard lb = {0};
+    lb.index = CreateScoreIndex(SCORE_INDEX_UNBOUNDED);
+    TEST_ASSERT_NOT_NULL(lb.index);
+    for (int i = 0; i < 50; ++i) {
+        AddLeaderboardEntry(&lb, "ABC", 'P', (float)(50 - i));
+    }
+    TEST_ASSERT_EQUAL_UINT32(LEADERBOARD_MAX_ENTRIES, lb.count);
+    TEST_ASSERT_EQUAL_UINT32(50, LeaderboardTotal(&lb));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, lb.entries[0].seconds);
+    TEST_ASSERT_TRUE(SaveLeaderboardFile(&lb, path));
+
+    Leaderboard loaded = {0};
+    loaded.index = CreateScoreIndex(SCORE_INDEX_UNBOUNDED);
+    TEST_ASSERT_TRUE(LoadLeaderboardFile(&loaded, path));
+    TEST_ASSERT_EQUAL_UINT32(50, LeaderboardTotal(&loaded));
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, loaded.entries[LEADERBOARD_MAX_ENTRIES - 1].seconds);
+    TEST_ASSERT_EQUAL_FLOAT(50.0f, LastScore(loaded.index)->seconds);
+
+    // Without an index only the top entries survive the load
+    Leaderboard plain = {0};
+    TEST_ASSERT_TRUE(LoadLeaderboardFile(&plain, path));
+    TEST_ASSERT_EQUAL_UINT32(LEADERBOARD_MAX_ENTRIES, LeaderboardTotal(&plain));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, plain.entries[0].seconds);
+
+    DestroyScoreIndex(lb.index);
+    DestroyScoreIndex(loaded.index);
+    remove(path);
+}
+
+void test_BoardWriter_AppendsQueuedEntriesOnStop(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/purpleboardXXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        TEST_IGNORE_MESSAGE("Failed to create temp file");
+    }
+    close(fd);
+
+    Leaderboard lb = {0};
+    AddLeaderboardEntry(&lb, "OLD", 'P', 20.0f);
+    TEST_ASSERT_TRUE(SaveLeaderboardFile(&lb, path));
+
+    char journalPath[80], playersPath[80], historyPath[80], historyTailPath[96];
+    snprintf(journalPath, sizeof(journalPath), "%s.journal", path);
+    snprintf(playersPath, sizeof(playersPath), "%s.players", path);
+    snprintf(historyPath, sizeof(historyPath), "%s.history", path);
+    snprintf(historyTailPath, sizeof(historyTailPath), "%s.tail", historyPath);
+    BoardWriterConfig config = DefaultBoardWriterConfig();
+    config.compactRecords = 16;  // Force compactions along the way
+    BoardWriter writer;
+    TEST_ASSERT_TRUE(StartBoardWriter(&writer, path, journalPath, playersPath, historyPath, NULL,
+                                      &config));
+    for (int i = 0; i < 40; ++i) {
+        LeaderboardEntry e = AddLeaderboardEntry(&lb, "new", 'A', 30.0f - (float)i * 0.5f);
+        TEST_ASSERT_EQUAL_STRING("NEW", e.initials);
+        // Every other result comes without a match record
+        MatchRecord match = { .timestamp = e.timestamp, .seconds = e.seconds, .winner = 'A',
+                              .playerScore = 2, .aiScore = 5, .rallies = 10,
+                              .seed = (uint32_t)i };
+        TEST_ASSERT_TRUE(QueueBoardEntry(&writer, &e, (i % 2 == 0) ? "old" : NULL,
+                                         (i % 2 == 0) ? &match : NULL));
+    }
+    StopBoardWriter(&writer);
+    TEST_ASSERT_EQUAL_UINT32(40, writer.saved);
+    TEST_ASSERT_TRUE(writer.saves >= 1 && writer.saves <= 40);
+    TEST_ASSERT_TRUE(writer.syncs >= 1);
+    TEST_ASSERT_FALSE(QueueBoardEntry(&writer, &lb.entries[0], NULL, NULL));  // Stopped
+    TEST_ASSERT_TRUE(writer.playerSaves >= 1);
+    TEST_ASSERT_EQUAL_UINT32(20, writer.historySaved);
+
+    // The history holds the match records, in order
+    MatchHistory history = {0};
+    TEST_ASSERT_TRUE(LoadMatchHistory(&history, historyPath));
+    TEST_ASSERT_EQUAL_UINT32(20, MatchHistoryCount(&history));
+    MatchRecord matches[20];
+    TEST_ASSERT_EQUAL_UINT32(20, CopyMatchHistory(&history, 0, matches, 20));
+    TEST_ASSERT_EQUAL_UINT32(38, matches[19].seed);
+    TEST_ASSERT_EQUAL_FLOAT(11.0f, matches[19].seconds);
+    TEST_ASSERT_EQUAL_UINT32(5, matches[19].aiScore);
+    FreeMatchHistory(&history);
+    remove(historyPath);
+    remove(historyTailPath);
+
+    // The writer's copy of the player stats saw every result
+    PlayerStatsStore players = {0};
+    TEST_ASSERT_TRUE(LoadPlayerStats(&players, playersPath));
+    TEST_ASSERT_EQUAL_UINT32(2, players.count);
+    const PlayerStats *winner = FindPlayerStats(&players, "NEW");
+    TEST_ASSERT_NOT_NULL(winner);
+    TEST_ASSERT_EQUAL_UINT32(40, winner->wins);
+    TEST_ASSERT_EQUAL_FLOAT(10.5f, winner->bestSeconds);
+    TEST_ASSERT_EQUAL_UINT32(20, FindPlayerStats(&players, "OLD")->losses);
+    FreePlayerStatsStore(&players);
+    remove(playersPath);
+
+    // Snapshot plus journal tail: every result exactly once
+    Leaderboard loaded = {0};
+    loaded.index = CreateScoreIndex(SCORE_INDEX_UNBOUNDED);
+    TEST_ASSERT_TRUE(LoadLeaderboardJournaled(&loaded, path, journalPath));
+    TEST_ASSERT_EQUAL_UINT32(41, LeaderboardTotal(&loaded));
+    TEST_ASSERT_EQUAL_FLOAT(10.5f, loaded.entries[0].seconds);
+    TEST_ASSERT_EQUAL_UINT32(20, LeaderboardRank(&loaded, 20.0f));
+    DestroyScoreIndex(loaded.index);
+
+    // Appending to a missing file starts a new board
+    remove(path);
+    LeaderboardEntry first = AddLeaderboardEntry(NULL, "abc", 'P', 5.0f);
+    TEST_ASSERT_TRUE(AppendLeaderboardFile(path, &first, 1));
+    Leaderboard fresh = {0};
+    TEST_ASSERT_TRUE(LoadLeaderboardFile(&fresh, path));
+    TEST_ASSERT_EQUAL_UINT32(1, fresh.count);
+    TEST_ASSERT_EQUAL_STRING("ABC", fresh.entries[0].initials);
+    remove(path);
+    remove(journalPath);
+}
+
+// Stands in for another game instance publishing results one by one
+typedef struct {
+    SharedBoard *board;
+    int count;
+} SharedPublisher;
+
+static void *PublishSharedThread(void *arg)
+{
+    SharedPublisher *publisher = (SharedPublisher *)arg;
+    for (int i = 0; i < publisher->count; ++i) {
+        BoardResult result = { AddLeaderboardEntry(NULL, "Q", 'A', (float)i), "", false, {0} };
+        result.entry.initials[1] = (char)('A' + i % 26);
+        LockSharedBoard(publisher->board);
+        PublishSharedResults(publisher->board, &result, 1);
+        UnlockSharedBoard(publisher->board);
+    }
+    return NULL;
+}
+
+void test_SharedBoard_DeliversOtherInstancesResults(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/purplesharedXXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        TEST_IGNORE_MESSAGE("Failed to create temp file");
+    }
+    close(fd);
+
+    // Two handles on one file behave like two processes (flock is per open)
+    SharedBoard mine, other;
+    TEST_ASSERT_TRUE(OpenSharedBoard(&mine, path));
+    TEST_ASSERT_TRUE(OpenSharedBoard(&other, path));
+    other.instance = mine.instance + 1u;
+
+    BoardResult results[3] = {
+        { AddLeaderboardEntry(NULL, "abc", 'P', 12.5f), "AI", false, {0} },
+        { AddLeaderboardEntry(NULL, "AI", 'A', 30.0f), "ABC", false, {0} },
+        { AddLeaderboardEntry(NULL, "xy", 'P', 9.0f), "", false, {0} },
+    };
+    TEST_ASSERT_TRUE(LockSharedBoard(&other));
+    PublishSharedResults(&other, results, 3);
+    UnlockSharedBoard(&other);
+
+    BoardResult got[SHARED_BOARD_POLL_MAX];
+    TEST_ASSERT_EQUAL_UINT32(0, PollSharedBoard(&other, got, SHARED_BOARD_POLL_MAX));  // Its own
+    TEST_ASSERT_EQUAL_UINT32(3, PollSharedBoard(&mine, got, SHARED_BOARD_POLL_MAX));
+    TEST_ASSERT_EQUAL_STRING("ABC", got[0].entry.initials);
+    TEST_ASSERT_EQUAL_STRING("AI", got[0].loser);
+    TEST_ASSERT_EQUAL_INT('A', got[1].entry.winner);
+    TEST_ASSERT_EQUAL_STRING("ABC", got[1].loser);
+    TEST_ASSERT_EQUAL_STRING("XY ", got[2].entry.initials);
+    TEST_ASSERT_EQUAL_STRING("", got[2].loser);
+    TEST_ASSERT_EQUAL_FLOAT(9.0f, got[2].entry.seconds);
+    TEST_ASSERT_EQUAL_UINT32(0, PollSharedBoard(&mine, got, SHARED_BOARD_POLL_MAX));
+
+    // A reader that falls a whole ring behind skips ahead and counts the loss
+    SharedPublisher burst = { &other, SHARED_BOARD_RING + 10 };
+    PublishSharedThread(&burst);
+    TEST_ASSERT_EQUAL_UINT32(SHARED_BOARD_POLL_MAX,
+                             PollSharedBoard(&mine, got, SHARED_BOARD_POLL_MAX));
+    TEST_ASSERT_EQUAL_UINT32(10, mine.missed);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, got[0].entry.seconds);
+    mine.seen = SharedBoardPublished(&mine);
+    mine.missed = 0;
+
+    // Concurrent publisher: every result read is whole, none twice
+    SharedPublisher publisher = { &other, 20000 };
+    pthread_t thread;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, PublishSharedThread, &publisher));
+    uint64_t start = mine.seen;
+    uint64_t received = 0;
+    float last = -1.0f;
+    bool consistent = true;
+    while (mine.seen - start < (uint64_t)publisher.count) {
+        size_t n = PollSharedBoard(&mine, got, SHARED_BOARD_POLL_MAX);
+        for (size_t i = 0; i < n; ++i) {
+            int seconds = (int)got[i].entry.seconds;
+            consistent = consistent && got[i].entry.seconds > last &&
+                         got[i].entry.initials[1] == (char)('A' + seconds % 26);
+            last = got[i].entry.seconds;
+        }
+        received += n;
+    }
+    pthread_join(thread, NULL);
+    TEST_ASSERT_TRUE(consistent);
+    TEST_ASSERT_EQUAL_UINT32(publisher.count, received + mine.missed);
+
+    CloseSharedBoard(&mine);
+    CloseSharedBoard(&other);
+    TEST_ASSERT_EQUAL_UINT32(0, PollSharedBoard(&mine, got, SHARED_BOARD_POLL_MAX));
+    remove(path);
+}
+
+void test_LeaderboardJournal_RefreshSeesOtherWriters(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/purpleboardXXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        TEST_IGNORE_MESSAGE("Failed to create temp file");
+    }
+    close(fd);
+    char journalPath[80];
+    snprintf(journalPath, sizeof(journalPath), "%s.journal", path);
+
+    Leaderboard lb = {0};
+    AddLeaderboardEntry(&lb, "OLD", 'P', 50.0f);
+    TEST_ASSERT_TRUE(SaveLeaderboardFile(&lb, path));
+
+    // Two writers, as in two game instances, taking turns as under a lock
+    LeaderboardJournal a, b;
+    TEST_ASSERT_TRUE(OpenLeaderboardJournal(&a, journalPath, path));
+    TEST_ASSERT_TRUE(OpenLeaderboardJournal(&b, journalPath, path));
+    LeaderboardEntry e = AddLeaderboardEntry(NULL, "AAA", 'P', 10.0f);
+    TEST_ASSERT_TRUE(AppendLeaderboardJournal(&a, &e, 1));
+    TEST_ASSERT_TRUE(AppendLeaderboardJournal(&a, &e, 1));
+    TEST_ASSERT_TRUE(RefreshLeaderboardJournal(&b, journalPath, path));
+    TEST_ASSERT_EQUAL_UINT32(2, b.records);
+    e = AddLeaderboardEntry(NULL, "BBB", 'P', 20.0f);
+    TEST_ASSERT_TRUE(AppendLeaderboardJournal(&b, &e, 1));
+
+    // a folds the journal into the snapshot; b must follow it to the new file
+    TEST_ASSERT_TRUE(RefreshLeaderboardJournal(&a, journalPath, path));
+    TEST_ASSERT_EQUAL_UINT32(3, a.records);
+    TEST_ASSERT_TRUE(CompactLeaderboardJournal(&a, journalPath, path));
+    TEST_ASSERT_TRUE(RefreshLeaderboardJournal(&b, journalPath, path));
+    TEST_ASSERT_EQUAL_UINT32(0, b.records);
+    TEST_ASSERT_EQUAL_UINT32(a.generation, b.generation);
+    TEST_ASSERT_TRUE(AppendLeaderboardJournal(&b, &e, 1));
+
+    Leaderboard loaded = {0};
+    loaded.index = CreateScoreIndex(SCORE_INDEX_UNBOUNDED);
+    TEST_ASSERT_TRUE(LoadLeaderboardJournaled(&loaded, path, journalPath));
+    TEST_ASSERT_EQUAL_UINT32(5, LeaderboardTotal(&loaded));
+    TEST_ASSERT_EQUAL_UINT32(5, LeaderboardRank(&loaded, 50.0f));
+
+    CloseLeaderboardJournal(&a);
+    CloseLeaderboardJournal(&b);
+    DestroyScoreIndex(loaded.index);
+    remove(path);
+    remove(journalPath);
+}
+
+void test_PlayerStats_TracksStreaksAndGrowsTable(void) {
+    PlayerStatsStore store = {0};
+    TEST_ASSERT_NULL(FindPlayerStats(&store, "ABC"));
+
+    TEST_ASSERT_TRUE(RecordMatchResult(&store, "abc", "AI", 20.0f));
+    TEST_ASSERT_TRUE(RecordMatchResult(&store, "ABC", "AI", 10.0f));
+    TEST_ASSERT_TRUE(RecordMatchResult(&store, "AI", "ab", 30.0f));
+    TEST_ASSERT_TRUE(RecordMatchResult(&store, "ab ", NULL, 15.0f));
+    const PlayerStats *abc = FindPlayerStats(&store, "abc");
+    TEST_ASSERT_NOT_NULL(abc);
+    TEST_ASSERT_EQUAL_UINT32(2, abc->wins);
+    TEST_ASSERT_EQUAL_UINT32(0, abc->losses);
+    TEST_ASSERT_EQUAL_UINT32(2, abc->streak);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, abc->bestSeconds);
+    TEST_ASSERT_EQUAL_FLOAT(15.0f, PlayerMeanSeconds(abc));
+    const PlayerStats *ai = FindPlayerStats(&store, "AI");
+    TEST_ASSERT_EQUAL_UINT32(1, ai->wins);
+    TEST_ASSERT_EQUAL_UINT32(2, ai->losses);
+    TEST_ASSERT_EQUAL_UINT32(1, ai->streak);
+    TEST_ASSERT_EQUAL_UINT32(1, ai->bestStreak);
+    // "AB" and "AB " are the same player
+    TEST_ASSERT_EQUAL_UINT32(1, FindPlayerStats(&store, "AB")->wins);
+    TEST_ASSERT_EQUAL_UINT32(1, FindPlayerStats(&store, "AB")->losses);
+    TEST_ASSERT_EQUAL_UINT32(3, store.count);
+
+    // Enough players to grow the table several times; every one still found
+    char name[4] = "AAA";
+    for (int i = 0; i < 2000; ++i) {
+        name[0] = (char)('A' + i % 26);
+        name[1] = (char)('A' + (i / 26) % 26);
+        name[2] = (char)('0' + i / 676);
+        TEST_ASSERT_TRUE(RecordMatchResult(&store, name, NULL, (float)i + 1.0f));
+    }
+    TEST_ASSERT_EQUAL_UINT32(2003, store.count);
+    TEST_ASSERT_TRUE(store.count * 10 <= store.capacity * 7);
+    TEST_ASSERT_EQUAL_FLOAT(1235.0f, FindPlayerStats(&store, "MV1")->bestSeconds);
+    TEST_ASSERT_EQUAL_UINT32(2, FindPlayerStats(&store, "ABC")->wins);  // Moved by the rehash
+
+    // Round trip through the stats file
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/purpleplayersXXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        FreePlayerStatsStore(&store);
+        TEST_IGNORE_MESSAGE("Failed to create temp file");
+    }
+    close(fd);
+    TEST_ASSERT_TRUE(SavePlayerStats(&store, path));
+    PlayerStatsStore loaded = {0};
+    TEST_ASSERT_TRUE(LoadPlayerStats(&loaded, path));
+    TEST_ASSERT_EQUAL_UINT32(store.count, loaded.count);
+    const PlayerStats *copy = FindPlayerStats(&loaded, "ABC");
+    TEST_ASSERT_EQUAL_UINT32(2, copy->streak);
+    TEST_ASSERT_EQUAL_FLOAT(15.0f, PlayerMeanSeconds(copy));
+
+    // A flipped byte is caught by the checksum and the store left as it was
+    FILE *fp = fopen(path, "r+b");
+    TEST_ASSERT_NOT_NULL(fp);
+    fseek(fp, 40, SEEK_SET);
+    fputc('z', fp);
+    fclose(fp);
+    TEST_ASSERT_FALSE(LoadPlayerStats(&loaded, path));
+    TEST_ASSERT_EQUAL_UINT32(store.count, loaded.count);
+
+    FreePlayerStatsStore(&store);
+    FreePlayerStatsStore(&loaded);
+    remove(path);
+}
+
+void test_LeaderboardJournal_ReplaysOnlyMatchingGeneration(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/purpleboardXXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        TEST_IGNORE_MESSAGE("Failed to create temp file");
+    }
+    close(fd);
+    char journalPath[80];
+    snprintf(journalPath, sizeof(journalPath), "%s.journal", path);
+
+    Leaderboard lb = {0};
+    AddLeaderboardEntry(&lb, "SNP", 'P', 9.0f);
+    TEST_ASSERT_TRUE(SaveLeaderboardFile(&lb, path));
+
+    LeaderboardJournal journal;
+    LeaderboardEntry e[3] = { { "JA", 'P', 3.0f, 0 }, { "JB", 'A', 4.0f, 0 }, { "JC", 'P', 5.0f, 0 } };
+    TEST_ASSERT_TRUE(OpenLeaderboardJournal(&journal, journalPath, path));
+    TEST_ASSERT_TRUE(AppendLeaderboardJournal(&journal, e, 3));
+    TEST_ASSERT_TRUE(SyncLeaderboardJournal(&journal));
+    CloseLeaderboardJournal(&journal);
+
+    // A torn final record is ignored on load and cut off on reopen
+    FILE *fp = fopen(journalPath, "ab");
+    TEST_ASSERT_NOT_NULL(fp);
+    fwrite("torn...", 1, 7, fp);
+    fclose(fp);
+    Leaderboard loaded = {0};
+    TEST_ASSERT_TRUE(LoadLeaderboardJournaled(&loaded, path, journalPath));
+    TEST_ASSERT_EQUAL_UINT32(4, loaded.count);
+    TEST_ASSERT_TRUE(OpenLeaderboardJournal(&journal, journalPath, path));
+    TEST_ASSERT_EQUAL_UINT32(3, journal.records);
+    TEST_ASSERT_TRUE(AppendLeaderboardJournal(&journal, e, 1));
+
+    CloseLeaderboardJournal(&journal);
+
+    // Crash between writing the compacted snapshot and resetting the
+    // journal: the old journal names the old generation and is skipped
+    unsigned char saved[256];
+    fp = fopen(journalPath, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+    size_t savedSize = fread(saved, 1, sizeof(saved), fp);
+    fclose(fp);
+    TEST_ASSERT_TRUE(OpenLeaderboardJournal(&journal, journalPath, path));
+    TEST_ASSERT_EQUAL_UINT32(4, journal.records);
+    TEST_ASSERT_TRUE(CompactLeaderboardJournal(&journal, journalPath, path));
+    TEST_ASSERT_EQUAL_UINT32(0, journal.records);
+    CloseLeaderboardJournal(&journal);
+    fp = fopen(journalPath, "wb");
+    TEST_ASSERT_NOT_NULL(fp);
+    fwrite(saved, 1, savedSize, fp);
+    fclose(fp);
+
+    Leaderboard compacted = {0};
+    TEST_ASSERT_TRUE(LoadLeaderboardJournaled(&compacted, path, journalPath));
+    TEST_ASSERT_EQUAL_UINT32(5, compacted.count);
+    TEST_ASSERT_EQUAL_STRING("JA", compacted.entries[0].initials);
+    TEST_ASSERT_TRUE(OpenLeaderboardJournal(&journal, journalPath, path));
+    TEST_ASSERT_EQUAL_UINT32(0, journal.records);  // Stale journal restarted
+    CloseLeaderboardJournal(&journal);
+
+    remove(path);
+    remove(journalPath);
+}
+
+// A version 1 record: 12 bytes, no timestamp
+static unsigned char *PutV1Record(unsigned char *p, const char *initials, char winner,
+                                  float seconds)
+{
+    uint32_t bits;
+    memcpy(&bits, &seconds, sizeof(bits));
+    memset(p, 0, 8);
+    memcpy(p, initials, 3);
+    p[4] = (unsigned char)winner;
+    return PutU32(p + 8, bits);
+}
+
+static uint32_t ReadHeaderWord(const char *path, size_t offset)
+{
+    unsigned char word[4] = {0};
+    uint32_t value = 0;
+    FILE *fp = fopen(path, "rb");
+    if (fp != NULL) {
+        if (fseek(fp, (long)offset, SEEK_SET) == 0 && fread(word, 1, 4, fp) == 4) {
+            GetU32(word, &value);
+        }
+        fclose(fp);
+    }
+    return value;
+}
+
+void test_LeaderboardJournal_MigratesVersion1Files(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/purpleboardXXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        TEST_IGNORE_MESSAGE("Failed to create temp file");
+    }
+    close(fd);
+    char journalPath[80];
+    snprintf(journalPath, sizeof(journalPath), "%s.journal", path);
+
+    // Version 1 snapshot at generation 7 and a version 1 journal after it
+    unsigned char snapshot[8 + 16 + 2 * 12 + 4];
+    memcpy(snapshot, "PRPLLDBD", 8);
+    unsigned char *p = PutU32(PutU32(PutU32(PutU32(snapshot + 8, 1u), 12u), 2u), 7u);
+    p = PutV1Record(PutV1Record(p, "OLD", 'A', 7.5f), "ABC", 'P', 5.25f);
+    PutU32(p, Fnv1a(FNV1A_SEED, snapshot, (size_t)(p - snapshot)));
+    unsigned char journalFile[8 + 8 + 2 * 16];
+    memcpy(journalFile, "PRPLJRNL", 8);
+    p = PutU32(PutU32(journalFile + 8, 1u), 7u);
+    for (int i = 0; i < 2; ++i) {
+        unsigned char *record = p;
+        p = PutV1Record(record, i == 0 ? "JRA" : "JRB", i == 0 ? 'P' : 'A', 3.0f + (float)i);
+        p = PutU32(p, Fnv1a(FNV1A_SEED, record, 12));
+    }
+    FILE *fp = fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(fp);
+    fwrite(snapshot, 1, sizeof(snapshot), fp);
+    fclose(fp);
+    fp = fopen(journalPath, "wb");
+    TEST_ASSERT_NOT_NULL(fp);
+    fwrite(journalFile, 1, sizeof(journalFile), fp);
+    fclose(fp);
+
+    // Both load, records unstamped
+    Leaderboard loaded = {0};
+    TEST_ASSERT_TRUE(LoadLeaderboardJournaled(&loaded, path, journalPath));
+    TEST_ASSERT_EQUAL_UINT32(4, loaded.count);
+    TEST_ASSERT_EQUAL_STRING("JRA", loaded.entries[0].initials);
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, loaded.entries[1].seconds);
+    TEST_ASSERT_EQUAL_INT('A', loaded.entries[1].winner);
+    TEST_ASSERT_EQUAL_STRING("OLD", loaded.entries[3].initials);
+    TEST_ASSERT_TRUE(loaded.entries[3].timestamp == 0);
+
+    // Opening for appends folds the old journal into a version 2 snapshot
+    // at the next generation and starts an empty version 2 journal
+    LeaderboardJournal journal;
+    TEST_ASSERT_TRUE(OpenLeaderboardJournal(&journal, journalPath, path));
+    TEST_ASSERT_EQUAL_UINT32(8, journal.generation);
+    TEST_ASSERT_EQUAL_UINT32(0, journal.records);
+    TEST_ASSERT_EQUAL_UINT32(2, ReadHeaderWord(path, 8));    // Version
+    TEST_ASSERT_EQUAL_UINT32(20, ReadHeaderWord(path, 12));  // Record size
+    TEST_ASSERT_EQUAL_UINT32(4, ReadHeaderWord(path, 16));   // Count
+    TEST_ASSERT_EQUAL_UINT32(8, ReadHeaderWord(path, 20));   // Generation
+    TEST_ASSERT_EQUAL_UINT32(2, ReadHeaderWord(journalPath, 8));
+    TEST_ASSERT_EQUAL_UINT32(8, ReadHeaderWord(journalPath, 12));
+
+    // New results append in the current format and survive a reload
+    LeaderboardEntry e = { "NEW", 'P', 2.0f, 1767222000 };
+    TEST_ASSERT_TRUE(AppendLeaderboardJournal(&journal, &e, 1));
+    TEST_ASSERT_TRUE(SyncLeaderboardJournal(&journal));
+    CloseLeaderboardJournal(&journal);
+    Leaderboard reloaded = {0};
+    TEST_ASSERT_TRUE(LoadLeaderboardJournaled(&reloaded, path, journalPath));
+    TEST_ASSERT_EQUAL_UINT32(5, reloaded.count);
+    TEST_ASSERT_EQUAL_STRING("NEW", reloaded.entries[0].initials);
+    TEST_ASSERT_TRUE(reloaded.entries[0].timestamp == 1767222000);
+    TEST_ASSERT_EQUAL_STRING("JRA", reloaded.entries[1].initials);
+    TEST_ASSERT_EQUAL_STRING("OLD", reloaded.entries[4].initials);
+    TEST_ASSERT_TRUE(reloaded.entries[4].timestamp == 0);
+
+    remove(path);
+    remove(journalPath);
+}
+
 void test_AddLeaderboardEntry_ZeroTime(void) {
     Leaderboard lb = {0};
     AddLeaderboardEntry(&lb, "ABC", 'P', 0.0f);
@@ -1049,6 +2127,366 @@ void test_AddLeaderboardEntry_MaintainsSortAfterMultipleAdds(void) {
     TEST_ASSERT_EQUAL_FLOAT(10.0f, lb.entries[0].seconds);
 }
 
+void test_AddLeaderboardEntry_BumpsRevisionOnlyOnChange(void) {
+    Leaderboard lb = {0};
+    for (int i = 0; i < (int)LEADERBOARD_MAX_ENTRIES; ++i) {
+        AddLeaderboardEntry(&lb, "AAA", 'P', (float)(i + 1));
+    }
+    unsigned int revision = lb.revision;
+
+    // Too slow to enter the board: nothing to redraw
+    AddLeaderboardEntry(&lb, "ZZZ", 'P', 50.0f);
+    TEST_ASSERT_EQUAL_UINT(revision, lb.revision);
+
+    AddLeaderboardEntry(&lb, "BBB", 'P', 0.5f);
+    TEST_ASSERT_TRUE(lb.revision != revision);
+}
+
+// ==================== Simulation and Checkpoint Tests ====================
+
+void test_SimLane_IsDeterministic(void) {
+    SimConfig config;
+    InitSimConfig(&config);
+    SimLane a, b;
+    InitSimLane(&a, &config, 42, 3);
+    InitSimLane(&b, &config, 42, 3);
+
+    StepSimLane(&a, &config, UINT64_MAX);
+    StepSimLane(&b, &config, UINT64_MAX);
+
+    TEST_ASSERT_TRUE(IsSimLaneDone(&a));
+    TEST_ASSERT_EQUAL_UINT(3, a.stats.matches);
+    TEST_ASSERT_EQUAL_UINT(a.stats.frames, b.stats.frames);
+    TEST_ASSERT_EQUAL_UINT(a.stats.rallies, b.stats.rallies);
+    TEST_ASSERT_EQUAL_UINT(a.stats.leftWins, b.stats.leftWins);
+}
+
+void test_SimCheckpoint_ResumeIsBitIdentical(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/purplecheckpointXXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        TEST_IGNORE_MESSAGE("Failed to create temp file");
+    }
+    close(fd);
+
+    SimConfig config;
+    InitSimConfig(&config);
+    SimLane straight, interrupted, resumed;
+    InitSimLane(&straight, &config, 7, 2);
+    InitSimLane(&interrupted, &config, 7, 2);
+    StepSimLane(&straight, &config, UINT64_MAX);
+
+    // Stop mid-match, checkpoint, and carry on from the file
+    StepSimLane(&interrupted, &config, 12345);
+    TEST_ASSERT_TRUE(SaveSimCheckpoint(path, &config, 7, &interrupted, 1));
+
+    SimConfig loadedConfig;
+    uint64_t seed = 0;
+    size_t laneCount = 0;
+    TEST_ASSERT_TRUE(LoadSimCheckpoint(path, &loadedConfig, &seed, &resumed, 1, &laneCount));
+    TEST_ASSERT_EQUAL_UINT(1, laneCount);
+    TEST_ASSERT_EQUAL_UINT(7, seed);
+    StepSimLane(&resumed, &loadedConfig, UINT64_MAX);
+
+    TEST_ASSERT_EQUAL_UINT(straight.stats.frames, resumed.stats.frames);
+    TEST_ASSERT_EQUAL_UINT(straight.stats.rallies, resumed.stats.rallies);
+    TEST_ASSERT_EQUAL_UINT(straight.rng.state, resumed.rng.state);
+    TEST_ASSERT_TRUE(memcmp(&straight.ball, &resumed.ball, sizeof(Ball)) == 0);
+    remove(path);
+}
+
+void test_LoadSimCheckpoint_RejectsCorruptFile(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/purplecheckpointXXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        TEST_IGNORE_MESSAGE("Failed to create temp file");
+    }
+    close(fd);
+
+    SimConfig config;
+    InitSimConfig(&config);
+    SimLane lane;
+    InitSimLane(&lane, &config, 1, 1);
+    TEST_ASSERT_TRUE(SaveSimCheckpoint(path, &config, 1, &lane, 1));
+
+    // Flip one byte in the middle of the lane record
+    FILE *fp = fopen(path, "r+b");
+    TEST_ASSERT_NOT_NULL(fp);
+    fseek(fp, 60, SEEK_SET);
+    int c = fgetc(fp);
+    fseek(fp, 60, SEEK_SET);
+    fputc(c ^ 0xFF, fp);
+    fclose(fp);
+
+    uint64_t seed = 0;
+    size_t laneCount = 0;
+    TEST_ASSERT_FALSE(LoadSimCheckpoint(path, &config, &seed, &lane, 1, &laneCount));
+    remove(path);
+}
+
+// ==================== Text Cache Tests ====================
+
+// Three-glyph font: 'A' and 'B' 10px wide, space advances 5px
+static Font MakeTestFont(GlyphInfo *glyphs, Rectangle *recs) {
+    const int values[3] = {' ', 'A', 'B'};
+    for (int i = 0; i < 3; ++i) {
+        glyphs[i] = (GlyphInfo){ .value = values[i], .offsetX = 0, .offsetY = 2,
+                                 .advanceX = (i == 0) ? 5 : 10 };
+        recs[i] = (Rectangle){ (float)(i * 12), 0.0f, 10.0f, 16.0f };
+    }
+    Font font = { .baseSize = 16, .glyphCount = 3, .glyphPadding = 1,
+                  .texture = { .id = 7 }, .recs = recs, .glyphs = glyphs };
+    return font;
+}
+
+void test_GetTextRun_CachesLayout(void) {
+    GlyphInfo glyphs[3];
+    Rectangle recs[3];
+    Font font = MakeTestFont(glyphs, recs);
+    ClearTextCache();
+
+    const TextRun *first = GetTextRun(font, "AB A", 32.0f, 1.0f);
+    TEST_ASSERT_NOT_NULL(first);
+    // Spaces advance the pen but emit no quad
+    TEST_ASSERT_EQUAL_INT(3, first->quadCount);
+    // (10 + 10 + 5 + 10) * 2 scale + 3 gaps of spacing
+    TEST_ASSERT_EQUAL_FLOAT(73.0f, first->size.x);
+    TEST_ASSERT_EQUAL_FLOAT(32.0f, first->size.y);
+    TEST_ASSERT_EQUAL_FLOAT(19.0f, first->quads[1].dest.x);  // Pen 21 minus padding
+
+    const TextRun *second = GetTextRun(font, "AB A", 32.0f, 1.0f);
+    TEST_ASSERT_EQUAL_PTR(first, second);
+    TEST_ASSERT_TRUE(GetTextRun(font, "AB A", 24.0f, 1.0f) != first);
+}
+
+void test_GetTextRun_RejectsUncacheableText(void) {
+    GlyphInfo glyphs[3];
+    Rectangle recs[3];
+    Font font = MakeTestFont(glyphs, recs);
+    ClearTextCache();
+
+    TEST_ASSERT_NULL(GetTextRun(font, "A\nB", 16.0f, 1.0f));
+    TEST_ASSERT_NULL(GetTextRun(font, NULL, 16.0f, 1.0f));
+    char longText[TEXT_RUN_MAX_TEXT + 1];
+    memset(longText, 'A', TEXT_RUN_MAX_TEXT);
+    longText[TEXT_RUN_MAX_TEXT] = '\0';
+    TEST_ASSERT_NULL(GetTextRun(font, longText, 16.0f, 1.0f));
+}
+
+void test_SetHudLabelNumber_RebuildsOnlyOnChange(void) {
+    GlyphInfo glyphs[3];
+    Rectangle recs[3];
+    Font font = MakeTestFont(glyphs, recs);
+    ClearTextCache();
+
+    HudLabel label;
+    InitHudLabel(&label, font, 16.0f, 1.0f);
+    TEST_ASSERT_TRUE(IsHudLabelStale(&label, 0));
+    TEST_ASSERT_TRUE(SetHudLabelNumber(&label, "A", 0));
+    TEST_ASSERT_FALSE(SetHudLabelNumber(&label, "A", 0));
+    TEST_ASSERT_EQUAL_UINT(1, label.updates);
+    TEST_ASSERT_EQUAL_STRING("A0", label.text);
+
+    // The label keeps its own layout even after the shared cache is cleared
+    TEST_ASSERT_TRUE(label.hasRun);
+    ClearTextCache();
+    TEST_ASSERT_EQUAL_STRING("A0", label.run.text);
+
+    TEST_ASSERT_TRUE(SetHudLabelNumber(&label, "A", 3));
+    TEST_ASSERT_EQUAL_UINT(2, label.updates);
+    TEST_ASSERT_EQUAL_STRING("A3", label.text);
+}
+
+void test_ComputeFrameStats_NearestRankPercentiles(void) {
+    float samples[100];
+    for (int i = 0; i < 100; ++i) {
+        samples[i] = (float)(100 - i);  // Unsorted on purpose
+    }
+    FrameStats stats;
+    ComputeFrameStats(samples, 100, &stats);
+    TEST_ASSERT_EQUAL_FLOAT(50.0f, stats.p50);
+    TEST_ASSERT_EQUAL_FLOAT(99.0f, stats.p99);
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, stats.max);
+
+    ComputeFrameStats(samples, 0, &stats);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, stats.max);
+}
+
+void test_BuildFrameHistogram_ClampsOutliers(void) {
+    const float samples[] = { 0.2f, 0.9f, 16.5f, 1000.0f, -3.0f, INFINITY };
+    unsigned int buckets[PROFILER_HISTOGRAM_BUCKETS];
+    BuildFrameHistogram(samples, 6, buckets);
+    TEST_ASSERT_EQUAL_UINT(3, buckets[0]);
+    TEST_ASSERT_EQUAL_UINT(1, buckets[16]);
+    TEST_ASSERT_EQUAL_UINT(2, buckets[PROFILER_HISTOGRAM_BUCKETS - 1]);
+}
+
+void test_GetFramePhaseSamples_ReturnsOldestFirstAfterWrap(void) {
+    static FrameProfiler profiler;
+    memset(&profiler, 0, sizeof(profiler));
+    for (int i = 0; i < PROFILER_HISTORY + 3; ++i) {
+        BeginFrameProfile(&profiler);
+        EndFrameProfile(&profiler);
+        // Overwrite the recorded total with a known value
+        profiler.history[FRAME_PHASE_TOTAL][(profiler.head + PROFILER_HISTORY - 1) %
+                                            PROFILER_HISTORY] = (float)i;
+    }
+    float samples[PROFILER_HISTORY];
+    size_t count = GetFramePhaseSamples(&profiler, FRAME_PHASE_TOTAL, samples,
+                                        PROFILER_HISTORY);
+    TEST_ASSERT_EQUAL_size_t(PROFILER_HISTORY, count);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, samples[0]);
+    TEST_ASSERT_EQUAL_FLOAT((float)(PROFILER_HISTORY + 2), samples[PROFILER_HISTORY - 1]);
+}
+
+void test_InputFrame_QueuesCharsUntilReset(void) {
+    InputFrame input = {0};
+    input.down[INPUT_UP] = true;
+    input.pressed[INPUT_ENTER] = true;
+    for (int i = 0; i < INPUT_MAX_CHARS + 4; ++i) {
+        PushInputChar(&input, 'A' + i);
+    }
+    TEST_ASSERT_EQUAL_INT(INPUT_MAX_CHARS, input.charCount);
+    TEST_ASSERT_EQUAL_INT('A', PopInputChar(&input));
+    TEST_ASSERT_EQUAL_INT('B', PopInputChar(&input));
+
+    // Reset drops edges and characters but keeps held keys
+    ResetInputFrame(&input);
+    TEST_ASSERT_EQUAL_INT(0, PopInputChar(&input));
+    TEST_ASSERT_FALSE(IsInputPressed(&input, INPUT_ENTER));
+    TEST_ASSERT_TRUE(IsInputDown(&input, INPUT_UP));
+    TEST_ASSERT_FALSE(IsInputDown(NULL, INPUT_UP));
+}
+
+void test_HasInputActivity_SeesHeldKeysAndChars(void) {
+    InputFrame input = {0};
+    TEST_ASSERT_FALSE(HasInputActivity(&input));
+    PushInputChar(&input, 'x');
+    TEST_ASSERT_TRUE(HasInputActivity(&input));
+    ResetInputFrame(&input);
+    TEST_ASSERT_FALSE(HasInputActivity(&input));
+    input.down[INPUT_DOWN] = true;
+    TEST_ASSERT_TRUE(HasInputActivity(&input));
+    TEST_ASSERT_FALSE(HasInputActivity(NULL));
+}
+
+void test_NextFrameDeadline_SkipsMissedFrames(void) {
+    bool missed = true;
+    TEST_ASSERT_EQUAL_UINT64(2000u, NextFrameDeadline(1000u, 1000u, 1500u, &missed));
+    TEST_ASSERT_FALSE(missed);
+
+    // Far behind: resynchronise one period from now instead of bursting
+    TEST_ASSERT_EQUAL_UINT64(10500u, NextFrameDeadline(1000u, 1000u, 9500u, &missed));
+    TEST_ASSERT_TRUE(missed);
+}
+
+void test_WaitForFrameDeadline_HoldsTargetRate(void) {
+    FramePacer pacer;
+    InitFramePacer(&pacer, 500, false);  // 2 ms frames
+    uint64_t start = ProfilerNow();
+    for (int i = 0; i < 10; ++i) {
+        WaitForFrameDeadline(&pacer);
+    }
+    uint64_t elapsed = ProfilerNow() - start;
+
+    TEST_ASSERT_EQUAL_UINT64(10u, pacer.stats.frames);
+    TEST_ASSERT_GREATER_OR_EQUAL(18000000u, elapsed);  // Never runs ahead of the deadlines
+    TEST_ASSERT_GREATER_OR_EQUAL(0, pacer.stats.lastErrorNs);
+
+    // Unpaced pacer never waits
+    InitFramePacer(&pacer, 0, false);
+    TEST_ASSERT_EQUAL_INT(0, (int)WaitForFrameDeadline(&pacer));
+    TEST_ASSERT_EQUAL_UINT64(0u, pacer.stats.frames);
+}
+
+void test_FormatPacerStats_SummarisesDeadlines(void) {
+    char line[80];
+    PacerStats stats = { .frames = 4, .missed = 1, .lastErrorNs = -250000,
+                         .maxLateNs = 2500000, .sumAbsErrorNs = 2000000 };
+    FormatPacerStats(&stats, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("missed 1/4  max late 2.50  mean |err| 0.500 ms", line);
+
+    // Nothing waited, e.g. vsync or unpaced
+    PacerStats idle = {0};
+    FormatPacerStats(&idle, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("unpaced", line);
+}
+
+void test_FontAtlasCache_RoundTripsAndChecksKey(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/purplefontXXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        TEST_IGNORE_MESSAGE("Failed to create temp file");
+    }
+    close(fd);
+
+    unsigned char pixels[8 * 4 * 2];
+    for (size_t i = 0; i < sizeof(pixels); ++i) pixels[i] = (unsigned char)(i * 7);
+    GlyphInfo glyphs[2] = { { .value = 'A', .offsetX = 1, .offsetY = 2, .advanceX = 5 },
+                            { .value = 'B', .offsetX = -1, .offsetY = 0, .advanceX = 6 } };
+    Rectangle recs[2] = { { 1.0f, 1.0f, 3.0f, 2.0f }, { 4.5f, 1.0f, 3.0f, 2.0f } };
+    FontAtlas atlas = { .baseSize = 16, .glyphCount = 2, .glyphPadding = 1,
+                        .glyphs = glyphs, .recs = recs,
+                        .atlas = { .data = pixels, .width = 8, .height = 4, .mipmaps = 1,
+                                   .format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA } };
+    TEST_ASSERT_TRUE(WriteFontAtlasCache(path, 0x1234u, &atlas));
+
+    FontAtlas loaded;
+    TEST_ASSERT_TRUE(ReadFontAtlasCache(path, 0x1234u, 16, FONT_DEFAULT, &loaded));
+    TEST_ASSERT_TRUE(loaded.fromCache);
+    TEST_ASSERT_EQUAL_INT(2, loaded.glyphCount);
+    TEST_ASSERT_EQUAL_INT(1, loaded.glyphPadding);
+    TEST_ASSERT_EQUAL_INT(-1, loaded.glyphs[1].offsetX);
+    TEST_ASSERT_EQUAL_INT('B', loaded.glyphs[1].value);
+    TEST_ASSERT_EQUAL_FLOAT(4.5f, loaded.recs[1].x);
+    TEST_ASSERT_EQUAL_MEMORY(pixels, loaded.atlas.data, sizeof(pixels));
+    UnloadFontAtlas(&loaded);
+
+    // A changed TTF (hash), another size or an SDF request must not reuse it
+    TEST_ASSERT_FALSE(ReadFontAtlasCache(path, 0x1235u, 16, FONT_DEFAULT, &loaded));
+    TEST_ASSERT_FALSE(ReadFontAtlasCache(path, 0x1234u, 32, FONT_DEFAULT, &loaded));
+    TEST_ASSERT_FALSE(ReadFontAtlasCache(path, 0x1234u, 16, FONT_SDF, &loaded));
+    remove(path);
+}
+
+void test_StartupLoader_JoinsWorkerResults(void) {
+    char tempHome[64];
+    snprintf(tempHome, sizeof(tempHome), "/tmp/purpletestXXXXXX");
+    if (!mkdtemp(tempHome)) {
+        TEST_IGNORE_MESSAGE("Failed to create temp directory");
+    }
+    const char *oldHome = getenv("HOME");
+    setenv("HOME", tempHome, 1);
+
+    Leaderboard saved = {0};
+    AddLeaderboardEntry(&saved, "JKL", 'P', 12.5f);
+    SaveLeaderboard(&saved);
+
+    StartupLoader loader;
+    StartStartupLoader(&loader, NULL, 0, "/nonexistent/font.ttf", 32, FONT_DEFAULT, 100, NULL);
+    Leaderboard lb = {0};
+    JoinStartupLeaderboard(&loader, &lb, NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, lb.count);
+    TEST_ASSERT_EQUAL_STRING("JKL", lb.entries[0].initials);
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, lb.entries[0].seconds);
+
+    // A missing font file is not an error: JoinStartupFont falls back to raylib
+    (void)JoinStartupFont(&loader);
+    TEST_ASSERT_FALSE(loader.atlasLoaded);
+    TEST_ASSERT_TRUE(loader.fontJoined && loader.leaderboardJoined);
+    TEST_ASSERT_NOT_NULL(lb.index);
+    TEST_ASSERT_EQUAL_UINT32(1, LeaderboardTotal(&lb));
+    LeaderboardEntry today[1];
+    TEST_ASSERT_EQUAL_UINT32(1, CopyLeaderboardWindow(&lb, LEADERBOARD_TODAY, today, 1));
+    DestroyScoreIndex(lb.index);
+    DestroyLeaderboardWindows(&lb);
+
+    if (oldHome) setenv("HOME", oldHome, 1);
+}
+
 int main(void) {
     UNITY_BEGIN();
     
@@ -1125,6 +2563,7 @@ int main(void) {
     RUN_TEST(test_FindResourceFile_ReturnsNonNull);
     RUN_TEST(test_FindFontPath_ReturnsNonNull);
     RUN_TEST(test_FindResourceDirectory_IsConsistent);
+    RUN_TEST(test_ResourceOverride_ReplacesSearchAndEmbeddedData);
     
     // Font file tests
     RUN_TEST(test_FontFile_ExistsAndValid);
@@ -1150,6 +2589,43 @@ int main(void) {
     RUN_TEST(test_LoadLeaderboard_NonexistentFile);
     RUN_TEST(test_SaveLeaderboard_EmptyLeaderboard);
     RUN_TEST(test_SaveAndLoadLeaderboard_PersistsSorted);
+    RUN_TEST(test_LeaderboardFile_RejectsCorruptRecord);
+    RUN_TEST(test_LeaderboardText_ExportImportRoundTrip);
+    RUN_TEST(test_LeaderboardText_ParsesAndReportsMalformedLines);
+    RUN_TEST(test_ScoreIndex_OrdersTiesAndEvictsSlowest);
+    RUN_TEST(test_ScoreIndex_RankQueriesMatchOrder);
+    RUN_TEST(test_ScoreWindow_ExpiresInTimeOrder);
+    RUN_TEST(test_LeaderboardWindows_UpdateWithEveryResultAndPersist);
+    RUN_TEST(test_MatchHistory_SkipsBlocksAndMatchesPlainPercentiles);
+    RUN_TEST(test_MatchHistoryLog_SealsBlocksAndRecoversTornWrites);
+    RUN_TEST(test_LeaderboardFile_KeepsFullIndexedHistory);
+    RUN_TEST(test_BoardWriter_AppendsQueuedEntriesOnStop);
+    RUN_TEST(test_PlayerStats_TracksStreaksAndGrowsTable);
+    RUN_TEST(test_SharedBoard_DeliversOtherInstancesResults);
+    RUN_TEST(test_LeaderboardJournal_RefreshSeesOtherWriters);
+    RUN_TEST(test_LeaderboardJournal_ReplaysOnlyMatchingGeneration);
+    RUN_TEST(test_LeaderboardJournal_MigratesVersion1Files);
+    RUN_TEST(test_AddLeaderboardEntry_BumpsRevisionOnlyOnChange);
+
+    // Simulation and checkpoint tests
+    RUN_TEST(test_SimLane_IsDeterministic);
+    RUN_TEST(test_SimCheckpoint_ResumeIsBitIdentical);
+    RUN_TEST(test_LoadSimCheckpoint_RejectsCorruptFile);
+
+    // Text cache tests
+    RUN_TEST(test_GetTextRun_CachesLayout);
+    RUN_TEST(test_GetTextRun_RejectsUncacheableText);
+    RUN_TEST(test_SetHudLabelNumber_RebuildsOnlyOnChange);
+    RUN_TEST(test_ComputeFrameStats_NearestRankPercentiles);
+    RUN_TEST(test_BuildFrameHistogram_ClampsOutliers);
+    RUN_TEST(test_GetFramePhaseSamples_ReturnsOldestFirstAfterWrap);
+    RUN_TEST(test_InputFrame_QueuesCharsUntilReset);
+    RUN_TEST(test_HasInputActivity_SeesHeldKeysAndChars);
+    RUN_TEST(test_NextFrameDeadline_SkipsMissedFrames);
+    RUN_TEST(test_WaitForFrameDeadline_HoldsTargetRate);
+    RUN_TEST(test_FormatPacerStats_SummarisesDeadlines);
+    RUN_TEST(test_FontAtlasCache_RoundTripsAndChecksKey);
+    RUN_TEST(test_StartupLoader_JoinsWorkerResults);
     
     return UNITY_END();
 }
@@ -0,0 +1,177 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: test_soft.c
+    Description: Golden-image tests for the software rasterizer backend,
+                 linked against platform/rlnull.c instead of raylib
+========================================================================= */
+
+#include "unity/unity.h"
+#include <raylib/raylib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define SCENE_WIDTH 128
+#define SCENE_HEIGHT 48
+#define SCENE_HASH 0x86f60f8cu  // FNV-1a of the scene, as main-soft reports it
+#define SCENE_FONT_PATH "resources/orbitron/Orbitron-VariableFont_wght.ttf"
+#define SCENE_FONT_SIZE 32
+
+static Image scene;
+
+// The game's text path: one SDF atlas, drawn through the distance-field shader
+static Font LoadSdfFont(const char *path)
+{
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(path, &dataSize);
+    Font font = { .baseSize = SCENE_FONT_SIZE, .glyphCount = 95, .glyphPadding = 0 };
+    font.glyphs = LoadFontData(data, dataSize, SCENE_FONT_SIZE, NULL, 0, FONT_SDF);
+    UnloadFileData(data);
+    if (font.glyphs == NULL) return (Font){0};
+    Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, SCENE_FONT_SIZE,
+                                    0, 1);
+    font.texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    return font;
+}
+
+// A rectangle, a circle, a line and Orbitron text, both as coverage glyphs
+// (LoadFontEx) and as a distance field, over a cleared background
+static Image DrawScene(void)
+{
+    InitWindow(SCENE_WIDTH, SCENE_HEIGHT, "test_soft");
+    Font font = LoadFontEx(SCENE_FONT_PATH, SCENE_FONT_SIZE, NULL, 0);
+    Font sdf = LoadSdfFont(SCENE_FONT_PATH);
+    Shader shader = LoadShaderFromMemory(NULL, "sdf");
+    BeginDrawing();
+    ClearBackground(BLACK);
+    DrawRectangle(4, 4, 10, 6, RED);
+    DrawCircleV((Vector2){ 40.0f, 20.0f }, 6.0f, BLUE);
+    DrawLineV((Vector2){ 0.0f, 40.0f }, (Vector2){ 63.0f, 40.0f }, GREEN);
+    DrawTextEx(font, "P", (Vector2){ 64.0f, 0.0f }, (float)SCENE_FONT_SIZE, 0.0f, WHITE);
+    BeginShaderMode(shader);
+    DrawTextEx(sdf, "4", (Vector2){ 96.0f, 0.0f }, (float)SCENE_FONT_SIZE, 0.0f, WHITE);
+    EndShaderMode();
+    EndDrawing();
+    Image image = LoadImageFromScreen();
+    UnloadShader(shader);
+    UnloadFont(sdf);
+    UnloadFont(font);
+    CloseWindow();
+    return image;
+}
+
+static uint32_t Pixel(int x, int y)
+{
+    uint32_t pixel;
+    memcpy(&pixel, (const unsigned char *)scene.data + ((size_t)y * SCENE_WIDTH + (size_t)x) * 4u,
+           sizeof(pixel));
+    return pixel;
+}
+
+static uint32_t Packed(Color c)
+{
+    return (uint32_t)c.r | ((uint32_t)c.g << 8) | ((uint32_t)c.b << 16) | ((uint32_t)c.a << 24);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_SoftScene_MatchesDimensions(void)
+{
+    TEST_ASSERT_NOT_NULL(scene.data);
+    TEST_ASSERT_EQUAL_INT(SCENE_WIDTH, scene.width);
+    TEST_ASSERT_EQUAL_INT(SCENE_HEIGHT, scene.height);
+    TEST_ASSERT_EQUAL_INT(PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, scene.format);
+}
+
+void test_SoftScene_RectangleCoversItsPixelsOnly(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(Packed(RED), Pixel(4, 4));
+    TEST_ASSERT_EQUAL_UINT32(Packed(RED), Pixel(13, 9));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(14, 4));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(13, 10));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(3, 4));
+}
+
+void test_SoftScene_CircleSpansThroughPixelCentres(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLUE), Pixel(40, 20));
+    // Row 20 runs from round(40 - 5.98) to round(40 + 5.98), exclusive
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLUE), Pixel(34, 20));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLUE), Pixel(45, 20));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(33, 20));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(46, 20));
+    // First row is 14; its corners are outside the circle
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLUE), Pixel(40, 14));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(40, 13));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(35, 14));
+}
+
+void test_SoftScene_LineIsOnePixelPerStep(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(Packed(GREEN), Pixel(0, 40));
+    TEST_ASSERT_EQUAL_UINT32(Packed(GREEN), Pixel(62, 40));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(63, 40));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(31, 39));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(31, 41));
+}
+
+void test_SoftScene_CoverageGlyphHasOrbitronShape(void)
+{
+    // 'P' at 32 px: cap height runs from row 7 to the baseline at row 25
+    TEST_ASSERT_EQUAL_UINT32(Packed(WHITE), Pixel(66, 7));
+    TEST_ASSERT_EQUAL_UINT32(Packed(WHITE), Pixel(66, 24));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(66, 5));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(66, 26));
+    // Square bowl: both sides and the bar are solid, the counter and the
+    // space beside the stem below it are empty
+    TEST_ASSERT_EQUAL_UINT32(Packed(WHITE), Pixel(82, 12));
+    TEST_ASSERT_EQUAL_UINT32(Packed(WHITE), Pixel(75, 16));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(75, 12));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(82, 21));
+    // Antialiased left edge of the stem
+    uint32_t edge = Pixel(65, 20);
+    TEST_ASSERT_TRUE(edge != Packed(WHITE) && edge != Packed(BLACK));
+}
+
+void test_SoftScene_DistanceFieldGlyphHasOrbitronShape(void)
+{
+    // '4' through the SDF shader stand-in: crossbar, stem, open triangle
+    TEST_ASSERT_EQUAL_UINT32(Packed(WHITE), Pixel(105, 19));
+    TEST_ASSERT_EQUAL_UINT32(Packed(WHITE), Pixel(109, 22));
+    TEST_ASSERT_EQUAL_UINT32(Packed(WHITE), Pixel(109, 8));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(104, 14));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(100, 22));
+    TEST_ASSERT_EQUAL_UINT32(Packed(BLACK), Pixel(109, 26));
+}
+
+void test_SoftScene_MatchesGoldenHash(void)
+{
+    uint32_t hash = 2166136261u;
+    for (int y = 0; y < SCENE_HEIGHT; ++y) {
+        for (int x = 0; x < SCENE_WIDTH; ++x) {
+            hash ^= Pixel(x, y);
+            hash *= 16777619u;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(SCENE_HASH, hash);
+}
+
+int main(void) {
+    scene = DrawScene();
+    UNITY_BEGIN();
+
+    RUN_TEST(test_SoftScene_MatchesDimensions);
+    RUN_TEST(test_SoftScene_RectangleCoversItsPixelsOnly);
+    RUN_TEST(test_SoftScene_CircleSpansThroughPixelCentres);
+    RUN_TEST(test_SoftScene_LineIsOnePixelPerStep);
+    RUN_TEST(test_SoftScene_CoverageGlyphHasOrbitronShape);
+    RUN_TEST(test_SoftScene_DistanceFieldGlyphHasOrbitronShape);
+    RUN_TEST(test_SoftScene_MatchesGoldenHash);
+
+    UnloadImage(scene);
+    return UNITY_END();
+}
@@ -0,0 +1,164 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: textcache.c
+    Description: Cache of measured and laid-out text runs
+========================================================================= */
+
+#include "textcache.h"
+#include <stddef.h>
+#include <string.h>
+
+static TextRun cache[TEXT_CACHE_CAPACITY];
+static int cacheCount = 0;
+static unsigned int useCounter = 0;
+
+static unsigned int HashText(const char *text)
+{
+    unsigned int hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)text; *p; ++p) {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Lay out text the same way raylib's MeasureTextEx/DrawTextEx do
+static int LayoutTextRun(TextRun *run, Font font, const char *text)
+{
+    float scale = run->fontSize / (float)font.baseSize;
+    float padding = (float)font.glyphPadding;
+    float penX = 0.0f;
+    float measureWidth = 0.0f;
+    int codepoints = 0;
+
+    run->quadCount = 0;
+    for (int i = 0; text[i] != '\0';) {
+        int byteCount = 0;
+        int codepoint = GetCodepointNext(&text[i], &byteCount);
+        if (codepoint == '\n') return 0;
+        int index = GetGlyphIndex(font, codepoint);
+        const GlyphInfo *glyph = &font.glyphs[index];
+        const Rectangle *rec = &font.recs[index];
+
+        if (codepoint != ' ' && codepoint != '\t') {
+            if (run->quadCount >= TEXT_RUN_MAX_GLYPHS) return 0;
+            GlyphQuad *quad = &run->quads[run->quadCount++];
+            quad->source = (Rectangle){ rec->x - padding, rec->y - padding,
+                                        rec->width + 2.0f * padding,
+                                        rec->height + 2.0f * padding };
+            quad->dest = (Rectangle){ penX + ((float)glyph->offsetX - padding) * scale,
+                                      ((float)glyph->offsetY - padding) * scale,
+                                      (rec->width + 2.0f * padding) * scale,
+                                      (rec->height + 2.0f * padding) * scale };
+        }
+
+        if (glyph->advanceX == 0) {
+            penX += rec->width * scale + run->spacing;
+            measureWidth += rec->width + (float)glyph->offsetX;
+        } else {
+            penX += (float)glyph->advanceX * scale + run->spacing;
+            measureWidth += (float)glyph->advanceX;
+        }
+        codepoints++;
+        i += (byteCount > 0) ? byteCount : 1;
+    }
+
+    run->size.x = measureWidth * scale +
+                  (float)((codepoints > 0) ? codepoints - 1 : 0) * run->spacing;
+    run->size.y = run->fontSize;
+    return 1;
+}
+
+const TextRun *GetTextRun(Font font, const char *text, float fontSize, float spacing)
+{
+    if (text == NULL) return NULL;
+    if (font.texture.id == 0) font = GetFontDefault();
+    if (font.glyphs == NULL || font.recs == NULL || font.baseSize <= 0) return NULL;
+
+    size_t length = strlen(text);
+    if (length >= TEXT_RUN_MAX_TEXT) return NULL;
+
+    unsigned int hash = HashText(text);
+    useCounter++;
+    for (int i = 0; i < cacheCount; ++i) {
+        TextRun *run = &cache[i];
+        if (run->hash == hash && run->textureId == font.texture.id &&
+            run->fontSize == fontSize && run->spacing == spacing &&
+            strcmp(run->text, text) == 0) {
+            run->lastUse = useCounter;
+            return run;
+        }
+    }
+
+    // Miss: take a free slot or evict the least recently used run
+    int slot = cacheCount;
+    int appended = cacheCount < TEXT_CACHE_CAPACITY;
+    if (appended) {
+        cacheCount++;
+    } else {
+        slot = 0;
+        for (int i = 1; i < cacheCount; ++i) {
+            if (cache[i].lastUse < cache[slot].lastUse) slot = i;
+        }
+    }
+
+    TextRun *run = &cache[slot];
+    run->textureId = font.texture.id;
+    run->fontSize = fontSize;
+    run->spacing = spacing;
+    run->hash = hash;
+    run->lastUse = useCounter;
+    memcpy(run->text, text, length + 1);
+    if (!LayoutTextRun(run, font, text)) {
+        // Not cacheable; release the slot again
+        if (appended) {
+            cacheCount--;
+        } else {
+            run->text[0] = '\0';
+            run->hash = 0;
+            run->lastUse = 0;
+        }
+        return NULL;
+    }
+    return run;
+}
+
+void DrawTextRun(Font font, const TextRun *run, Vector2 position, Color tint)
+{
+    if (run == NULL) return;
+    if (font.texture.id == 0) font = GetFontDefault();
+
+    for (int i = 0; i < run->quadCount; ++i) {
+        const GlyphQuad *quad = &run->quads[i];
+        Rectangle dest = { position.x + quad->dest.x, position.y + quad->dest.y,
+                           quad->dest.width, quad->dest.height };
+        DrawTexturePro(font.texture, quad->source, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, tint);
+    }
+}
+
+Vector2 MeasureTextCached(Font font, const char *text, float fontSize, float spacing)
+{
+    const TextRun *run = GetTextRun(font, text, fontSize, spacing);
+    if (run == NULL) return MeasureTextEx(font, text, fontSize, spacing);
+    return run->size;
+}
+
+void DrawTextCached(Font font, const char *text, Vector2 position, float fontSize,
+                    float spacing, Color tint)
+{
+    const TextRun *run = GetTextRun(font, text, fontSize, spacing);
+    if (run == NULL) {
+        DrawTextEx(font, text, position, fontSize, spacing, tint);
+        return;
+    }
+    DrawTextRun(font, run, position, tint);
+}
+
+void ClearTextCache(void)
+{
+    cacheCount = 0;
+    useCounter = 0;
+}
@@ -0,0 +1,52 @@
+/* =========================================================================
+    Purple
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    File: textcache.h
+    Description: Cache of measured and laid-out text runs
+========================================================================= */
+
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include <raylib/raylib.h>
+
+#define TEXT_CACHE_CAPACITY 32
+#define TEXT_RUN_MAX_TEXT 64
+#define TEXT_RUN_MAX_GLYPHS 48
+
+typedef struct {
+    Rectangle source;  // Atlas rectangle including glyph padding
+    Rectangle dest;    // Scaled rectangle relative to the run origin
+} GlyphQuad;
+
+// A string laid out once for a given font, size and spacing
+typedef struct {
+    unsigned int textureId;  // Font identity (atlas texture)
+    float fontSize;
+    float spacing;
+    unsigned int hash;
+    unsigned int lastUse;
+    char text[TEXT_RUN_MAX_TEXT];
+    Vector2 size;            // Same result as MeasureTextEx
+    int quadCount;
+    GlyphQuad quads[TEXT_RUN_MAX_GLYPHS];
+} TextRun;
+
+// Look up (or lay out and insert) a run. Returns NULL if the text is too
+// long or multi-line to cache; callers then fall back to raylib directly.
+const TextRun *GetTextRun(Font font, const char *text, float fontSize, float spacing);
+
+// Draw a cached run with its precomputed glyph quads
+void DrawTextRun(Font font, const TextRun *run, Vector2 position, Color tint);
+
+// Cached drop-in replacements for MeasureTextEx and DrawTextEx
+Vector2 MeasureTextCached(Font font, const char *text, float fontSize, float spacing);
+void DrawTextCached(Font font, const char *text, Vector2 position, float fontSize,
+                    float spacing, Color tint);
+
+// Forget every run (call before unloading a font)
+void ClearTextCache(void);
+
+#endif // TEXTCACHE_H
@@ -0,0 +1,148 @@
+/* =========================================================================
+    Purple - Tools
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    See LICENSE.txt for 3rd party library and other resource licenses.
+    File: bench_leaderboard.c
+    Description: Insert, top-K and rank timings for the leaderboard score index
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../leaderboard.h"
+#include "../scoreindex.h"
+
+#define DEFAULT_TOP_K 10
+#define TOP_K_REPEATS 1000
+#define RANK_QUERIES 100000
+
+static const uint64_t defaultSizes[] = { 10, 10000, 10000000 };
+
+static uint64_t Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// xorshift64*; fixed seed so runs are comparable
+static uint64_t NextRandom(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717u;
+}
+
+static bool ParseCount(const char *text, uint64_t *value)
+{
+    char *end = NULL;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (end == text || *end != '\0') return false;
+    *value = (uint64_t)parsed;
+    return true;
+}
+
+static void PrintUsage(const char *program)
+{
+    printf("Usage: %s [options] [N ...]\n", program);
+    printf("  N                 Results to insert (default 10 10000 10000000)\n");
+    printf("  --capacity N      Index capacity, 0 for unbounded (default 0)\n");
+    printf("  --top N           Results read per top-K query (default %d)\n", DEFAULT_TOP_K);
+}
+
+static bool RunBenchmark(uint64_t count, size_t capacity, size_t topK)
+{
+    ScoreIndex *index = CreateScoreIndex(capacity);
+    LeaderboardEntry *top = malloc(topK * sizeof(LeaderboardEntry));
+    if (index == NULL || top == NULL) {
+        DestroyScoreIndex(index);
+        free(top);
+        return false;
+    }
+
+    uint64_t state = 0x9E3779B97F4A7C15u;
+    LeaderboardEntry entry = { "BEN", 'P', 0.0f, 0 };
+    uint64_t start = Now();
+    for (uint64_t i = 0; i < count; ++i) {
+        // Match lengths between 10 s and ~10 min in millisecond steps
+        entry.seconds = 10.0f + (float)(NextRandom(&state) % 600000u) / 1000.0f;
+        InsertScore(index, &entry);
+    }
+    uint64_t insertNs = Now() - start;
+
+    size_t copied = 0;
+    start = Now();
+    for (int i = 0; i < TOP_K_REPEATS; ++i) {
+        copied += CopyTopScores(index, top, topK);
+    }
+    uint64_t topNs = (Now() - start) / TOP_K_REPEATS;
+
+    // Place of a time, then the result at that place
+    size_t kept = ScoreIndexCount(index);
+    size_t checksum = 0;
+    start = Now();
+    for (int i = 0; i < RANK_QUERIES; ++i) {
+        float seconds = 10.0f + (float)(NextRandom(&state) % 600000u) / 1000.0f;
+        size_t rank = ScoreRank(index, seconds);
+        const LeaderboardEntry *at = ScoreAtRank(index, (rank <= kept) ? rank : kept);
+        checksum += rank + ((at != NULL) ? 1u : 0u);
+    }
+    uint64_t rankNs = (Now() - start) / RANK_QUERIES;
+
+    printf("%10" PRIu64 " inserts  %8.1f ns/insert  top-%zu %8.1f ns  rank+at %6.1f ns  (%zu kept)\n",
+           count, (count > 0) ? (double)insertNs / (double)count : 0.0, topK,
+           (double)topNs, (double)rankNs, kept);
+    (void)copied;
+    (void)checksum;
+
+    DestroyScoreIndex(index);
+    free(top);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t capacity = SCORE_INDEX_UNBOUNDED;
+    uint64_t topK = DEFAULT_TOP_K;
+    uint64_t sizes[16];
+    size_t sizeCount = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool ok = true;
+        if (strcmp(arg, "--capacity") == 0 && value) {
+            ok = ParseCount(value, &capacity); i++;
+        } else if (strcmp(arg, "--top") == 0 && value) {
+            ok = ParseCount(value, &topK); i++;
+        } else if (sizeCount < sizeof(sizes) / sizeof(sizes[0])) {
+            ok = ParseCount(arg, &sizes[sizeCount++]);
+        } else {
+            ok = false;
+        }
+        if (!ok || topK == 0) {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (sizeCount == 0) {
+        sizeCount = sizeof(defaultSizes) / sizeof(defaultSizes[0]);
+        memcpy(sizes, defaultSizes, sizeof(defaultSizes));
+    }
+
+    for (size_t i = 0; i < sizeCount; ++i) {
+        if (!RunBenchmark(sizes[i], (size_t)capacity, (size_t)topK)) {
+            fprintf(stderr, "Out of memory at %" PRIu64 " results\n", sizes[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
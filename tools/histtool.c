@@ -0,0 +1,236 @@
+/* =========================================================================
+    Purple - Tools
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    See LICENSE.txt for 3rd party library and other resource licenses.
+    File: histtool.c
+    Description: Match history queries and size/scan benchmark
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "../matchhistory.h"
+
+#define DEFAULT_BENCH_MATCHES 4000000u
+#define BENCH_RUNS 5  // Best of, to smooth out cache noise
+#define DAY_SECONDS 86400
+
+static uint64_t Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// xorshift64*; fixed seed so runs are comparable
+static uint64_t NextRandom(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717u;
+}
+
+static double FileBytes(const char *path)
+{
+    struct stat st;
+    return (stat(path, &st) == 0) ? (double)st.st_size : 0.0;
+}
+
+static void PrintUsage(const char *program)
+{
+    printf("Usage: %s median <history.bin> [days]\n", program);
+    printf("       %s bench [matches]            (default %u)\n", program,
+           DEFAULT_BENCH_MATCHES);
+    printf("  median  Median and 90th percentile match length, overall and by winner,\n");
+    printf("          over the last days (default: all time)\n");
+    printf("  bench   Bytes per match and percentile query speed against a scan of\n");
+    printf("          plain rows\n");
+}
+
+static void PrintPercentiles(const MatchHistory *history, const MatchFilter *filter,
+                             const char *name)
+{
+    float median = 0.0f, p90 = 0.0f;
+    MatchQueryStats stats;
+    if (!MatchHistoryPercentile(history, filter, 0.5, &median, &stats) ||
+        !MatchHistoryPercentile(history, filter, 0.9, &p90, NULL)) {
+        printf("  %-8s no matches\n", name);
+        return;
+    }
+    printf("  %-8s median %8.3fs  p90 %8.3fs  over %zu (%zu blocks read, %zu skipped)\n", name,
+           (double)median, (double)p90, stats.matches, stats.blocksRead, stats.blocksSkipped);
+}
+
+static int Median(const char *path, long days)
+{
+    MatchHistory history = {0};
+    LoadMatchHistory(&history, path);
+    int64_t now = (int64_t)time(NULL);
+    MatchFilter filter = { (days > 0) ? now - (int64_t)days * DAY_SECONDS : INT64_MIN,
+                           INT64_MAX, 0 };
+    printf("%zu matches in %s\n", MatchHistoryCount(&history), path);
+    PrintPercentiles(&history, &filter, "all");
+    filter.winner = 'P';
+    PrintPercentiles(&history, &filter, "player");
+    filter.winner = 'A';
+    PrintPercentiles(&history, &filter, "AI");
+    FreeMatchHistory(&history);
+    return 0;
+}
+
+static int CompareMillis(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// The straightforward way: walk plain rows, collect, sort
+static bool RowPercentile(const MatchRecord *rows, size_t count, const MatchFilter *filter,
+                          double percentile, uint32_t *scratch, float *seconds)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const MatchRecord *m = &rows[i];
+        if (m->timestamp >= filter->from && m->timestamp < filter->to &&
+            (filter->winner == 0 || filter->winner == m->winner)) {
+            scratch[n++] = (uint32_t)llrint((double)m->seconds * 1000.0);
+        }
+    }
+    if (n == 0) return false;
+    qsort(scratch, n, sizeof(uint32_t), CompareMillis);
+    size_t rank = (size_t)ceil(percentile * (double)n);
+    *seconds = (float)((double)scratch[(rank > 0) ? rank - 1 : 0] / 1000.0);
+    return true;
+}
+
+typedef struct {
+    const char *name;
+    MatchFilter filter;
+} BenchQuery;
+
+static int Bench(uint64_t matches)
+{
+    char path[] = "/tmp/histtool-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd >= 0) close(fd);
+    char tailPath[sizeof(path) + 8];
+    snprintf(tailPath, sizeof(tailPath), "%s.tail", path);
+    MatchRecord *rows = malloc((size_t)matches * sizeof(MatchRecord));
+    uint32_t *scratch = malloc((size_t)matches * sizeof(uint32_t));
+    MatchHistory history = {0};
+    MatchHistoryLog log = { .blocksFd = -1, .tailFd = -1 };
+    // The temporary file is empty, which the log starts as a new history
+    if (fd < 0 || matches == 0 || !rows || !scratch || !OpenMatchHistoryLog(&log, path)) {
+        fprintf(stderr, "Cannot set up the benchmark\n");
+        CloseMatchHistoryLog(&log);
+        if (fd >= 0) remove(path);
+        remove(tailPath);
+        free(rows);
+        free(scratch);
+        return 1;
+    }
+
+    // A match every 20 s to 3 min, ending now; lengths of 10 s to ~10 min
+    uint64_t state = 0x9E3779B97F4A7C15u;
+    int64_t timestamp = (int64_t)time(NULL) - (int64_t)matches * 100;
+    uint32_t seed = (uint32_t)timestamp;
+    for (uint64_t i = 0; i < matches; ++i) {
+        MatchRecord *m = &rows[i];
+        timestamp += 20 + (int64_t)(NextRandom(&state) % 160u);
+        m->timestamp = timestamp;
+        m->seconds = (float)(10.0 + (double)(NextRandom(&state) % 600000u) / 1000.0);
+        m->winner = (NextRandom(&state) & 1u) ? 'A' : 'P';
+        uint8_t loserScore = (uint8_t)(NextRandom(&state) % 5u);
+        m->playerScore = (m->winner == 'P') ? 5 : loserScore;
+        m->aiScore = (m->winner == 'A') ? 5 : loserScore;
+        m->rallies = 5u + (uint32_t)(NextRandom(&state) % 60u);
+        m->seed = ++seed;
+        AppendMatchHistory(&history, m);
+    }
+    bool ok = AppendMatchHistoryLog(&log, path, rows, (size_t)matches);
+    CloseMatchHistoryLog(&log);
+    double diskBytes = FileBytes(path) + FileBytes(tailPath);
+    size_t encodedBytes = 0;
+    for (size_t b = 0; b < history.blockCount; ++b) encodedBytes += history.blocks[b].size;
+
+    int64_t now = timestamp + 1;
+    BenchQuery queries[] = {
+        { "median, all time", { INT64_MIN, INT64_MAX, 0 } },
+        { "median, player wins", { INT64_MIN, INT64_MAX, 'P' } },
+        { "median, last 30 days", { now - 30 * DAY_SECONDS, INT64_MAX, 0 } },
+    };
+    printf("%" PRIu64 " matches, %zu blocks, best of %d\n", matches, history.blockCount,
+           BENCH_RUNS);
+    printf("  on disk %10.0f bytes  %5.2f bytes/match (plain rows %zu)\n", diskBytes,
+           diskBytes / (double)matches, sizeof(MatchRecord));
+    printf("  columns %10zu bytes  %5.2f bytes/match in sealed blocks\n", encodedBytes,
+           (history.blockCount > 0)
+               ? (double)encodedBytes / ((double)history.blockCount * MATCH_HISTORY_BLOCK) : 0.0);
+
+    for (size_t q = 0; q < sizeof(queries) / sizeof(queries[0]) && ok; ++q) {
+        uint64_t columnNs = UINT64_MAX, rowNs = UINT64_MAX;
+        float columnSeconds = 0.0f, rowSeconds = 0.0f;
+        MatchQueryStats stats = {0};
+        for (int run = 0; run < BENCH_RUNS && ok; ++run) {
+            uint64_t start = Now();
+            ok = MatchHistoryPercentile(&history, &queries[q].filter, 0.5, &columnSeconds, &stats);
+            uint64_t elapsed = Now() - start;
+            if (elapsed < columnNs) columnNs = elapsed;
+
+            start = Now();
+            ok = ok && RowPercentile(rows, (size_t)matches, &queries[q].filter, 0.5, scratch,
+                                     &rowSeconds);
+            elapsed = Now() - start;
+            if (elapsed < rowNs) rowNs = elapsed;
+        }
+        if (!ok) break;
+        // Throughput as the plain rows the query stands in for
+        double rowBytes = (double)matches * (double)sizeof(MatchRecord);
+        printf("  %-22s %8.3fs  %8.2f ms (%6.2f GB/s of rows, %zu blocks skipped)  "
+               "rows+qsort %8.2f ms  %s\n",
+               queries[q].name, (double)columnSeconds, (double)columnNs / 1e6,
+               rowBytes / (double)columnNs, stats.blocksSkipped, (double)rowNs / 1e6,
+               (columnSeconds == rowSeconds) ? "same" : "DIFFERENT");
+        ok = columnSeconds == rowSeconds;
+    }
+
+    // The files read back to the same history
+    MatchHistory loaded = {0};
+    ok = ok && LoadMatchHistory(&loaded, path) && MatchHistoryCount(&loaded) == matches;
+    FreeMatchHistory(&loaded);
+    FreeMatchHistory(&history);
+    remove(path);
+    remove(tailPath);
+    free(rows);
+    free(scratch);
+    if (!ok) fprintf(stderr, "Benchmark failed\n");
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    if ((argc == 3 || argc == 4) && strcmp(argv[1], "median") == 0) {
+        char *end = NULL;
+        long days = (argc == 4) ? strtol(argv[3], &end, 10) : 0;
+        if (argc == 3 || (end != argv[3] && *end == '\0' && days >= 0)) {
+            return Median(argv[2], days);
+        }
+    } else if ((argc == 2 || argc == 3) && strcmp(argv[1], "bench") == 0) {
+        char *end = NULL;
+        unsigned long long matches =
+            (argc == 3) ? strtoull(argv[2], &end, 10) : DEFAULT_BENCH_MATCHES;
+        if (argc == 2 || (end != argv[2] && *end == '\0')) return Bench((uint64_t)matches);
+    }
+    PrintUsage(argv[0]);
+    return 1;
+}
@@ -0,0 +1,252 @@
+/* =========================================================================
+    Purple - Tools
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    See LICENSE.txt for 3rd party library and other resource licenses.
+    File: lbtool.c
+    Description: Leaderboard text import/export and text throughput benchmark
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "../leaderboard.h"
+#include "../scoreindex.h"
+
+#define DEFAULT_BENCH_LINES 2000000u
+#define BENCH_RUNS 3  // Best of, to smooth out page cache noise
+
+static uint64_t Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// xorshift64*; fixed seed so runs are comparable
+static uint64_t NextRandom(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717u;
+}
+
+static double FileMegabytes(const char *path)
+{
+    struct stat st;
+    return (stat(path, &st) == 0) ? (double)st.st_size / 1e6 : 0.0;
+}
+
+static void PrintUsage(const char *program)
+{
+    printf("Usage: %s import <in.txt> <out.bin> [--strict]\n", program);
+    printf("       %s export <in.bin> <out.txt> [journal]\n", program);
+    printf("       %s bench [lines]             (default %u)\n", program, DEFAULT_BENCH_LINES);
+    printf("  import  Parse a \"seconds;winner;initials\" dump into a binary board;\n");
+    printf("          --strict fails (exit 2) if any line is malformed\n");
+    printf("  export  Write every result of a board (plus its journal) as text\n");
+    printf("  bench   Import/export MB/s against the fgets+sscanf/fprintf path\n");
+}
+
+static int Import(const char *in, const char *out, bool strict)
+{
+    Leaderboard lb = {0};
+    lb.index = CreateScoreIndex(SCORE_INDEX_UNBOUNDED);
+    LeaderboardTextStats stats;
+    uint64_t start = Now();
+    if (!lb.index || !ImportLeaderboardText(&lb, in, &stats)) {
+        fprintf(stderr, "Cannot read %s\n", in);
+        DestroyScoreIndex(lb.index);
+        return 1;
+    }
+    double parseSeconds = (double)(Now() - start) / 1e9;
+    printf("%zu of %zu lines imported in %.3f s (%.1f MB/s)\n", stats.imported, stats.lines,
+           parseSeconds, FileMegabytes(in) / parseSeconds);
+    if (stats.malformed > 0) {
+        fprintf(stderr, "%zu malformed lines skipped (first at line %zu)\n", stats.malformed,
+                stats.firstMalformed);
+    }
+
+    bool saved = !(strict && stats.malformed > 0) && SaveLeaderboardFile(&lb, out);
+    DestroyScoreIndex(lb.index);
+    if (strict && stats.malformed > 0) return 2;
+    if (!saved) {
+        fprintf(stderr, "Cannot write %s\n", out);
+        return 1;
+    }
+    return 0;
+}
+
+static int Export(const char *in, const char *out, const char *journal)
+{
+    Leaderboard lb = {0};
+    lb.index = CreateScoreIndex(SCORE_INDEX_UNBOUNDED);
+    bool loaded = lb.index && (journal ? LoadLeaderboardJournaled(&lb, in, journal)
+                                       : LoadLeaderboardFile(&lb, in));
+    if (!loaded) {
+        fprintf(stderr, "Cannot read board %s\n", in);
+        DestroyScoreIndex(lb.index);
+        return 1;
+    }
+    uint64_t start = Now();
+    bool ok = ExportLeaderboardText(&lb, out);
+    double seconds = (double)(Now() - start) / 1e9;
+    if (ok) {
+        printf("%zu results exported in %.3f s (%.1f MB/s)\n", LeaderboardTotal(&lb), seconds,
+               FileMegabytes(out) / seconds);
+    } else {
+        fprintf(stderr, "Cannot write %s\n", out);
+    }
+    DestroyScoreIndex(lb.index);
+    return ok ? 0 : 1;
+}
+
+// The path the game used before the hand-written parser, kept for comparison
+static size_t LegacyImport(const char *path)
+{
+    FILE *fp = fopen(path, "r");
+    if (!fp) return 0;
+    Leaderboard lb = {0};
+    size_t imported = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+        char initials[8] = {0};
+        char winner = 'P';
+        float seconds = 0.0f;
+        if (sscanf(line, "%f;%c;%7s", &seconds, &winner, initials) == 3) {
+            AddLeaderboardEntryAt(&lb, initials, winner, seconds, 0);
+            imported++;
+        }
+    }
+    fclose(fp);
+    return imported;
+}
+
+static bool LegacyExport(const Leaderboard *lb, const char *path)
+{
+    FILE *fp = fopen(path, "w");
+    if (!fp) return false;
+    ScoreCursor cursor;
+    for (const LeaderboardEntry *e = FirstScore(lb->index, &cursor); e; e = NextScore(&cursor)) {
+        fprintf(fp, "%0.3f;%c;%s\n", (double)e->seconds, e->winner, e->initials);
+    }
+    return fclose(fp) == 0;
+}
+
+static void ReportRate(const char *name, double megabytes, uint64_t bestNs)
+{
+    double seconds = (double)bestNs / 1e9;
+    printf("  %-22s %8.3f s  %8.1f MB/s\n", name, seconds, megabytes / seconds);
+}
+
+static int Bench(uint64_t lines)
+{
+    char textPath[] = "/tmp/lbtool-textXXXXXX";
+    char legacyPath[] = "/tmp/lbtool-legacyXXXXXX";
+    int fd = mkstemp(textPath);
+    int legacyFd = (fd >= 0) ? mkstemp(legacyPath) : -1;
+    if (fd >= 0) close(fd);
+    if (legacyFd >= 0) close(legacyFd);
+    Leaderboard lb = {0};
+    lb.index = CreateScoreIndex(SCORE_INDEX_UNBOUNDED);
+    if (fd < 0 || legacyFd < 0 || !lb.index) {
+        fprintf(stderr, "Cannot set up the benchmark\n");
+        if (fd >= 0) remove(textPath);
+        if (legacyFd >= 0) remove(legacyPath);
+        DestroyScoreIndex(lb.index);
+        return 1;
+    }
+
+    uint64_t state = 0x9E3779B97F4A7C15u;
+    for (uint64_t i = 0; i < lines; ++i) {
+        char initials[4] = { (char)('A' + NextRandom(&state) % 26u),
+                             (char)('A' + NextRandom(&state) % 26u),
+                             (char)('A' + NextRandom(&state) % 26u), '\0' };
+        // Match lengths between 10 s and ~10 min in millisecond steps; no
+        // timestamps, so the lines keep the three fields the legacy path reads
+        float seconds = 10.0f + (float)(NextRandom(&state) % 600000u) / 1000.0f;
+        AddLeaderboardEntryAt(&lb, initials, (NextRandom(&state) & 1u) ? 'A' : 'P', seconds, 0);
+    }
+
+    uint64_t exportNs = UINT64_MAX, legacyExportNs = UINT64_MAX;
+    uint64_t importNs = UINT64_MAX, legacyImportNs = UINT64_MAX;
+    LeaderboardTextStats stats = {0};
+    size_t legacyImported = 0;
+    bool ok = true;
+    for (int run = 0; run < BENCH_RUNS && ok; ++run) {
+        uint64_t start = Now();
+        ok = ExportLeaderboardText(&lb, textPath);
+        uint64_t elapsed = Now() - start;
+        if (elapsed < exportNs) exportNs = elapsed;
+
+        start = Now();
+        ok = ok && LegacyExport(&lb, legacyPath);
+        elapsed = Now() - start;
+        if (elapsed < legacyExportNs) legacyExportNs = elapsed;
+
+        // Import into a plain top-10 board so the parse dominates
+        Leaderboard parsed = {0};
+        start = Now();
+        ok = ok && ImportLeaderboardText(&parsed, textPath, &stats);
+        elapsed = Now() - start;
+        if (elapsed < importNs) importNs = elapsed;
+
+        start = Now();
+        legacyImported = LegacyImport(textPath);
+        elapsed = Now() - start;
+        if (elapsed < legacyImportNs) legacyImportNs = elapsed;
+    }
+
+    double megabytes = FileMegabytes(textPath);
+    // Both exports must produce the same bytes
+    FILE *a = fopen(textPath, "rb");
+    FILE *b = fopen(legacyPath, "rb");
+    bool same = a && b;
+    while (same) {
+        int ca = fgetc(a), cb = fgetc(b);
+        same = ca == cb;
+        if (ca == EOF) break;
+    }
+    if (a) fclose(a);
+    if (b) fclose(b);
+    remove(textPath);
+    remove(legacyPath);
+    DestroyScoreIndex(lb.index);
+    if (!ok) {
+        fprintf(stderr, "Benchmark I/O failed\n");
+        return 1;
+    }
+
+    printf("%" PRIu64 " lines, %.1f MB, best of %d\n", lines, megabytes, BENCH_RUNS);
+    ReportRate("export", megabytes, exportNs);
+    ReportRate("export (fprintf)", megabytes, legacyExportNs);
+    ReportRate("import", megabytes, importNs);
+    ReportRate("import (fgets+sscanf)", megabytes, legacyImportNs);
+    printf("  outputs %s, %zu/%zu lines parsed by both\n", same ? "identical" : "DIFFER",
+           stats.imported, legacyImported);
+    return (same && stats.imported == legacyImported) ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 4 && strcmp(argv[1], "import") == 0) {
+        bool strict = argc == 5 && strcmp(argv[4], "--strict") == 0;
+        if (argc == 4 || strict) return Import(argv[2], argv[3], strict);
+    } else if ((argc == 4 || argc == 5) && strcmp(argv[1], "export") == 0) {
+        return Export(argv[2], argv[3], (argc == 5) ? argv[4] : NULL);
+    } else if ((argc == 2 || argc == 3) && strcmp(argv[1], "bench") == 0) {
+        char *end = NULL;
+        unsigned long long lines = (argc == 3) ? strtoull(argv[2], &end, 10) : DEFAULT_BENCH_LINES;
+        if (argc == 2 || (end != argv[2] && *end == '\0')) return Bench((uint64_t)lines);
+    }
+    PrintUsage(argv[0]);
+    return 1;
+}
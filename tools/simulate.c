@@ -0,0 +1,245 @@
+/* =========================================================================
+    Purple - Tools
+    https://github.com/octopusnz/purple
+    Copyright (c) 2026 Jacob Doherty
+    SPDX-License-Identifier: MIT
+    See LICENSE.txt for 3rd party library and other resource licenses.
+    File: simulate.c
+    Description: Headless batch simulation with checkpoint and resume
+========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../simulation.h"
+#include "../checkpoint.h"
+
+#define DEFAULT_MATCHES 1000
+#define DEFAULT_LANES 64
+#define DEFAULT_THREADS 1
+#define DEFAULT_INTERVAL 30.0
+#define DEFAULT_CHECKPOINT "simulate.ckpt"
+#define MAX_LANES 65536
+#define MAX_THREADS 256
+#define SLICE_FRAMES 4096  // Frames per lane between publishes
+
+typedef struct {
+    SimLane *lanes;
+    size_t first;
+    size_t count;
+    const SimConfig *config;
+    CheckpointWriter *writer;
+} Worker;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void HandleStopSignal(int signum)
+{
+    (void)signum;
+    stopRequested = 1;
+}
+
+static void *RunWorker(void *arg)
+{
+    Worker *worker = (Worker *)arg;
+    SimLane *lanes = &worker->lanes[worker->first];
+
+    bool busy = true;
+    while (busy && !stopRequested) {
+        busy = false;
+        for (size_t i = 0; i < worker->count; ++i) {
+            if (StepSimLane(&lanes[i], worker->config, SLICE_FRAMES) > 0) {
+                busy = true;
+            }
+        }
+        if (worker->writer != NULL) {
+            PublishCheckpointLanes(worker->writer, lanes, worker->first, worker->count);
+        }
+    }
+    return NULL;
+}
+
+static void PrintUsage(const char *program)
+{
+    printf("Usage: %s [options]\n", program);
+    printf("  --matches N       Total matches to simulate (default %d)\n", DEFAULT_MATCHES);
+    printf("  --lanes N         Independent match streams, 1-%d (default %d)\n", MAX_LANES,
+           DEFAULT_LANES);
+    printf("  --threads N       Simulation threads, 1-%d (default %d)\n", MAX_THREADS,
+           DEFAULT_THREADS);
+    printf("  --seed N          Base PRNG seed (default 1)\n");
+    printf("  --checkpoint PATH Checkpoint file (default %s)\n", DEFAULT_CHECKPOINT);
+    printf("  --interval SECS   Seconds between checkpoints (default %.0f)\n", DEFAULT_INTERVAL);
+    printf("  --no-checkpoint   Disable checkpointing\n");
+    printf("  --resume          Continue from the checkpoint file, which sets the matches,\n");
+    printf("                    lanes and seed\n");
+}
+
+static bool ParseCount(const char *text, uint64_t *value)
+{
+    char *end = NULL;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (end == text || *end != '\0') return false;
+    *value = (uint64_t)parsed;
+    return true;
+}
+
+// A count from 1 to max
+static bool ParseBounded(const char *text, uint64_t max, uint64_t *value)
+{
+    uint64_t parsed = 0;
+    if (!ParseCount(text, &parsed) || parsed == 0 || parsed > max) return false;
+    *value = parsed;
+    return true;
+}
+
+static bool ParseSeconds(const char *text, double *value)
+{
+    char *end = NULL;
+    double parsed = strtod(text, &end);
+    if (end == text || *end != '\0' || !isfinite(parsed) || parsed <= 0.0) return false;
+    *value = parsed;
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t matches = DEFAULT_MATCHES;
+    uint64_t laneCount = DEFAULT_LANES;
+    uint64_t threadCount = DEFAULT_THREADS;
+    uint64_t seed = 1;
+    double interval = DEFAULT_INTERVAL;
+    const char *checkpointPath = DEFAULT_CHECKPOINT;
+    bool checkpointing = true;
+    bool resume = false;
+    const char *checkpointOwned = NULL;  // An option --resume would override
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool ok = true;
+        if (strcmp(arg, "--matches") == 0 && value) {
+            ok = ParseCount(value, &matches); i++;
+            checkpointOwned = arg;
+        } else if (strcmp(arg, "--lanes") == 0 && value) {
+            ok = ParseBounded(value, MAX_LANES, &laneCount); i++;
+            checkpointOwned = arg;
+        } else if (strcmp(arg, "--threads") == 0 && value) {
+            ok = ParseBounded(value, MAX_THREADS, &threadCount); i++;
+        } else if (strcmp(arg, "--seed") == 0 && value) {
+            ok = ParseCount(value, &seed); i++;
+            checkpointOwned = arg;
+        } else if (strcmp(arg, "--checkpoint") == 0 && value) {
+            checkpointPath = value; i++;
+        } else if (strcmp(arg, "--interval") == 0 && value) {
+            ok = ParseSeconds(value, &interval); i++;
+        } else if (strcmp(arg, "--no-checkpoint") == 0) {
+            checkpointing = false;
+        } else if (strcmp(arg, "--resume") == 0) {
+            resume = true;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (resume && checkpointOwned != NULL) {
+        fprintf(stderr, "%s cannot be combined with --resume; the checkpoint sets it\n",
+                checkpointOwned);
+        return 1;
+    }
+
+    if (laneCount > matches && matches > 0) laneCount = matches;
+
+    SimLane *lanes = calloc(MAX_LANES, sizeof(SimLane));
+    if (lanes == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    SimConfig config;
+    size_t lanesInUse = 0;
+    if (resume) {
+        if (!LoadSimCheckpoint(checkpointPath, &config, &seed, lanes, MAX_LANES, &lanesInUse)) {
+            fprintf(stderr, "Cannot resume: %s is missing or corrupt\n", checkpointPath);
+            free(lanes);
+            return 1;
+        }
+        printf("Resuming %zu lanes from %s\n", lanesInUse, checkpointPath);
+    } else {
+        InitSimConfig(&config);
+        lanesInUse = (size_t)laneCount;
+        for (size_t i = 0; i < lanesInUse; ++i) {
+            // Spread matches so lane results never depend on thread timing
+            uint64_t share = matches / lanesInUse + ((i < matches % lanesInUse) ? 1 : 0);
+            InitSimLane(&lanes[i], &config, seed + i, share);
+        }
+    }
+    if (threadCount > lanesInUse) threadCount = lanesInUse;
+
+    CheckpointWriter writer;
+    CheckpointWriter *writerPtr = NULL;
+    if (checkpointing) {
+        if (StartCheckpointWriter(&writer, checkpointPath, &config, seed,
+                                  lanes, lanesInUse, interval)) {
+            writerPtr = &writer;
+        } else {
+            fprintf(stderr, "Warning: checkpoint writer failed to start\n");
+        }
+    }
+
+    signal(SIGINT, HandleStopSignal);
+    signal(SIGTERM, HandleStopSignal);
+
+    pthread_t threads[MAX_THREADS];
+    Worker workers[MAX_THREADS];
+    bool threaded[MAX_THREADS];
+    for (size_t t = 0; t < (size_t)threadCount; ++t) {
+        size_t first = lanesInUse * t / (size_t)threadCount;
+        size_t last = lanesInUse * (t + 1) / (size_t)threadCount;
+        workers[t] = (Worker){ lanes, first, last - first, &config, writerPtr };
+        threaded[t] = pthread_create(&threads[t], NULL, RunWorker, &workers[t]) == 0;
+        if (!threaded[t]) {
+            // Run this share on the main thread instead
+            RunWorker(&workers[t]);
+        }
+    }
+    for (size_t t = 0; t < (size_t)threadCount; ++t) {
+        if (threaded[t]) pthread_join(threads[t], NULL);
+    }
+
+    if (writerPtr != NULL) {
+        StopCheckpointWriter(writerPtr);
+        printf("Checkpoints written: %" PRIu64 "%s\n", writer.checkpointsWritten,
+               writer.failed ? " (last write FAILED)" : "");
+    }
+
+    SimStats total = {0};
+    uint64_t remaining = 0;
+    for (size_t i = 0; i < lanesInUse; ++i) {
+        AccumulateSimStats(&total, &lanes[i].stats);
+        remaining += lanes[i].matchesRemaining;
+    }
+
+    printf("Matches:       %" PRIu64 "\n", total.matches);
+    printf("Left wins:     %" PRIu64 "\n", total.leftWins);
+    printf("Right wins:    %" PRIu64 "\n", total.rightWins);
+    printf("Abandoned:     %" PRIu64 "\n", total.abandoned);
+    printf("Frames:        %" PRIu64 "\n", total.frames);
+    printf("Paddle hits:   %" PRIu64 "\n", total.rallies);
+    printf("Longest rally: %u\n", total.longestRally);
+    if (remaining > 0) {
+        printf("Interrupted with %" PRIu64 " matches remaining; use --resume\n", remaining);
+    }
+
+    free(lanes);
+    return 0;
+}